@@ -23,8 +23,10 @@
 #include "private/DockRegistry_p.h"
 #include "private/Utils_p.h"
 #include "private/DragController_p.h"
+#include "private/FloatingWindowPool_p.h"
 #include "FrameworkWidgetFactory.h"
 
+#include <QCoreApplication>
 #include <QDebug>
 #include <QOperatingSystemVersion>
 
@@ -62,6 +64,9 @@ public:
     CustomizableWidgets m_disabledPaintEvents = CustomizableWidget_None;
     qreal m_draggedWindowOpacity = Q_QNAN;
     int m_mdiPopupThreshold = 250;
+    int m_floatingWindowPoolSize = 0;
+    int m_maxPlaceholdersPerLayout = -1;
+    int m_maxPlaceholderAge = -1;
     bool m_dropIndicatorsInhibited = false;
 #ifdef KDDOCKWIDGETS_QTQUICK
     QtQuickHelpers m_qquickHelpers;
@@ -112,6 +117,7 @@ void Config::setFlags(Flags f)
 
     auto multisplitterFlags = Layouting::Config::self().flags();
     multisplitterFlags.setFlag(Layouting::Config::Flag::LazyResize, d->m_flags & Flag_LazyResize);
+    multisplitterFlags.setFlag(Layouting::Config::Flag::BatchedGeometryChanges, d->m_flags & Flag_BatchedGeometryChanges);
     Layouting::Config::self().setFlags(multisplitterFlags);
 }
 
@@ -317,6 +323,14 @@ void Config::Private::fixFlags()
         m_internalFlags |= InternalFlag_DontUseQtToolWindowsForFloatingWindows;
     }
 
+#ifdef KDDOCKWIDGETS_QTQUICK
+    // Not implemented for QtQuick yet
+    m_flags = m_flags & ~Flag_SeparatorOverlay;
+#else
+    // Only QML bindings benefit from it
+    m_flags = m_flags & ~Flag_BatchedGeometryChanges;
+#endif
+
     if (m_flags & Flag_ShowButtonsOnTabBarIfTitleBarHidden) {
         // Flag_ShowButtonsOnTabBarIfTitleBarHidden doesn't make sense if used alone
         m_flags |= Flag_HideTitleBarWhenTabsVisible;
@@ -343,6 +357,59 @@ int Config::mdiPopupThreshold() const
     return d->m_mdiPopupThreshold;
 }
 
+void Config::setFloatingWindowPoolSize(int size)
+{
+    d->m_floatingWindowPoolSize = qMax(0, size);
+    // Config might be set before the application is created, there's nothing pooled yet then
+    if (d->m_floatingWindowPoolSize == 0 && qApp)
+        FloatingWindowPool::self()->clear();
+}
+
+int Config::floatingWindowPoolSize() const
+{
+    return d->m_floatingWindowPoolSize;
+}
+
+void Config::setSanityCheckLevel(SanityCheckLevel level)
+{
+    Layouting::Config::self().setSanityCheckLevel(static_cast<Layouting::Config::SanityCheckLevel>(level));
+}
+
+Config::SanityCheckLevel Config::sanityCheckLevel() const
+{
+    return static_cast<SanityCheckLevel>(Layouting::Config::self().sanityCheckLevel());
+}
+
+void Config::setMaxPlaceholdersPerLayout(int max)
+{
+    d->m_maxPlaceholdersPerLayout = qMax(-1, max);
+}
+
+int Config::maxPlaceholdersPerLayout() const
+{
+    return d->m_maxPlaceholdersPerLayout;
+}
+
+void Config::setMaxPlaceholderAge(int msecs)
+{
+    d->m_maxPlaceholderAge = qMax(-1, msecs);
+}
+
+int Config::maxPlaceholderAge() const
+{
+    return d->m_maxPlaceholderAge;
+}
+
+void Config::setLiveResizeInterval(int msecs)
+{
+    Layouting::Config::self().setLiveResizeInterval(msecs);
+}
+
+int Config::liveResizeInterval() const
+{
+    return Layouting::Config::self().liveResizeInterval();
+}
+
 void Config::setDropIndicatorsInhibited(bool inhibit) const
 {
     if (d->m_dropIndicatorsInhibited != inhibit) {
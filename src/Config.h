@@ -96,7 +96,7 @@ public:
         Flag_DoubleClickMaximizes = 128, ///< Double clicking the titlebar will maximize a floating window instead of re-docking it
         Flag_TitleBarHasMaximizeButton = 256, ///< The title bar will have a maximize/restore button when floating. This is mutually-exclusive with the floating button (since many apps behave that way).
         Flag_TitleBarIsFocusable = 512, ///< You can click the title bar and it will focus the last focused widget in the focus scope. If no previously focused widget then it focuses the user's dock widget guest, which should accept focus or use a focus proxy.
-        Flag_LazyResize = 1024, ///< The dock widgets are resized in a lazy manner. The actual resize only happens when you release the mouse button.
+        Flag_LazyResize = 1024, ///< The dock widgets are resized in a lazy manner. The actual resize only happens when you release the mouse button. Applies to separators, floating windows and MDI frames.
         Flag_DontUseUtilityFloatingWindows = 0x1000,
         Flag_TitleBarHasMinimizeButton = 0x2000 | Flag_DontUseUtilityFloatingWindows, ///< The title bar will have a minimize button when floating. This implies Flag_DontUseUtilityFloatingWindows too, otherwise they wouldn't appear in the task bar.
         Flag_TitleBarNoFloatButton = 0x4000, ///< The TitleBar won't show the float button
@@ -106,6 +106,12 @@ public:
         Flag_CloseOnlyCurrentTab = 0x20000, ///< The TitleBar's close button will only close the current tab, instead of all of them
         Flag_ShowButtonsOnTabBarIfTitleBarHidden = 0x40000, ///< When using Flag_HideTitleBarWhenTabsVisible the close/float buttons disappear with the title bar. With Flag_ShowButtonsOnTabBarIfHidden they'll be shown in the tab bar.
         Flag_AllowSwitchingTabsViaMenu = 0x80000, ///< Allow switching tabs via a context menu when right clicking on the tab area
+        Flag_SeparatorOverlay = 0x100000, ///< Separators don't get a widget each, instead each layout has a single transparent layer which paints and hit-tests all of them.
+                                          ///< Cheaper with many dock widgets. Only supported with QtWidgets and the default FrameworkWidgetFactory::createSeparator(). Read when each layout is created.
+        Flag_DeferTitleUpdates = 0x200000, ///< Title, icon and title bar visibility changes are coalesced per frame and applied once, on the next event loop pass.
+                                           ///< Useful if your dock widget titles change often, for example to show progress.
+        Flag_BatchedGeometryChanges = 0x400000, ///< QtQuick only. Layout items and DockWidgetQuick::frameGeometryChanged() notify geometry changes once per event loop pass,
+                                                ///< with a single geometryChanged(QRect), instead of once per change and axis. Fewer QML binding re-evaluations during relayouts.
         Flag_Default = Flag_AeroSnapWithClientDecos ///< The defaults
     };
     Q_DECLARE_FLAGS(Flags, Flag)
@@ -139,6 +145,13 @@ public:
     };
     Q_DECLARE_FLAGS(InternalFlags, InternalFlag)
 
+    ///@brief How much of the layout is verified after each layout operation and before saving
+    enum SanityCheckLevel {
+        SanityCheckLevel_Off = 0, ///< No automatic checks
+        SanityCheckLevel_Incremental, ///< Only the parts of the layout which changed since the last check are verified
+        SanityCheckLevel_Full ///< The whole layout is verified. The default.
+    };
+
     ///@brief returns the chosen flags
     Flags flags() const;
 
@@ -317,6 +330,43 @@ public:
     void setMDIPopupThreshold(int);
     int mdiPopupThreshold() const;
 
+    /// @brief Sets how many hidden FloatingWindows are kept around for reuse.
+    /// When a floating window's last dock widget is docked the window is hidden and recycled instead of deleted,
+    /// so floating a dock widget later doesn't need to create a new native window.
+    /// The pool is pre-warmed once a main window is created. By default this is 0, which disables pooling.
+    void setFloatingWindowPoolSize(int);
+    int floatingWindowPoolSize() const;
+
+    /// @brief Sets how much of the layout is verified after each layout operation and before saving.
+    /// Can be changed at runtime. The incremental level bounds the cost in large layouts, while
+    /// still catching corruption. Timings are available via Layouting::Config::sanityCheckStats().
+    /// By default this is SanityCheckLevel_Full
+    void setSanityCheckLevel(SanityCheckLevel);
+    SanityCheckLevel sanityCheckLevel() const;
+
+    /// @brief Sets how many placeholders each layout keeps at most.
+    /// Placeholders are hidden items remembering where closed dock widgets were, so they can be
+    /// restored to the same place. They make layout traversals slower, so in long running sessions you
+    /// might want to limit them. The oldest ones are removed first.
+    /// By default this is -1, which means no limit.
+    void setMaxPlaceholdersPerLayout(int);
+    int maxPlaceholdersPerLayout() const;
+
+    /// @brief Sets the age, in milliseconds, after which placeholders are removed.
+    /// Checked whenever a dock widget is closed or hidden. By default this is -1, which means no limit.
+    /// @sa setMaxPlaceholdersPerLayout()
+    void setMaxPlaceholderAge(int msecs);
+    int maxPlaceholderAge() const;
+
+    /// @brief Caps how often the layout is updated during live resizes, in milliseconds.
+    /// Covers dragging separators, resizing floating windows and MDI frames, and resizing the main window.
+    /// Intermediate resize events are coalesced, only the latest one is applied. A final exact pass
+    /// runs when the mouse is released. Use -1 to follow the refresh rate of the primary screen.
+    /// Counters are available via Layouting::Config::liveResizeStats().
+    /// By default this is 0, which means no throttling. Ignored for what Flag_LazyResize covers.
+    void setLiveResizeInterval(int msecs);
+    int liveResizeInterval() const;
+
     /// Prints some debug information
     void printDebug();
 
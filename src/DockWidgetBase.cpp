@@ -13,6 +13,7 @@
 #include "private/DockWidgetBase_p.h"
 #include "private/DockRegistry_p.h"
 #include "private/FloatingWindow_p.h"
+#include "private/FloatingWindowPool_p.h"
 #include "private/Frame_p.h"
 #include "private/LayoutSaver_p.h"
 #include "private/Logging_p.h"
@@ -409,8 +410,8 @@ void DockWidgetBase::raise()
         fw->raise();
         fw->activateWindow();
     } else if (Frame *frame = d->frame()) {
-        if (frame->isMDI())
-            frame->raise();
+        if (MDILayoutWidget *layout = frame->mdiLayoutWidget())
+            layout->raiseDockWidget(frame);
     }
 }
 
@@ -529,12 +530,11 @@ FloatingWindow *DockWidgetBase::Private::morphIntoFloatingWindow()
             }
         }
 
-        auto frame = Config::self().frameworkWidgetFactory()->createFrame();
+        auto frame = Config::self().frameworkWidgetFactory()->acquireFrame();
         frame->addWidget(q);
         geo.setSize(geo.size().boundedTo(frame->maxSizeHint()));
         FloatingWindow::ensureRectIsOnScreen(geo);
-        auto floatingWindow =
-            Config::self().frameworkWidgetFactory()->createFloatingWindow(frame, nullptr, geo);
+        auto floatingWindow = FloatingWindowPool::self()->acquire(frame, nullptr, geo);
         floatingWindow->show();
 
         return floatingWindow;
@@ -935,16 +935,14 @@ void DockWidgetBase::setMDISize(QSize size)
 
 void DockWidgetBase::setMDIZ(int z)
 {
-#ifdef KDDOCKWIDGETS_QTQUICK
-    if (Frame *frame = d->frame()) {
-        if (!frame->isMDI())
-            return;
-        frame->setZ(z);
+    if (MDILayoutWidget *layout = d->mdiLayout()) {
+        if (auto wrapperDW = d->mdiDockWidgetWrapper()) {
+            // Case of using Option_MDINestable. We need to stack the actual top level DW
+            layout->setDockWidgetZ(wrapperDW->d->frame(), z);
+        } else {
+            layout->setDockWidgetZ(d->frame(), z);
+        }
     }
-#else
-    Q_UNUSED(z);
-    qWarning() << Q_FUNC_INFO << "Not implemented for QtQuick";
-#endif
 }
 
 bool DockWidgetBase::isPersistentCentralDockWidget() const
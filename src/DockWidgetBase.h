@@ -453,7 +453,7 @@ public:
     /// @brief like setMDIPosition(), but for the size.
     void setMDISize(QSize size);
     /// @brief like setMDIPosition(), but for the Z
-    /// only implemented for QtQuick
+    /// Dock widgets with a higher Z are stacked on top. The Z is saved by LayoutSaver.
     void setMDIZ(int z);
 
     ///@brief Returns whether this dock widget is the main window persistent central widget
@@ -96,6 +96,7 @@ public:
 Q_SIGNALS:
     /// @brief The geometry of the frame container this dock widget is in changed
     /// For example, when dragging a dockwidget
+    /// With Config::Flag_BatchedGeometryChanges it's emitted at most once per event loop pass
     void frameGeometryChanged(QRect);
 
 protected:
@@ -36,11 +36,13 @@ public:
     Private(FocusScope *qq, QWidgetAdapter *thisWidget)
         : q(qq)
         , m_thisWidget(thisWidget)
+        , m_registry(DockRegistry::self())
     {
-        connect(qApp, &QGuiApplication::focusObjectChanged,
-                this, &Private::onFocusObjectChanged);
-
-        onFocusObjectChanged(qApp->focusObject());
+        // DockRegistry tracks the focus object for all scopes and only notifies the ones which
+        // gained or lost focus
+        QObject *focusObject = qApp->focusObject();
+        auto focusWidget = qobject_cast<WidgetType *>(focusObject);
+        onFocusObjectChanged(focusObject, focusWidget && isInFocusScope(focusWidget));
         m_inCtor = false;
     }
 
@@ -63,11 +65,12 @@ public:
     ~Private() override;
 
     void setIsFocused(bool);
-    void onFocusObjectChanged(QObject *);
+    void onFocusObjectChanged(QObject *, bool isInScope);
     bool isInFocusScope(WidgetType *) const;
 
     FocusScope *const q;
     QWidgetAdapter *const m_thisWidget;
+    const QPointer<DockRegistry> m_registry;
     bool m_isFocused = false;
     bool m_inCtor = true;
     QPointer<WidgetType> m_lastFocusedInScope;
@@ -75,11 +78,15 @@ public:
 
 FocusScope::Private::~Private()
 {
+    // Don't use DockRegistry::self(), it might have been deleted already and we'd recreate it
+    if (m_registry)
+        m_registry->unregisterFocusScope(m_thisWidget);
 }
 
 FocusScope::FocusScope(QWidgetAdapter *thisWidget)
     : d(new Private(this, thisWidget))
 {
+    d->m_registry->registerFocusScope(this, thisWidget);
 }
 
 FocusScope::~FocusScope()
@@ -119,6 +126,14 @@ void FocusScope::focus(Qt::FocusReason reason)
     }
 }
 
+void FocusScope::clearFocusedWidget()
+{
+    if (d->m_lastFocusedInScope) {
+        d->m_lastFocusedInScope = nullptr;
+        /* Q_EMIT */ focusedWidgetChangedCallback();
+    }
+}
+
 void FocusScope::Private::setIsFocused(bool is)
 {
     if (is != m_isFocused) {
@@ -129,7 +144,12 @@ void FocusScope::Private::setIsFocused(bool is)
     }
 }
 
-void FocusScope::Private::onFocusObjectChanged(QObject *obj)
+void FocusScope::onFocusObjectChanged(QObject *obj, bool isInScope)
+{
+    d->onFocusObjectChanged(obj, isInScope);
+}
+
+void FocusScope::Private::onFocusObjectChanged(QObject *obj, bool is)
 {
     auto widget = qobject_cast<WidgetType *>(obj);
     if (!widget) {
@@ -137,7 +157,6 @@ void FocusScope::Private::onFocusObjectChanged(QObject *obj)
         return;
     }
 
-    const bool is = isInFocusScope(widget);
     if (is && m_lastFocusedInScope != widget && !qobject_cast<TitleBar *>(obj)) {
         m_lastFocusedInScope = widget;
         setIsFocused(is);
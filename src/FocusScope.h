@@ -53,7 +53,13 @@ protected:
     virtual void isFocusedChangedCallback() = 0;
     virtual void focusedWidgetChangedCallback() = 0;
 
+    ///@brief Forgets the last focused widget. For when the scope is reused with different content.
+    void clearFocusedWidget();
+
 private:
+    friend class DockRegistry;
+    /// Called by DockRegistry, which already knows if the new focus object is inside this scope
+    void onFocusObjectChanged(QObject *, bool isInScope);
     class Private;
     Private *const d;
 };
@@ -28,6 +28,7 @@
 #include "private/widgets/SideBarWidget_p.h"
 #include "private/widgets/TabWidgetWidget_p.h"
 #include "private/multisplitter/Separator_qwidget.h"
+#include "private/multisplitter/SeparatorOverlay_qwidget.h"
 #include "private/widgets/FloatingWindowWidget_p.h"
 #include "private/indicators/SegmentedIndicators_p.h"
 
@@ -42,8 +43,13 @@
 #include "private/quick/FloatingWindowQuick_p.h"
 #include "private/quick/RubberBandQuick.h"
 #include "private/multisplitter/Separator_quick.h"
+
+#include <QQmlComponent>
+#include <QQmlEngine>
 #endif
 
+#include <QCoreApplication>
+
 // clazy:excludeall=ctor-missing-parent-argument
 
 using namespace KDDockWidgets;
@@ -52,6 +58,74 @@ DropIndicatorType DefaultWidgetFactory::s_dropIndicatorType = DropIndicatorType:
 
 FrameworkWidgetFactory::~FrameworkWidgetFactory()
 {
+    if (qApp) // Otherwise we're at static destruction time and it's too late to delete widgets
+        clearRecycledFrames();
+}
+
+Frame *FrameworkWidgetFactory::acquireFrame(QWidgetOrQuick *parent, FrameOptions options) const
+{
+    for (int i = m_recycledFrames.size() - 1; i >= 0; --i) {
+        Frame *frame = m_recycledFrames.at(i);
+        if (!frame) {
+            m_recycledFrames.removeAt(i);
+            continue;
+        }
+
+        if (frame->canBeReusedWith(options)) {
+            m_recycledFrames.removeAt(i);
+            m_frameRecyclingStats.hits++;
+            frame->reuse(parent, options);
+            return frame;
+        }
+    }
+
+    if (m_frameRecyclingLimit > 0)
+        m_frameRecyclingStats.misses++;
+
+    return createFrame(parent, options);
+}
+
+bool FrameworkWidgetFactory::recycleFrame(Frame *frame) const
+{
+    if (m_recycledFrames.size() >= m_frameRecyclingLimit || !frame->canBeRecycled())
+        return false;
+
+    if (m_recycledFrames.isEmpty()) {
+        // Recycled frames are parentless, delete them while there's still an event loop
+        connect(qApp, &QCoreApplication::aboutToQuit, this, &FrameworkWidgetFactory::clearRecycledFrames,
+                Qt::UniqueConnection);
+    }
+
+    frame->prepareForRecycling();
+    m_recycledFrames.push_back(frame);
+    m_frameRecyclingStats.recycled++;
+
+    return true;
+}
+
+void FrameworkWidgetFactory::setFrameRecyclingLimit(int limit)
+{
+    m_frameRecyclingLimit = qMax(0, limit);
+    while (m_recycledFrames.size() > m_frameRecyclingLimit)
+        delete m_recycledFrames.takeLast().data();
+}
+
+int FrameworkWidgetFactory::frameRecyclingLimit() const
+{
+    return m_frameRecyclingLimit;
+}
+
+void FrameworkWidgetFactory::clearRecycledFrames()
+{
+    const QVector<QPointer<Frame>> frames = std::move(m_recycledFrames);
+    m_recycledFrames.clear();
+    for (Frame *frame : frames)
+        delete frame;
+}
+
+FrameworkWidgetFactory::FrameRecyclingStats FrameworkWidgetFactory::frameRecyclingStats() const
+{
+    return m_frameRecyclingStats;
 }
 
 #ifdef KDDOCKWIDGETS_QTWIDGETS
@@ -82,6 +156,11 @@ TabWidget *DefaultWidgetFactory::createTabWidget(Frame *parent, TabWidgetOptions
 
 Layouting::Separator *DefaultWidgetFactory::createSeparator(Layouting::Widget *parent) const
 {
+    // Decided by the layout, which reads Flag_SeparatorOverlay once, when it's created.
+    // Otherwise changing the flag later would mix both kinds of separators in one layout.
+    if (Layouting::SeparatorOverlay::overlayForHost(parent))
+        return new Layouting::OverlaySeparator(parent);
+
     return new Layouting::SeparatorWidget(parent);
 }
 
@@ -140,6 +219,57 @@ QAbstractButton *DefaultWidgetFactory::createTitleBarButton(QWidget *parent, Tit
 
 #else
 
+QQmlComponent *FrameworkWidgetFactory::qmlComponent(QQmlEngine *engine, const QUrl &url) const
+{
+    if (!engine) {
+        qWarning() << Q_FUNC_INFO << "No engine for" << url;
+        return nullptr;
+    }
+
+    auto engineIt = m_qmlComponents.find(engine);
+    if (engineIt == m_qmlComponents.end()) {
+        engineIt = m_qmlComponents.insert(engine, {});
+        connect(engine, &QObject::destroyed, this, [this, engine] {
+            // The components were children of the engine, nothing to delete
+            m_qmlComponents.remove(engine);
+        });
+    }
+
+    QQmlComponent *&component = (*engineIt)[url];
+    if (component) {
+        m_qmlComponentCacheStats.hits++;
+    } else {
+        m_qmlComponentCacheStats.misses++;
+        component = new QQmlComponent(engine, url, engine);
+    }
+
+    return component;
+}
+
+void FrameworkWidgetFactory::clearQmlComponentCache()
+{
+    // Keeps the engines as keys, we're still connected to their destroyed() signal
+    for (QHash<QUrl, QQmlComponent *> &components : m_qmlComponents) {
+        qDeleteAll(components);
+        components.clear();
+    }
+}
+
+void FrameworkWidgetFactory::setAsynchronousFrameCreation(bool enable)
+{
+    m_asynchronousFrameCreation = enable;
+}
+
+bool FrameworkWidgetFactory::asynchronousFrameCreation() const
+{
+    return m_asynchronousFrameCreation;
+}
+
+FrameworkWidgetFactory::QmlComponentCacheStats FrameworkWidgetFactory::qmlComponentCacheStats() const
+{
+    return m_qmlComponentCacheStats;
+}
+
 Frame *DefaultWidgetFactory::createFrame(QWidgetOrQuick *parent, FrameOptions options) const
 {
     return new FrameQuick(parent, options);
@@ -16,7 +16,11 @@
 #include "KDDockWidgets.h"
 #include "QWidgetAdapter.h"
 
+#include <QHash>
 #include <QMap>
+#include <QPointer>
+#include <QUrl>
+#include <QVector>
 
 #include <utility>
 
@@ -31,6 +35,8 @@
 
 QT_BEGIN_NAMESPACE
 class QAbstractButton;
+class QQmlComponent;
+class QQmlEngine;
 QT_END_NAMESPACE
 
 namespace Layouting {
@@ -157,8 +163,72 @@ public:
     /// @param dpr the device pixel ratio of the button
     virtual QIcon iconForButtonType(TitleBarButtonType type, qreal dpr) const = 0;
 
+    ///@brief Called internally by the framework to get a Frame.
+    /// If frame recycling is enabled and a previously used Frame compatible with @p options is available
+    /// it's reset and returned, otherwise createFrame() is called.
+    ///@sa setFrameRecyclingLimit()
+    Frame *acquireFrame(QWidgetOrQuick *parent = nullptr, FrameOptions options = FrameOption_None) const;
+
+    ///@brief Called internally by the framework instead of deleting an empty Frame.
+    /// Returns true if the Frame was kept for reuse, otherwise the caller should delete it.
+    bool recycleFrame(Frame *) const;
+
+    ///@brief Sets how many empty Frames are kept for reuse, along with their TitleBar, TabWidget and TabBar.
+    /// Restoring layouts and moving dock widgets around creates and destroys many frames. Recycling them
+    /// avoids rebuilding the same widgets each time. By default it's 0, which disables recycling.
+    void setFrameRecyclingLimit(int);
+    int frameRecyclingLimit() const;
+
+    ///@brief Deletes the Frames that were kept for reuse
+    void clearRecycledFrames();
+
+    struct FrameRecyclingStats
+    {
+        int hits = 0; ///< acquireFrame() returned a recycled Frame
+        int misses = 0; ///< acquireFrame() had to call createFrame()
+        int recycled = 0; ///< recycleFrame() kept the Frame
+    };
+
+    ///@brief Returns counters about frame recycling, for diagnostics and benchmarking
+    FrameRecyclingStats frameRecyclingStats() const;
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+    ///@brief Returns the QQmlComponent for @p url, compiled once per engine and then cached.
+    /// Frames, floating windows, dock widgets and rubber bands are instantiated from these, so each
+    /// QML file is only loaded and compiled once. The components are owned by @p engine.
+    QQmlComponent *qmlComponent(QQmlEngine *engine, const QUrl &url) const;
+
+    ///@brief Deletes the cached components. Only needed if the QML files change at runtime.
+    void clearQmlComponentCache();
+
+    ///@brief Sets whether frames create their QML item asynchronously, with a QQmlIncubator.
+    /// Restoring a layout with many frames then doesn't block the GUI thread, the frames appear progressively
+    /// as the engine's incubation controller gives them time. FrameQuick::visualItem() is nullptr until then.
+    /// QQuickWindow installs an incubation controller on its engine, if the engine has none the frames
+    /// are created synchronously. By default this is false.
+    void setAsynchronousFrameCreation(bool);
+    bool asynchronousFrameCreation() const;
+
+    struct QmlComponentCacheStats
+    {
+        int hits = 0; ///< qmlComponent() returned a cached component
+        int misses = 0; ///< qmlComponent() had to load a new component
+    };
+
+    ///@brief Returns counters about the component cache, for diagnostics and benchmarking
+    QmlComponentCacheStats qmlComponentCacheStats() const;
+#endif
+
 private:
     Q_DISABLE_COPY(FrameworkWidgetFactory)
+    int m_frameRecyclingLimit = 0;
+    mutable QVector<QPointer<Frame>> m_recycledFrames;
+    mutable FrameRecyclingStats m_frameRecyclingStats;
+#ifdef KDDOCKWIDGETS_QTQUICK
+    mutable QHash<QQmlEngine *, QHash<QUrl, QQmlComponent *>> m_qmlComponents;
+    mutable QmlComponentCacheStats m_qmlComponentCacheStats;
+    bool m_asynchronousFrameCreation = false;
+#endif
 };
 
 /**
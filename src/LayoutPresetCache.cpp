@@ -0,0 +1,165 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/**
+ * @file
+ * @brief Class to keep several layouts in memory and switch between them.
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#include "LayoutPresetCache.h"
+#include "LayoutSaver.h"
+#include "DockWidgetBase.h"
+
+#include "private/LayoutSaver_p.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+
+/**
+ * Presets are stored as the QVariantMap which sits between the JSON and the LayoutSaver::Layout
+ * intermediate structs. We can't keep LayoutSaver::Layout instances around, as their
+ * LayoutSaver::DockWidget instances are shared with every other Layout (see DockWidget::s_dockWidgets),
+ * so parsing a second preset would clobber the first.
+ *
+ * QVariantMap is implicitly shared, so holding, copying and exporting presets is cheap, and going
+ * from it to a LayoutSaver::Layout is a plain tree walk, without any text parsing.
+ */
+
+using namespace KDDockWidgets;
+
+class LayoutPresetCache::Private
+{
+public:
+    explicit Private(RestoreOptions options)
+        : m_saver(options)
+    {
+    }
+
+    LayoutSaver m_saver;
+    QHash<QString, QVariantMap> m_presets;
+};
+
+LayoutPresetCache::LayoutPresetCache(RestoreOptions options)
+    : d(new Private(options))
+{
+}
+
+LayoutPresetCache::~LayoutPresetCache()
+{
+    delete d;
+}
+
+bool LayoutPresetCache::capture(const QString &name)
+{
+    LayoutSaver::Layout layout;
+    if (!d->m_saver.dptr()->serializeLayout(layout))
+        return false;
+
+    d->m_presets.insert(name, layout.toVariantMap());
+    return true;
+}
+
+bool LayoutPresetCache::insert(const QString &name, const QByteArray &jsonData)
+{
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(jsonData, &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << Q_FUNC_INFO << "Failed to parse json data" << error.errorString();
+        return false;
+    }
+
+    const QVariantMap map = doc.toVariant().toMap();
+    const int version = map.value(QStringLiteral("serializationVersion")).toInt();
+    if (version != KDDOCKWIDGETS_SERIALIZATION_VERSION) {
+        qWarning() << Q_FUNC_INFO << "Serialization format is too old"
+                   << version << "current=" << KDDOCKWIDGETS_SERIALIZATION_VERSION;
+        return false;
+    }
+
+    d->m_presets.insert(name, map);
+    return true;
+}
+
+bool LayoutPresetCache::insertFromFile(const QString &name, const QString &jsonFilename)
+{
+    QFile f(jsonFilename);
+    if (!f.open(QIODevice::ReadOnly)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << jsonFilename << f.errorString();
+        return false;
+    }
+
+    return insert(name, f.readAll());
+}
+
+bool LayoutPresetCache::apply(const QString &name)
+{
+    auto it = d->m_presets.constFind(name);
+    if (it == d->m_presets.cend()) {
+        qWarning() << Q_FUNC_INFO << "Unknown preset" << name;
+        return false;
+    }
+
+    LayoutSaver::Private *saverPriv = d->m_saver.dptr();
+    saverPriv->clearRestoredProperty();
+
+    LayoutSaver::Layout layout;
+    layout.fromVariantMap(*it);
+
+    return saverPriv->restoreLayout(layout);
+}
+
+QByteArray LayoutPresetCache::toJson(const QString &name) const
+{
+    auto it = d->m_presets.constFind(name);
+    if (it == d->m_presets.cend())
+        return {};
+
+    return QJsonDocument::fromVariant(*it).toJson();
+}
+
+bool LayoutPresetCache::contains(const QString &name) const
+{
+    return d->m_presets.contains(name);
+}
+
+bool LayoutPresetCache::remove(const QString &name)
+{
+    return d->m_presets.remove(name) > 0;
+}
+
+void LayoutPresetCache::clear()
+{
+    d->m_presets.clear();
+}
+
+QStringList LayoutPresetCache::names() const
+{
+    return d->m_presets.keys();
+}
+
+int LayoutPresetCache::count() const
+{
+    return d->m_presets.size();
+}
+
+void LayoutPresetCache::setAffinityNames(const QStringList &affinityNames)
+{
+    d->m_saver.setAffinityNames(affinityNames);
+}
+
+QVector<DockWidgetBase *> LayoutPresetCache::restoredDockWidgets() const
+{
+    return d->m_saver.restoredDockWidgets();
+}
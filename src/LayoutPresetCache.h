@@ -0,0 +1,123 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_LAYOUTPRESETCACHE_H
+#define KD_LAYOUTPRESETCACHE_H
+
+/**
+ * @file
+ * @brief Class to keep several layouts in memory and switch between them.
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#include "docks_export.h"
+
+#include "KDDockWidgets.h"
+
+QT_BEGIN_NAMESPACE
+class QByteArray;
+QT_END_NAMESPACE
+
+namespace KDDockWidgets {
+
+class DockWidgetBase;
+
+/**
+ * @brief LayoutPresetCache holds several named layouts in memory, already parsed.
+ *
+ * Useful for applications which switch between named workspaces often. Applying a preset
+ * doesn't read any file nor parse any JSON, and capturing the current state has the same
+ * cost as LayoutSaver::serializeLayout() minus the JSON encoding.
+ *
+ * Example:
+ *     LayoutPresetCache presets;
+ *     presets.insertFromFile(QStringLiteral("editing"), QStringLiteral("editing.json"));
+ *     presets.capture(QStringLiteral("debugging"));
+ *     (...)
+ *     presets.apply(QStringLiteral("editing"));
+ *
+ * Presets can be exported to JSON with toJson(), so they can be saved to disk.
+ *
+ * @sa LayoutSaver
+ */
+class DOCKS_EXPORT LayoutPresetCache
+{
+public:
+    ///@brief Constructor. @p options are used when applying presets, see LayoutSaver
+    explicit LayoutPresetCache(RestoreOptions options = RestoreOption_None);
+
+    ///@brief Destructor.
+    ~LayoutPresetCache();
+
+    /**
+     * @brief Saves the current layout as preset @p name, replacing any existing one
+     * @return true on success
+     */
+    bool capture(const QString &name);
+
+    /**
+     * @brief Parses @p jsonData, as returned by LayoutSaver::serializeLayout(), and stores it as preset @p name
+     * @return true on success
+     */
+    bool insert(const QString &name, const QByteArray &jsonData);
+
+    /**
+     * @brief Reads and parses a file written by LayoutSaver::saveToFile() and stores it as preset @p name
+     * @return true on success
+     */
+    bool insertFromFile(const QString &name, const QString &jsonFilename);
+
+    /**
+     * @brief Restores preset @p name
+     * Same requirements as LayoutSaver::restoreLayout()
+     * @return true on success
+     */
+    bool apply(const QString &name);
+
+    ///@brief Returns the preset @p name encoded as JSON, or an empty byte array if there's no such preset
+    QByteArray toJson(const QString &name) const;
+
+    ///@brief Returns whether there's a preset called @p name
+    bool contains(const QString &name) const;
+
+    ///@brief Removes preset @p name. Returns false if there was no such preset
+    bool remove(const QString &name);
+
+    ///@brief Removes all presets
+    void clear();
+
+    ///@brief Returns the names of all presets
+    QStringList names() const;
+
+    ///@brief Returns the number of presets
+    int count() const;
+
+    /**
+     * @brief Sets the list of affinity names for which capture and apply will be applied on.
+     * @sa LayoutSaver::setAffinityNames()
+     */
+    void setAffinityNames(const QStringList &affinityNames);
+
+    /**
+     * @brief returns a list of dock widgets which were restored since the last apply()
+     * @sa LayoutSaver::restoredDockWidgets()
+     */
+    QVector<DockWidgetBase *> restoredDockWidgets() const;
+
+private:
+    Q_DISABLE_COPY(LayoutPresetCache)
+    class Private;
+    Private *const d;
+};
+}
+
+#endif
@@ -36,6 +36,7 @@
 
 #include <qmath.h>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFile>
 
 /**
@@ -146,103 +147,186 @@ bool LayoutSaver::restoreFromFile(const QString &jsonFilename)
 
 QByteArray LayoutSaver::serializeLayout() const
 {
-    if (!d->m_dockRegistry->isSane()) {
-        qWarning() << Q_FUNC_INFO << "Refusing to serialize this layout. Check previous warnings.";
+    LayoutSaver::Layout layout;
+    if (!d->serializeLayout(layout))
         return {};
-    }
+
+    return layout.toJson();
+}
+
+bool LayoutSaver::restoreLayout(const QByteArray &data)
+{
+    d->clearRestoredProperty();
+    if (data.isEmpty())
+        return true;
 
     LayoutSaver::Layout layout;
+    if (!layout.fromJson(data)) {
+        qWarning() << Q_FUNC_INFO << "Failed to parse json data";
+        d->deleteEmptyFrames();
+        return false;
+    }
+
+    return d->restoreLayout(layout);
+}
+
+void LayoutSaver::setAffinityNames(const QStringList &affinityNames)
+{
+    d->m_affinityNames = affinityNames;
+    if (affinityNames.contains(QString())) {
+        // Any window with empty affinity will also be subject to save/restore
+        d->m_affinityNames << QString();
+    }
+}
+
+LayoutSaver::Private *LayoutSaver::dptr() const
+{
+    return d;
+}
+
+DockWidgetBase::List LayoutSaver::restoredDockWidgets() const
+{
+    const DockWidgetBase::List &allDockWidgets = DockRegistry::self()->dockwidgets();
+    DockWidgetBase::List result;
+    result.reserve(allDockWidgets.size());
+    for (DockWidgetBase *dw : allDockWidgets) {
+        if (dw->property("kddockwidget_was_restored").toBool())
+            result.push_back(dw);
+    }
+
+    return result;
+}
+
+void LayoutSaver::Private::clearRestoredProperty()
+{
+    const DockWidgetBase::List &allDockWidgets = DockRegistry::self()->dockwidgets();
+    for (DockWidgetBase *dw : allDockWidgets) {
+        dw->setProperty("kddockwidget_was_restored", QVariant());
+    }
+}
+
+template<typename T>
+void LayoutSaver::Private::deserializeWindowGeometry(const T &saved, QWidgetOrQuick *topLevel)
+{
+    // Not simply calling QWidget::setGeometry() here.
+    // For QtQuick we need to modify the QWindow's geometry.
+
+    QRect geometry = saved.geometry;
+    if (!isNormalWindowState(saved.windowState)) {
+        // The window will be maximized. We first set its geometry to normal
+        // Later it's maximized and will remember this value
+        geometry = saved.normalGeometry;
+    }
+
+    ::FloatingWindow::ensureRectIsOnScreen(geometry);
+
+    if (topLevel->isWindow()) {
+        topLevel->setGeometry(geometry);
+    } else {
+        KDDockWidgets::Private::setTopLevelGeometry(geometry, topLevel);
+    }
+
+    topLevel->setVisible(saved.isVisible);
+}
+
+LayoutSaver::Private::Private(RestoreOptions options)
+    : m_dockRegistry(DockRegistry::self())
+    , m_restoreOptions(internalRestoreOptions(options))
+{
+}
+
+bool LayoutSaver::Private::serializeLayout(LayoutSaver::Layout &layout) const
+{
+    if (!m_dockRegistry->isSane()) {
+        qWarning() << Q_FUNC_INFO << "Refusing to serialize this layout. Check previous warnings.";
+        return false;
+    }
 
     // Just a simplification. One less type of windows to handle.
-    d->m_dockRegistry->ensureAllFloatingWidgetsAreMorphed();
+    m_dockRegistry->ensureAllFloatingWidgetsAreMorphed();
 
-    const MainWindowBase::List mainWindows = d->m_dockRegistry->mainwindows();
+    const MainWindowBase::List mainWindows = m_dockRegistry->mainwindows();
     layout.mainWindows.reserve(mainWindows.size());
     for (MainWindowBase *mainWindow : mainWindows) {
-        if (d->matchesAffinity(mainWindow->affinities()))
+        if (matchesAffinity(mainWindow->affinities()))
             layout.mainWindows.push_back(mainWindow->serialize());
     }
 
-    const QVector<KDDockWidgets::FloatingWindow *> floatingWindows = d->m_dockRegistry->floatingWindows();
+    const QVector<KDDockWidgets::FloatingWindow *> floatingWindows = m_dockRegistry->floatingWindows();
     layout.floatingWindows.reserve(floatingWindows.size());
     for (KDDockWidgets::FloatingWindow *floatingWindow : floatingWindows) {
-        if (d->matchesAffinity(floatingWindow->affinities()))
+        if (matchesAffinity(floatingWindow->affinities()))
             layout.floatingWindows.push_back(floatingWindow->serialize());
     }
 
     // Closed dock widgets also have interesting things to save, like geometry and placeholder info
-    const DockWidgetBase::List closedDockWidgets = d->m_dockRegistry->closedDockwidgets();
+    const DockWidgetBase::List closedDockWidgets = m_dockRegistry->closedDockwidgets();
     layout.closedDockWidgets.reserve(closedDockWidgets.size());
     for (DockWidgetBase *dockWidget : closedDockWidgets) {
-        if (d->matchesAffinity(dockWidget->affinities()))
+        if (matchesAffinity(dockWidget->affinities()))
             layout.closedDockWidgets.push_back(dockWidget->d->serialize());
     }
 
     // Save the placeholder info. We do it last, as we also restore it last, since we need all items to be created
     // before restoring the placeholders
 
-    const DockWidgetBase::List dockWidgets = d->m_dockRegistry->dockwidgets();
+    const DockWidgetBase::List dockWidgets = m_dockRegistry->dockwidgets();
     layout.allDockWidgets.reserve(dockWidgets.size());
     for (DockWidgetBase *dockWidget : dockWidgets) {
-        if (d->matchesAffinity(dockWidget->affinities())) {
+        if (matchesAffinity(dockWidget->affinities())) {
             auto dw = dockWidget->d->serialize();
             dw->lastPosition = dockWidget->d->lastPosition()->serialize();
             layout.allDockWidgets.push_back(dw);
         }
     }
 
-    return layout.toJson();
+    return true;
 }
 
-bool LayoutSaver::restoreLayout(const QByteArray &data)
+bool LayoutSaver::Private::restoreLayout(LayoutSaver::Layout &layout)
 {
-    d->clearRestoredProperty();
-    if (data.isEmpty())
-        return true;
-
     struct FrameCleanup
     {
-        FrameCleanup(LayoutSaver *saver)
+        FrameCleanup(LayoutSaver::Private *saver)
             : m_saver(saver)
         {
         }
 
         ~FrameCleanup()
         {
-            m_saver->d->deleteEmptyFrames();
+            m_saver->deleteEmptyFrames();
         }
 
-        LayoutSaver *const m_saver;
+        LayoutSaver::Private *const m_saver;
     };
 
     FrameCleanup cleanup(this);
-    LayoutSaver::Layout layout;
-    if (!layout.fromJson(data)) {
-        qWarning() << Q_FUNC_INFO << "Failed to parse json data";
-        return false;
-    }
+    m_restoreTimings = {};
 
     if (!layout.isValid()) {
         return false;
     }
 
-    layout.scaleSizes(d->m_restoreOptions);
+    layout.scaleSizes(m_restoreOptions);
 
-    d->floatWidgetsWhichSkipRestore(layout.mainWindowNames());
-    d->floatUnknownWidgets(layout);
+    floatWidgetsWhichSkipRestore(layout.mainWindowNames());
+    floatUnknownWidgets(layout);
 
-    Private::RAIIIsRestoring isRestoring;
+    RAIIIsRestoring isRestoring;
 
     // Hide all dockwidgets and unparent them from any layout before starting restore
     // We only close the stuff that the loaded JSON knows about. Unknown widgets might be newer.
 
-    d->m_dockRegistry->clear(d->m_dockRegistry->dockWidgets(layout.dockWidgetsToClose()),
-                             d->m_dockRegistry->mainWindows(layout.mainWindowNames()),
-                             d->m_affinityNames);
+    m_dockRegistry->clear(m_dockRegistry->dockWidgets(layout.dockWidgetsToClose()),
+                          m_dockRegistry->mainWindows(layout.mainWindowNames()),
+                          m_affinityNames);
+
+    QElapsedTimer timer;
+    timer.start();
 
     // 1. Restore main windows
     for (const LayoutSaver::MainWindow &mw : qAsConst(layout.mainWindows)) {
-        MainWindowBase *mainWindow = d->m_dockRegistry->mainWindowByName(mw.uniqueName);
+        MainWindowBase *mainWindow = m_dockRegistry->mainWindowByName(mw.uniqueName);
         if (!mainWindow) {
             if (auto mwFunc = Config::self().mainWindowFactoryFunc()) {
                 mainWindow = mwFunc(mw.uniqueName);
@@ -252,11 +336,11 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
             }
         }
 
-        if (!d->matchesAffinity(mainWindow->affinities()))
+        if (!matchesAffinity(mainWindow->affinities()))
             continue;
 
-        if (!(d->m_restoreOptions & InternalRestoreOption::SkipMainWindowGeometry)) {
-            d->deserializeWindowGeometry(mw, mainWindow->window()); // window(), as the MainWindow can be embedded
+        if (!(m_restoreOptions & InternalRestoreOption::SkipMainWindowGeometry)) {
+            deserializeWindowGeometry(mw, mainWindow->window()); // window(), as the MainWindow can be embedded
             if (mw.windowState != Qt::WindowNoState) {
                 if (auto w = mainWindow->windowHandle()) {
                     w->setWindowState(mw.windowState);
@@ -268,9 +352,12 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
             return false;
     }
 
+    m_restoreTimings.mainWindowsNSecs = timer.nsecsElapsed();
+    timer.restart();
+
     // 2. Restore FloatingWindows
     for (LayoutSaver::FloatingWindow &fw : layout.floatingWindows) {
-        if (!d->matchesAffinity(fw.affinities) || fw.skipsRestore())
+        if (!matchesAffinity(fw.affinities) || fw.skipsRestore())
             continue;
 
         MainWindowBase *parent = fw.parentIndex == -1 ? nullptr
@@ -278,99 +365,42 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
 
         auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(parent, static_cast<FloatingWindowFlags>(fw.flags));
         fw.floatingWindowInstance = floatingWindow;
-        d->deserializeWindowGeometry(fw, floatingWindow);
+        deserializeWindowGeometry(fw, floatingWindow);
         if (!floatingWindow->deserialize(fw)) {
             qWarning() << Q_FUNC_INFO << "Failed to deserialize floating window";
             return false;
         }
     }
 
+    m_restoreTimings.floatingWindowsNSecs = timer.nsecsElapsed();
+    timer.restart();
+
     // 3. Restore closed dock widgets. They remain closed but acquire geometry and placeholder properties
     for (const auto &dw : qAsConst(layout.closedDockWidgets)) {
-        if (d->matchesAffinity(dw->affinities)) {
+        if (matchesAffinity(dw->affinities)) {
             DockWidgetBase::deserialize(dw);
         }
     }
 
+    m_restoreTimings.closedDockWidgetsNSecs = timer.nsecsElapsed();
+    timer.restart();
+
     // 4. Restore the placeholder info, now that the Items have been created
     for (const auto &dw : qAsConst(layout.allDockWidgets)) {
-        if (!d->matchesAffinity(dw->affinities))
+        if (!matchesAffinity(dw->affinities))
             continue;
 
         if (DockWidgetBase *dockWidget =
-                d->m_dockRegistry->dockByName(dw->uniqueName, DockRegistry::DockByNameFlag::ConsultRemapping)) {
+                m_dockRegistry->dockByName(dw->uniqueName, DockRegistry::DockByNameFlag::ConsultRemapping)) {
             dockWidget->d->lastPosition()->deserialize(dw->lastPosition);
         } else {
             qWarning() << Q_FUNC_INFO << "Couldn't find dock widget" << dw->uniqueName;
         }
     }
 
-    return true;
-}
+    m_restoreTimings.placeholdersNSecs = timer.nsecsElapsed();
 
-void LayoutSaver::setAffinityNames(const QStringList &affinityNames)
-{
-    d->m_affinityNames = affinityNames;
-    if (affinityNames.contains(QString())) {
-        // Any window with empty affinity will also be subject to save/restore
-        d->m_affinityNames << QString();
-    }
-}
-
-LayoutSaver::Private *LayoutSaver::dptr() const
-{
-    return d;
-}
-
-DockWidgetBase::List LayoutSaver::restoredDockWidgets() const
-{
-    const DockWidgetBase::List &allDockWidgets = DockRegistry::self()->dockwidgets();
-    DockWidgetBase::List result;
-    result.reserve(allDockWidgets.size());
-    for (DockWidgetBase *dw : allDockWidgets) {
-        if (dw->property("kddockwidget_was_restored").toBool())
-            result.push_back(dw);
-    }
-
-    return result;
-}
-
-void LayoutSaver::Private::clearRestoredProperty()
-{
-    const DockWidgetBase::List &allDockWidgets = DockRegistry::self()->dockwidgets();
-    for (DockWidgetBase *dw : allDockWidgets) {
-        dw->setProperty("kddockwidget_was_restored", QVariant());
-    }
-}
-
-template<typename T>
-void LayoutSaver::Private::deserializeWindowGeometry(const T &saved, QWidgetOrQuick *topLevel)
-{
-    // Not simply calling QWidget::setGeometry() here.
-    // For QtQuick we need to modify the QWindow's geometry.
-
-    QRect geometry = saved.geometry;
-    if (!isNormalWindowState(saved.windowState)) {
-        // The window will be maximized. We first set its geometry to normal
-        // Later it's maximized and will remember this value
-        geometry = saved.normalGeometry;
-    }
-
-    ::FloatingWindow::ensureRectIsOnScreen(geometry);
-
-    if (topLevel->isWindow()) {
-        topLevel->setGeometry(geometry);
-    } else {
-        KDDockWidgets::Private::setTopLevelGeometry(geometry, topLevel);
-    }
-
-    topLevel->setVisible(saved.isVisible);
-}
-
-LayoutSaver::Private::Private(RestoreOptions options)
-    : m_dockRegistry(DockRegistry::self())
-    , m_restoreOptions(internalRestoreOptions(options))
-{
+    return true;
 }
 
 bool LayoutSaver::Private::matchesAffinity(const QStringList &affinities) const
@@ -426,7 +456,8 @@ void LayoutSaver::Private::deleteEmptyFrames()
                 qWarning() << Q_FUNC_INFO << "Expected item for frame";
             }
 
-            delete frame;
+            if (!Config::self().frameworkWidgetFactory()->recycleFrame(frame))
+                delete frame;
         }
     }
 }
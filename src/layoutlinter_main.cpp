@@ -9,7 +9,18 @@
   Contact KDAB at <info@kdab.com> for commercial licensing options.
 */
 
+// Validates saved layouts. Accepts files, directories (searched recursively for *.json) and
+// glob patterns. By default layouts are validated without creating any widget, on a thread
+// pool, see LayoutLinter. --restore restores each file with real widgets instead, sequentially.
+// --stats also restores each file, and reports what the layout contains and how long each
+// restore step took, see LayoutLinter::Stats.
+//
+// Exit code: 0 if all layouts are valid, 1 on usage error, 2 if any layout is invalid.
+
 #include "Config.h"
+#include "private/DockRegistry_p.h"
+#include "private/FloatingWindow_p.h"
+#include "private/LayoutLinter_p.h"
 
 #ifdef KDDOCKWIDGETS_QTQUICK
 #include "private/quick/DockWidgetQuick.h"
@@ -20,12 +31,21 @@
 #endif
 
 #include <QApplication>
-#include <QDebug>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
 #include <QString>
+#include <QThreadPool>
+
+#include <iostream>
 
 using namespace KDDockWidgets;
 
-static bool lint(const QString &filename)
+static void setupFactories()
 {
     DockWidgetFactoryFunc dwFunc = [](const QString &dwName) {
         return static_cast<DockWidgetBase *>(new DockWidgetType(dwName));
@@ -37,19 +57,210 @@ static bool lint(const QString &filename)
 
     KDDockWidgets::Config::self().setDockWidgetFactoryFunc(dwFunc);
     KDDockWidgets::Config::self().setMainWindowFactoryFunc(mwFunc);
+}
 
+static bool restore(const QString &filename)
+{
     LayoutSaver restorer;
     return restorer.restoreFromFile(filename);
 }
 
+/// So each layout's stats are measured from the same, empty, starting point
+static void deleteTopLevels()
+{
+    DockRegistry *registry = DockRegistry::self();
+    qDeleteAll(registry->floatingWindows(/*includeBeingDeleted=*/true));
+    qDeleteAll(registry->dockwidgets());
+    qDeleteAll(registry->mainwindows());
+}
+
+static bool writeReport(const QVariantMap &report, const QString &filename)
+{
+    const QByteArray json = QJsonDocument::fromVariant(report).toJson();
+    if (filename.isEmpty()) {
+        std::cout << json.constData();
+        return true;
+    }
+
+    QFile reportFile(filename);
+    if (!reportFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::cerr << "Couldn't write report to " << filename.toStdString() << "\n";
+        return false;
+    }
+
+    reportFile.write(json);
+    return true;
+}
+
+/// Expands directories and glob patterns into the list of files to lint
+static QStringList expandArguments(const QStringList &arguments, QStringList &notFound)
+{
+    QStringList files;
+    for (const QString &argument : arguments) {
+        const QFileInfo info(argument);
+        if (info.isDir()) {
+            QStringList filesInDir;
+            QDirIterator it(argument, { QStringLiteral("*.json") }, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext())
+                filesInDir.push_back(it.next());
+            filesInDir.sort();
+            files << filesInDir;
+        } else if (info.exists()) {
+            files.push_back(argument);
+        } else if (argument.contains(QLatin1Char('*')) || argument.contains(QLatin1Char('?')) || argument.contains(QLatin1Char('['))) {
+            // A pattern the shell didn't expand, for example because it was quoted
+            const QStringList matches = QDir(info.path()).entryList({ info.fileName() }, QDir::Files, QDir::Name);
+            if (matches.isEmpty())
+                notFound.push_back(argument);
+            for (const QString &match : matches)
+                files.push_back(QDir(info.path()).filePath(match));
+        } else {
+            notFound.push_back(argument);
+        }
+    }
+
+    files.removeDuplicates();
+    return files;
+}
+
 int main(int argc, char *argv[])
 {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        // Nothing needs to be shown, and this usually runs in CI
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     QApplication app(argc, argv);
 
-    if (app.arguments().size() != 2) {
-        qDebug() << "Usage: kddockwidgets_linter <layout json file>";
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Validates KDDockWidgets layouts saved with LayoutSaver"));
+    parser.addPositionalArgument(QStringLiteral("paths"), QStringLiteral("Layout JSON files, directories or glob patterns"));
+
+    QCommandLineOption reportOption(QStringLiteral("report"), QStringLiteral("Writes the JSON report to <file> instead of stdout"), QStringLiteral("file"));
+    parser.addOption(reportOption);
+
+    QCommandLineOption jobsOption(QStringLiteral("jobs"), QStringLiteral("Number of threads, defaults to the number of cores"), QStringLiteral("n"));
+    parser.addOption(jobsOption);
+
+    QCommandLineOption restoreOption(QStringLiteral("restore"), QStringLiteral("Restores each file with real widgets instead, sequentially. No report is written"));
+    parser.addOption(restoreOption);
+
+    QCommandLineOption statsOption(QStringLiteral("stats"), QStringLiteral("Restores each file with real widgets, sequentially, and reports its size and restore timings"));
+    parser.addOption(statsOption);
+
+    parser.addHelpOption();
+    parser.process(app);
+
+    QStringList notFound;
+    const QStringList files = expandArguments(parser.positionalArguments(), notFound);
+    for (const QString &path : qAsConst(notFound))
+        std::cerr << "No such file: " << path.toStdString() << "\n";
+
+    if (files.isEmpty() || !notFound.isEmpty()) {
+        parser.showHelp(1);
         return 1;
     }
 
-    return lint(app.arguments().at(1)) ? 0 : 2;
+    const QString reportFilename = parser.value(reportOption);
+
+    if (parser.isSet(restoreOption)) {
+        setupFactories();
+        bool success = true;
+        for (const QString &file : files) {
+            if (!restore(file)) {
+                std::cerr << "FAIL " << file.toStdString() << "\n";
+                success = false;
+            }
+        }
+
+        return success ? 0 : 2;
+    }
+
+    if (parser.isSet(statsOption)) {
+        setupFactories();
+
+        QElapsedTimer timer;
+        timer.start();
+
+        QVariantList statsV;
+        statsV.reserve(files.size());
+        int numFailed = 0;
+        for (const QString &file : files) {
+            const LayoutLinter::Stats stats = LayoutLinter::stats(file);
+            deleteTopLevels();
+
+            statsV.push_back(stats.toVariantMap());
+            if (!stats.success) {
+                numFailed++;
+                std::cerr << "FAIL " << file.toStdString() << "\n";
+                for (const QString &error : stats.errors)
+                    std::cerr << "    " << error.toStdString() << "\n";
+            } else {
+                std::cerr << file.toStdString() << ": " << stats.numItems << " items, depth "
+                          << stats.treeDepth << ", restored in " << stats.restoreNSecs / 1000000.0 << "ms\n";
+            }
+        }
+
+        QVariantMap report;
+        report.insert(QStringLiteral("files"), statsV);
+        report.insert(QStringLiteral("numFiles"), files.size());
+        report.insert(QStringLiteral("numFailed"), numFailed);
+        report.insert(QStringLiteral("totalMs"), timer.elapsed());
+        if (!writeReport(report, reportFilename))
+            return 1;
+
+        return numFailed == 0 ? 0 : 2;
+    }
+
+    QThreadPool pool;
+    if (parser.isSet(jobsOption)) {
+        const int numJobs = parser.value(jobsOption).toInt();
+        if (numJobs <= 0) {
+            std::cerr << "Invalid number of jobs: " << parser.value(jobsOption).toStdString() << "\n";
+            return 1;
+        }
+        pool.setMaxThreadCount(numJobs);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<LayoutLinter::Result> results(files.size());
+    LayoutLinter::Result *out = results.data(); // So the workers don't touch the QVector itself
+    for (int i = 0; i < files.size(); ++i) {
+        const QString file = files.at(i);
+        pool.start([out, i, file] {
+            out[i] = LayoutLinter::lintFile(file);
+        });
+    }
+
+    pool.waitForDone();
+    const qint64 elapsedMs = timer.elapsed();
+
+    QVariantList resultsV;
+    resultsV.reserve(results.size());
+    int numFailed = 0;
+    for (const LayoutLinter::Result &result : qAsConst(results)) {
+        resultsV.push_back(result.toVariantMap());
+        if (!result.success) {
+            numFailed++;
+            std::cerr << "FAIL " << result.filename.toStdString() << "\n";
+            for (const QString &error : result.errors)
+                std::cerr << "    " << error.toStdString() << "\n";
+        }
+    }
+
+    QVariantMap report;
+    report.insert(QStringLiteral("files"), resultsV);
+    report.insert(QStringLiteral("numFiles"), results.size());
+    report.insert(QStringLiteral("numFailed"), numFailed);
+    report.insert(QStringLiteral("threads"), pool.maxThreadCount());
+    report.insert(QStringLiteral("totalMs"), elapsedMs);
+    if (!writeReport(report, reportFilename))
+        return 1;
+
+    std::cerr << results.size() << " layouts, " << numFailed << " invalid, in " << elapsedMs
+              << "ms using " << pool.maxThreadCount() << " threads\n";
+
+    return numFailed == 0 ? 0 : 2;
 }
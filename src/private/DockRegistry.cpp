@@ -14,8 +14,10 @@
 #include "DockWidgetBase.h"
 #include "DockWidgetBase_p.h"
 #include "FloatingWindow_p.h"
+#include "FloatingWindowPool_p.h"
 #include "LayoutWidget_p.h"
 #include "Logging_p.h"
+#include "MDILayoutWidget_p.h"
 #include "MainWindowMDI.h"
 #include "Position_p.h"
 #include "QWidgetAdapter.h"
@@ -28,6 +30,7 @@
 #include <QPointer>
 #include <QDebug>
 #include <QGuiApplication>
+#include <QTimer>
 #include <QWindow>
 
 #ifdef KDDOCKWIDGETS_QTWIDGETS
@@ -85,27 +88,69 @@ void DockRegistry::maybeDelete()
 
 void DockRegistry::onFocusObjectChanged(QObject *obj)
 {
+    // Single walk up the parents, which resolves both the focused dock widget and the focus
+    // scopes containing obj. FocusScopes don't listen to focusObjectChanged themselves, so
+    // a focus change doesn't fan out into every Frame.
+    QVector<const QObject *> focusedScopes;
+    DockWidgetBase *focusedDockWidget = nullptr;
+    bool dockWidgetResolved = false;
+
     auto p = qobject_cast<WidgetType *>(obj);
     while (p) {
-        if (auto frame = qobject_cast<Frame *>(p)) {
-            // Special case: The focused widget is inside the frame but not inside the dockwidget.
-            // For example, it's a line edit in the QTabBar. We still need to send the signal for
-            // the current dw in the tab group
-            if (auto dw = frame->currentDockWidget()) {
-                setFocusedDockWidget(dw);
+        if (m_focusScopes.contains(p))
+            focusedScopes.push_back(p);
+
+        if (!dockWidgetResolved) {
+            if (auto frame = qobject_cast<Frame *>(p)) {
+                // Special case: The focused widget is inside the frame but not inside the dockwidget.
+                // For example, it's a line edit in the QTabBar. We still need to send the signal for
+                // the current dw in the tab group
+                focusedDockWidget = frame->currentDockWidget();
+                dockWidgetResolved = true;
+            } else if (auto dw = qobject_cast<DockWidgetBase *>(p)) {
+                focusedDockWidget = dw;
+                dockWidgetResolved = true;
             }
-
-            return;
         }
 
-        if (auto dw = qobject_cast<DockWidgetBase *>(p)) {
-            DockRegistry::self()->setFocusedDockWidget(dw);
-            return;
-        }
         p = KDDockWidgets::Private::parentWidget(p);
     }
 
-    setFocusedDockWidget(nullptr);
+    if (!dockWidgetResolved) {
+        setFocusedDockWidget(nullptr);
+    } else if (focusedDockWidget) {
+        setFocusedDockWidget(focusedDockWidget);
+    }
+
+    // Only notify the scopes which lost or got focus. Callbacks might delete scopes, so look
+    // them up again each time.
+    const QVector<const QObject *> previouslyFocusedScopes = m_focusedScopes;
+    m_focusedScopes = focusedScopes;
+
+    for (const QObject *scopeWidget : previouslyFocusedScopes) {
+        if (!focusedScopes.contains(scopeWidget)) {
+            if (FocusScope *scope = m_focusScopes.value(scopeWidget))
+                scope->onFocusObjectChanged(obj, /*isInScope=*/false);
+        }
+    }
+
+    for (const QObject *scopeWidget : qAsConst(focusedScopes)) {
+        if (FocusScope *scope = m_focusScopes.value(scopeWidget))
+            scope->onFocusObjectChanged(obj, /*isInScope=*/true);
+    }
+}
+
+void DockRegistry::registerFocusScope(FocusScope *scope, QObject *scopeWidget)
+{
+    m_focusScopes.insert(scopeWidget, scope);
+    if (scope->isFocused())
+        m_focusedScopes.push_back(scopeWidget);
+}
+
+void DockRegistry::unregisterFocusScope(QObject *scopeWidget)
+{
+    m_focusScopes.remove(scopeWidget);
+    m_focusedScopes.removeOne(scopeWidget);
 }
 
 void DockRegistry::setFocusedDockWidget(DockWidgetBase *dw)
@@ -332,6 +377,13 @@ void DockRegistry::registerMainWindow(MainWindowBase *mainWindow)
     }
 
     m_mainWindows << mainWindow;
+
+    if (Config::self().floatingWindowPoolSize() > 0) {
+        // Deferred, as we're still inside the MainWindow ctor
+        QTimer::singleShot(0, mainWindow, [mainWindow] {
+            FloatingWindowPool::self()->prewarm(mainWindow);
+        });
+    }
 }
 
 void DockRegistry::unregisterMainWindow(MainWindowBase *mainWindow)
@@ -450,6 +502,7 @@ DockWidgetBase *DockRegistry::dockWidgetForGuest(QWidgetOrQuick *guest) const
 bool DockRegistry::isSane() const
 {
     QSet<QString> names;
+    names.reserve(m_dockWidgets.size());
     for (auto dock : qAsConst(m_dockWidgets)) {
         const QString name = dock->uniqueName();
         if (name.isEmpty()) {
@@ -476,7 +529,7 @@ bool DockRegistry::isSane() const
             names.insert(name);
         }
 
-        if (!mainwindow->layoutWidget()->checkSanity())
+        if (!mainwindow->layoutWidget()->runSanityCheck())
             return false;
     }
 
@@ -715,8 +768,8 @@ bool DockRegistry::eventFilter(QObject *watched, QEvent *event)
     } else if (event->type() == QEvent::MouseButtonPress) {
         // When clicking on a MDI Frame we raise the window
         if (Frame *f = firstParentOfType<Frame>(watched)) {
-            if (f->isMDI())
-                f->raise();
+            if (MDILayoutWidget *layout = f->mdiLayoutWidget())
+                layout->raiseDockWidget(f);
         }
 
         // The following code is for hididng the overlay
@@ -78,6 +78,7 @@ public:
     /// @brief returns the dock widget that hosts @p guest widget. Nullptr if there's none.
     DockWidgetBase *dockWidgetForGuest(QWidgetOrQuick *guest) const;
 
+    /// @brief Returns whether names are unique and the layouts pass the checks chosen by Config::setSanityCheckLevel()
     bool isSane() const;
 
     ///@brief returns all DockWidget instances
@@ -246,6 +247,8 @@ private:
     void onFocusObjectChanged(QObject *obj);
     void maybeDelete();
     void setFocusedDockWidget(DockWidgetBase *);
+    void registerFocusScope(FocusScope *, QObject *scopeWidget);
+    void unregisterFocusScope(QObject *scopeWidget);
 
     bool m_isProcessingAppQuitEvent = false;
     DockWidgetBase::List m_dockWidgets;
@@ -255,6 +258,13 @@ private:
     QVector<LayoutWidget *> m_layouts;
     QPointer<DockWidgetBase> m_focusedDockWidget;
 
+    ///@brief All FocusScopes, keyed by their widget. Allows resolving the scopes of the focus
+    /// object with a single walk up its parents.
+    QHash<const QObject *, FocusScope *> m_focusScopes;
+
+    ///@brief The widgets of the scopes which currently contain the focus object
+    QVector<const QObject *> m_focusedScopes;
+
     ///@brief Dock widget id remapping, used by LayoutSaver
     ///
     /// When LayoutSaver is trying to restore dock widget "foo", but it doesn't exist, it will
@@ -475,8 +475,12 @@ void StateInternalMDIDragging::onEntry()
 
     // Raise the dock widget being dragged
     if (auto tb = qobject_cast<TitleBar *>(q->m_draggable->asWidget())) {
-        if (Frame *f = tb->frame())
-            f->raise();
+        if (Frame *f = tb->frame()) {
+            if (MDILayoutWidget *layout = f->mdiLayoutWidget())
+                layout->raiseDockWidget(f);
+            else
+                f->raise();
+        }
     }
 
     Q_EMIT q->isDraggingChanged();
@@ -142,11 +142,11 @@ void DropArea::addDockWidget(DockWidgetBase *dw, Location location,
             // The frame only has this dock widget, and the frame is already in the layout. So move the frame instead
             frame = oldFrame;
         } else {
-            frame = Config::self().frameworkWidgetFactory()->createFrame();
+            frame = Config::self().frameworkWidgetFactory()->acquireFrame();
             frame->addWidget(dw);
         }
     } else {
-        frame = Config::self().frameworkWidgetFactory()->createFrame();
+        frame = Config::self().frameworkWidgetFactory()->acquireFrame();
         frame->addWidget(dw);
     }
 
@@ -345,7 +345,7 @@ bool DropArea::drop(QWidgetOrQuick *droppedWindow, KDDockWidgets::Location locat
         if (!validateAffinity(dock))
             return false;
 
-        auto frame = Config::self().frameworkWidgetFactory()->createFrame();
+        auto frame = Config::self().frameworkWidgetFactory()->acquireFrame();
         frame->addWidget(dock);
         addWidget(frame, location, relativeTo, DefaultSizeMode::FairButFloor);
     } else if (auto floatingWindow = qobject_cast<FloatingWindow *>(droppedWindow)) {
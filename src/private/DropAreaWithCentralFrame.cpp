@@ -40,7 +40,7 @@ Frame *DropAreaWithCentralFrame::createCentralFrame(MainWindowOptions options)
             frameOptions |= FrameOption_AlwaysShowsTabs;
         }
 
-        frame = Config::self().frameworkWidgetFactory()->createFrame(nullptr, frameOptions);
+        frame = Config::self().frameworkWidgetFactory()->acquireFrame(nullptr, frameOptions);
         frame->setObjectName(QStringLiteral("central frame"));
     }
 
@@ -10,6 +10,7 @@
 */
 
 #include "FloatingWindow_p.h"
+#include "FloatingWindowPool_p.h"
 #include "KDDockWidgets.h"
 #include "MainWindowBase.h"
 #include "Logging_p.h"
@@ -211,6 +212,11 @@ static FloatingWindowFlags floatingWindowFlagsForFrame(Frame *frame)
 
 FloatingWindow::FloatingWindow(Frame *frame, QRect suggestedGeometry, MainWindowBase *parent)
     : FloatingWindow(suggestedGeometry, hackFindParentHarder(frame, parent), floatingWindowFlagsForFrame(frame))
+{
+    adoptFrame(frame);
+}
+
+void FloatingWindow::adoptFrame(Frame *frame)
 {
     QScopedValueRollback<bool> guard(m_disableSetVisible, true);
 
@@ -266,7 +272,8 @@ FloatingWindow::~FloatingWindow()
     disconnect(m_layoutDestroyedConnection);
     delete m_nchittestFilter;
 
-    DockRegistry::self()->unregisterFloatingWindow(this);
+    if (!m_pooled) // Pooled windows were already unregistered
+        DockRegistry::self()->unregisterFloatingWindow(this);
 }
 
 #if defined(Q_OS_WIN) && defined(KDDOCKWIDGETS_QTWIDGETS)
@@ -387,11 +394,61 @@ void FloatingWindow::setSuggestedGeometry(QRect suggestedRect, SuggestedGeometry
 
 void FloatingWindow::scheduleDeleteLater()
 {
+    if (m_pooled || m_deleteScheduled)
+        return;
+
+    if (!m_inDtor && FloatingWindowPool::self()->release(this))
+        return;
+
     m_deleteScheduled = true;
     DockRegistry::self()->unregisterFloatingWindow(this);
     deleteLater();
 }
 
+bool FloatingWindow::isPooled() const
+{
+    return m_pooled;
+}
+
+bool FloatingWindow::canBePooled() const
+{
+    if (m_inDtor || m_deleteScheduled || m_pooled || !m_dropArea)
+        return false;
+
+    // Placeholders still reference this layout, they need to die with it so closed dock widgets
+    // don't get restored into a hidden window
+    if (m_dropArea->count() > 0)
+        return false;
+
+    return !isMaximizedOverride() && !isMinimizedOverride();
+}
+
+bool FloatingWindow::canHostFrame(Frame *frame, MainWindowBase *candidateParent) const
+{
+    // A FloatingWindow created for this frame would get these flags and parent
+    const FloatingWindowFlags flags = flagsForFloatingWindow(floatingWindowFlagsForFrame(frame));
+    MainWindowBase *parent = actualParent(hackFindParentHarder(frame, candidateParent));
+
+    return flags == m_flags && parent == mainWindow();
+}
+
+void FloatingWindow::enterPool()
+{
+    m_pooled = true;
+    DockRegistry::self()->unregisterFloatingWindow(this);
+    setVisible(false);
+
+    // Constraints were computed for the previous content
+    setMaximumSize(Layouting::Item::hardcodedMaximumSize);
+}
+
+void FloatingWindow::leavePool(Frame *frame)
+{
+    m_pooled = false;
+    DockRegistry::self()->registerFloatingWindow(this);
+    adoptFrame(frame);
+}
+
 MultiSplitter *FloatingWindow::multiSplitter() const
 {
     return m_dropArea;
@@ -458,7 +515,7 @@ Frame *FloatingWindow::singleFrame() const
 
 bool FloatingWindow::beingDeleted() const
 {
-    if (m_deleteScheduled || m_inDtor)
+    if (m_deleteScheduled || m_inDtor || m_pooled)
         return true;
 
     // TODO: Confusing logic
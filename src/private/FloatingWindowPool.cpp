@@ -0,0 +1,144 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "FloatingWindowPool_p.h"
+#include "FloatingWindow_p.h"
+#include "Logging_p.h"
+#include "Config.h"
+#include "FrameworkWidgetFactory.h"
+#include "MainWindowBase.h"
+
+#include <QCoreApplication>
+
+#include <algorithm>
+
+using namespace KDDockWidgets;
+
+FloatingWindowPool::FloatingWindowPool()
+    : QObject(qApp) // Deleted with the application, self() then creates a new one if needed
+{
+    // Delete pooled windows while widgets can still be deleted
+    if (qApp)
+        connect(qApp, &QCoreApplication::aboutToQuit, this, &FloatingWindowPool::clear);
+}
+
+FloatingWindowPool::~FloatingWindowPool()
+{
+}
+
+FloatingWindowPool *FloatingWindowPool::self()
+{
+    static QPointer<FloatingWindowPool> s_pool;
+
+    if (!s_pool)
+        s_pool = new FloatingWindowPool();
+
+    return s_pool;
+}
+
+FloatingWindow *FloatingWindowPool::acquire(Frame *frame, MainWindowBase *parent,
+                                            QRect suggestedGeometry)
+{
+    removeDeadWindows();
+
+    for (int i = 0; i < m_windows.size(); ++i) {
+        FloatingWindow *fw = m_windows.at(i);
+        if (!fw->canHostFrame(frame, parent))
+            continue;
+
+        m_windows.removeAt(i);
+        m_stats.hits++;
+        qCDebug(creation) << Q_FUNC_INFO << "Reusing pooled" << fw;
+
+        fw->leavePool(frame);
+        if (!suggestedGeometry.isNull())
+            fw->setGeometry(suggestedGeometry);
+
+        return fw;
+    }
+
+    if (Config::self().floatingWindowPoolSize() > 0)
+        m_stats.misses++;
+
+    return Config::self().frameworkWidgetFactory()->createFloatingWindow(frame, parent, suggestedGeometry);
+}
+
+bool FloatingWindowPool::release(FloatingWindow *fw)
+{
+    removeDeadWindows();
+
+    const int maxSize = Config::self().floatingWindowPoolSize();
+    if (maxSize <= 0)
+        return false;
+
+    if (m_windows.size() >= maxSize || !fw->canBePooled()) {
+        m_stats.rejected++;
+        return false;
+    }
+
+    fw->enterPool();
+    m_windows.push_back(fw);
+    m_stats.recycled++;
+    qCDebug(creation) << Q_FUNC_INFO << "Pooled" << fw;
+
+    return true;
+}
+
+void FloatingWindowPool::prewarm(MainWindowBase *mainWindow)
+{
+    removeDeadWindows();
+
+    const int maxSize = Config::self().floatingWindowPoolSize();
+    while (m_windows.size() < maxSize) {
+        FloatingWindow *fw = Config::self().frameworkWidgetFactory()->createFloatingWindow(mainWindow);
+
+        // Create the native window now, that's the expensive part we want to avoid when undocking
+        fw->winId();
+        fw->enterPool();
+        m_windows.push_back(fw);
+        m_stats.prewarmed++;
+    }
+}
+
+void FloatingWindowPool::clear()
+{
+    const QVector<QPointer<FloatingWindow>> windows = std::move(m_windows);
+    m_windows.clear();
+
+    for (FloatingWindow *fw : windows)
+        delete fw;
+}
+
+int FloatingWindowPool::count() const
+{
+    return int(std::count_if(m_windows.cbegin(), m_windows.cend(), [](const QPointer<FloatingWindow> &fw) {
+        return !fw.isNull();
+    }));
+}
+
+FloatingWindowPool::Stats FloatingWindowPool::stats() const
+{
+    return m_stats;
+}
+
+void FloatingWindowPool::resetStats()
+{
+    m_stats = {};
+}
+
+void FloatingWindowPool::removeDeadWindows()
+{
+    // Pooled windows are children of their main window, so might have been deleted meanwhile
+    m_windows.erase(std::remove_if(m_windows.begin(), m_windows.end(), [](const QPointer<FloatingWindow> &fw) {
+                        return fw.isNull();
+                    }),
+                    m_windows.end());
+}
@@ -0,0 +1,86 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_FLOATING_WINDOW_POOL_P_H
+#define KD_FLOATING_WINDOW_POOL_P_H
+
+#include "kddockwidgets/docks_export.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QRect>
+#include <QVector>
+
+namespace KDDockWidgets {
+
+class FloatingWindow;
+class Frame;
+class MainWindowBase;
+
+/**
+ * @brief A bounded pool of hidden, empty FloatingWindows.
+ *
+ * Instead of destroying a FloatingWindow once its last frame is docked, it's hidden and
+ * parked here, so the next undock can reuse it without creating a new native window,
+ * DropArea, TitleBar and WidgetResizeHandler.
+ *
+ * Disabled by default. @sa Config::setFloatingWindowPoolSize()
+ */
+class DOCKS_EXPORT FloatingWindowPool : public QObject
+{
+    Q_OBJECT
+public:
+    struct Stats
+    {
+        int hits = 0; ///< acquire() was served by a pooled window
+        int misses = 0; ///< acquire() had to create a new window
+        int recycled = 0; ///< release() parked a window in the pool
+        int rejected = 0; ///< release() refused a window, which was then deleted as usual
+        int prewarmed = 0; ///< windows created in advance by prewarm()
+    };
+
+    static FloatingWindowPool *self();
+
+    /// @brief Returns a FloatingWindow containing @p frame
+    /// Reuses a pooled window if there's a compatible one, otherwise asks the FrameworkWidgetFactory
+    /// for a new one. Same semantics as FrameworkWidgetFactory::createFloatingWindow(Frame*, ...)
+    FloatingWindow *acquire(Frame *frame, MainWindowBase *parent = nullptr,
+                            QRect suggestedGeometry = {});
+
+    /// @brief Tries to park @p fw in the pool
+    /// Returns false if the pool is disabled, full, or if the window can't be recycled
+    /// (for example because it still has placeholders), in which case the caller deletes it.
+    bool release(FloatingWindow *fw);
+
+    /// @brief Creates hidden windows for @p mainWindow until the pool is full
+    void prewarm(MainWindowBase *mainWindow);
+
+    /// @brief Deletes all pooled windows
+    void clear();
+
+    /// @brief Returns the number of windows currently in the pool
+    int count() const;
+
+    /// @brief Returns the hit/miss counters
+    Stats stats() const;
+    void resetStats();
+
+private:
+    FloatingWindowPool();
+    ~FloatingWindowPool() override;
+    void removeDeadWindows();
+    QVector<QPointer<FloatingWindow>> m_windows;
+    Stats m_stats;
+};
+
+}
+
+#endif
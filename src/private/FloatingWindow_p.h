@@ -32,6 +32,7 @@ class DropArea;
 class Frame;
 class MultiSplitter;
 class LayoutWidget;
+class FloatingWindowPool;
 
 class DOCKS_EXPORT FloatingWindow
     : public QWidgetAdapter,
@@ -125,9 +126,17 @@ public:
 
     /**
      * @brief Equivalent to deleteLater() but sets beingDeleted() to true
+     *
+     * If the FloatingWindowPool is enabled the window might be recycled instead of deleted.
      */
     void scheduleDeleteLater();
 
+    /**
+     * @brief Returns whether this window is hidden and parked in the FloatingWindowPool
+     * Pooled windows aren't registered in the DockRegistry and report beingDeleted() as true.
+     */
+    bool isPooled() const;
+
     /**
      * @brief Returns the MultiSplitter
      */
@@ -258,12 +267,19 @@ protected:
 
 private:
     Q_DISABLE_COPY(FloatingWindow)
+    friend class FloatingWindowPool;
+    void adoptFrame(Frame *frame);
+    bool canBePooled() const;
+    bool canHostFrame(Frame *frame, MainWindowBase *candidateParent) const;
+    void enterPool();
+    void leavePool(Frame *frame);
     QSize maxSizeHint() const;
     void updateSizeConstraints();
     void onFrameCountChanged(int count);
     void onVisibleFrameCountChanged(int count);
     bool m_disableSetVisible = false;
     bool m_deleteScheduled = false;
+    bool m_pooled = false;
     bool m_inDtor = false;
     bool m_updatingTitleBarVisibility = false;
     QMetaObject::Connection m_layoutDestroyedConnection;
@@ -21,6 +21,7 @@
 #include "DockRegistry_p.h"
 #include "DockWidgetBase_p.h"
 #include "FloatingWindow_p.h"
+#include "FloatingWindowPool_p.h"
 #include "FrameworkWidgetFactory.h"
 #include "LayoutSaver_p.h"
 #include "LayoutWidget_p.h"
@@ -74,7 +75,9 @@ Frame::Frame(QWidgetOrQuick *parent, FrameOptions options, int userType)
     s_dbg_numFrames++;
     DockRegistry::self()->registerFrame(this);
 
-    connect(this, &Frame::currentDockWidgetChanged, this, &Frame::updateTitleAndIcon);
+    connect(this, &Frame::currentDockWidgetChanged, this, [this] {
+        scheduleUpdate(PendingUpdate_TitleAndIcon);
+    });
 
     connect(m_tabWidget->asWidget(), SIGNAL(currentTabChanged(int)), // clazy:exclude=old-style-connect
             this, SLOT(onCurrentTabChanged(int)));
@@ -86,14 +89,16 @@ Frame::Frame(QWidgetOrQuick *parent, FrameOptions options, int userType)
 Frame::~Frame()
 {
     m_inDtor = true;
-    s_dbg_numFrames--;
+    if (!m_isRecycled) // Recycled frames were already accounted for
+        s_dbg_numFrames--;
     if (m_layoutItem)
         m_layoutItem->unref();
 
     delete m_resizeHandler;
     m_resizeHandler = nullptr;
 
-    DockRegistry::self()->unregisterFrame(this);
+    if (!m_isRecycled)
+        DockRegistry::self()->unregisterFrame(this);
 
     // Run some disconnects() too, so we don't receive signals during destruction:
     setLayoutWidget(nullptr);
@@ -120,17 +125,60 @@ void Frame::updateTitleAndIcon()
 
 void Frame::onDockWidgetTitleChanged()
 {
-    updateTitleAndIcon();
-
     if (!m_inCtor) { // don't call pure virtual in ctor
         if (auto dw = qobject_cast<DockWidgetBase *>(sender())) {
-            int index = indexOfDockWidget(dw);
-            renameTab(index, dw->title());
-            changeTabIcon(index, dw->icon(DockWidgetBase::IconPlace::TabBar));
+            if (!m_pendingTabUpdates.contains(dw))
+                m_pendingTabUpdates.push_back(dw);
+        }
+    }
+
+    scheduleUpdate(PendingUpdate_TitleAndIcon);
+}
+
+void Frame::scheduleUpdate(PendingUpdate update)
+{
+    const bool wasScheduled = m_pendingUpdates != PendingUpdate_None;
+    m_pendingUpdates |= update;
+
+    if (!(Config::self().flags() & Config::Flag_DeferTitleUpdates)) {
+        applyPendingUpdates();
+    } else if (!wasScheduled) {
+        // Apps updating titles often (progress, modified markers) would otherwise relayout each time
+        QTimer::singleShot(0, this, &Frame::applyPendingUpdates);
+    }
+}
+
+void Frame::applyPendingUpdates()
+{
+    const int updates = m_pendingUpdates;
+    const QVector<QPointer<DockWidgetBase>> docks = std::move(m_pendingTabUpdates);
+    m_pendingUpdates = PendingUpdate_None;
+    m_pendingTabUpdates.clear();
+
+    if (updates == PendingUpdate_None)
+        return;
+
+    if (updates & PendingUpdate_TitleBarVisibility)
+        updateTitleBarVisibility();
+
+    if (updates & PendingUpdate_TitleAndIcon) {
+        updateTitleAndIcon();
+
+        for (DockWidgetBase *dw : docks) {
+            const int index = dw ? indexOfDockWidget(dw) : -1;
+            if (index != -1) {
+                renameTab(index, dw->title());
+                changeTabIcon(index, dw->icon(DockWidgetBase::IconPlace::TabBar));
+            }
         }
     }
 }
 
+bool Frame::hasPendingUpdates() const
+{
+    return m_pendingUpdates != PendingUpdate_None;
+}
+
 void Frame::addWidget(DockWidgetBase *dockWidget, InitialOption addingOption)
 {
     insertWidget(dockWidget, dockWidgetCount(), addingOption); // append
@@ -209,13 +257,13 @@ FloatingWindow *Frame::detachTab(DockWidgetBase *dockWidget)
     QRect r = dockWidget->geometry();
     removeWidget(dockWidget);
 
-    auto newFrame = Config::self().frameworkWidgetFactory()->createFrame();
+    auto newFrame = Config::self().frameworkWidgetFactory()->acquireFrame();
     const QPoint globalPoint = mapToGlobal(QPoint(0, 0));
     newFrame->addWidget(dockWidget);
 
     // We're potentially already dead at this point, as frames with 0 tabs auto-destruct. Don't access members from this point.
 
-    auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(newFrame);
+    auto floatingWindow = FloatingWindowPool::self()->acquire(newFrame);
     r.moveTopLeft(globalPoint);
     floatingWindow->setSuggestedGeometry(r, SuggestedGeometryHint_GeometryIsFromDocked);
     floatingWindow->show();
@@ -293,7 +341,7 @@ void Frame::onDockWidgetCountChanged()
     if (isEmpty() && !isCentralFrame()) {
         scheduleDeleteLater();
     } else {
-        updateTitleBarVisibility();
+        scheduleUpdate(PendingUpdate_TitleBarVisibility);
 
         // We don't really keep track of the state, so emit even if the visibility didn't change. No biggie.
         if (!(m_options & FrameOption_AlwaysShowsTabs))
@@ -616,8 +664,9 @@ void Frame::setLayoutWidget(LayoutWidget *dt)
 
         // We keep the connect result so we don't dereference m_layoutWidget at shutdown
         m_visibleWidgetCountChangedConnection =
-            connect(m_layoutWidget, &LayoutWidget::visibleWidgetCountChanged, this,
-                    &Frame::updateTitleBarVisibility);
+            connect(m_layoutWidget, &LayoutWidget::visibleWidgetCountChanged, this, [this] {
+                scheduleUpdate(PendingUpdate_TitleBarVisibility);
+            });
         updateTitleBarVisibility();
         if (wasInMainWindow != isInMainWindow())
             Q_EMIT isInMainWindowChanged();
@@ -663,6 +712,10 @@ bool Frame::isInMainWindow() const
 bool Frame::event(QEvent *e)
 {
     if (e->type() == QEvent::ParentChange) {
+        // Instead of Item having an event filter on each frame
+        if (m_layoutItem && m_layoutItem->guestAsQObject() == this)
+            m_layoutItem->onGuestParentChanged();
+
         if (auto layoutWidget = qobject_cast<LayoutWidget *>(QWidgetAdapter::parentWidget())) {
             setLayoutWidget(layoutWidget);
         } else {
@@ -707,7 +760,7 @@ Frame *Frame::deserialize(const LayoutSaver::Frame &f)
     }
 
     if (!frame)
-        frame = widgetFactory->createFrame(/*parent=*/nullptr, options);
+        frame = widgetFactory->acquireFrame(/*parent=*/nullptr, options);
 
     frame->setObjectName(f.objectName);
 
@@ -748,13 +801,73 @@ LayoutSaver::Frame Frame::serialize() const
 void Frame::scheduleDeleteLater()
 {
     qCDebug(creation) << Q_FUNC_INFO << this;
+    if (m_beingDeleted) // Already scheduled
+        return;
+
     m_beingDeleted = true;
     QTimer::singleShot(0, this, [this] {
         // Can't use deleteLater() here due to QTBUG-83030 (deleteLater() never delivered if triggered by a sendEvent() before event loop starts)
-        delete this;
+        if (!Config::self().frameworkWidgetFactory()->recycleFrame(this))
+            delete this;
     });
 }
 
+bool Frame::canBeRecycled() const
+{
+    if (m_inDtor || m_isRecycled || !isEmpty())
+        return false;
+
+    // These are owned by something else, or have been tweaked after construction
+    return !isCentralFrame() && !isOverlayed() && !isMDIWrapper() && m_userType == 0;
+}
+
+void Frame::prepareForRecycling()
+{
+    m_isRecycled = true;
+    m_beingDeleted = true;
+    s_dbg_numFrames--;
+
+    // Same as what ~Frame() does, but without dying
+    if (Layouting::Item *item = m_layoutItem) {
+        m_layoutItem = nullptr;
+        QPointer<Layouting::Item> guard = item;
+        item->unref();
+        if (guard) // unref() might have deleted it
+            guard->releaseGuest();
+    }
+
+    DockRegistry::self()->unregisterFrame(this);
+    setLayoutWidget(nullptr);
+    QWidgetAdapter::setParent(nullptr);
+    QWidgetAdapter::setVisible(false);
+
+    clearFocusedWidget();
+    setObjectName(QString());
+    m_pendingUpdates = PendingUpdate_None;
+    m_pendingTabUpdates.clear();
+    m_titleBar->setTitle(QString());
+    m_titleBar->setIcon(QIcon());
+}
+
+bool Frame::canBeReusedWith(FrameOptions options) const
+{
+    // Only for the same options. Besides the TabWidget and TabBar being built differently, this means
+    // central and overlayed frames are always created, as canBeRecycled() never pools them.
+    return m_options == actualOptions(options);
+}
+
+void Frame::reuse(QWidgetOrQuick *parent, FrameOptions options)
+{
+    m_isRecycled = false;
+    m_beingDeleted = false;
+    m_options = actualOptions(options);
+    s_dbg_numFrames++;
+    DockRegistry::self()->registerFrame(this);
+
+    QWidgetAdapter::setParent(parent);
+    setLayoutWidget(qobject_cast<LayoutWidget *>(QWidgetAdapter::parentWidget()));
+}
+
 QSize Frame::dockWidgetsMinSize() const
 {
     QSize size = Layouting::Item::hardcodedMinimumSize;
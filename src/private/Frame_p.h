@@ -119,6 +119,14 @@ public:
     void onDockWidgetTitleChanged();
     void updateTitleBarVisibility();
     void updateFloatingActions();
+
+    /// @brief Applies the title, icon and title bar visibility changes deferred by Config::Flag_DeferTitleUpdates
+    /// They are applied on the next event loop pass anyway, this is for when you need them now.
+    void applyPendingUpdates();
+
+    /// @brief Returns whether there are deferred title, icon or title bar visibility changes
+    bool hasPendingUpdates() const;
+
     bool containsMouse(QPoint globalPos) const;
     TitleBar *titleBar() const;
     TitleBar *actualTitleBar() const;
@@ -258,6 +266,12 @@ public:
     ///@brief sets the layout item that either contains this Frame in the layout or is a placeholder
     void setLayoutItem(Layouting::Item *item) override;
 
+    ///@brief Frame::event() tells the layout item about parent changes, no need for an event filter
+    bool notifiesParentChanges() const override
+    {
+        return true;
+    }
+
     /**
      * Returns the drag rect in global coordinates. This is usually the title bar rect.
      * However, when using Config::Flag_HideTitleBarWhenTabsVisible it will be the tab bar background.
@@ -380,20 +394,46 @@ private:
     Q_DISABLE_COPY(Frame)
     friend class ::TestDocks;
     friend class TabWidget;
+    friend class FrameworkWidgetFactory;
 
     void scheduleDeleteLater();
+
+    /// @brief Returns whether this empty Frame can be handed to FrameworkWidgetFactory::recycleFrame()
+    bool canBeRecycled() const;
+
+    /// @brief Detaches the frame from its layout as if it had been deleted, so it can be reused later
+    void prepareForRecycling();
+
+    /// @brief Returns whether this recycled Frame was created with the same @p options a new Frame would have
+    bool canBeReusedWith(FrameOptions options) const;
+
+    /// @brief Counter-part of prepareForRecycling(), the Frame is alive again
+    void reuse(QWidgetOrQuick *parent, FrameOptions options);
     bool event(QEvent *) override;
 
     /// @brief Sets the LayoutWidget which this frame is in
     void setLayoutWidget(LayoutWidget *);
 
+    enum PendingUpdate {
+        PendingUpdate_None = 0,
+        PendingUpdate_TitleAndIcon = 1,
+        PendingUpdate_TitleBarVisibility = 2
+    };
+
+    /// @brief Runs the update now, or if using Config::Flag_DeferTitleUpdates, merges it with the
+    /// pending ones and schedules them for the next event loop pass
+    void scheduleUpdate(PendingUpdate);
+
     LayoutWidget *m_layoutWidget = nullptr;
     WidgetResizeHandler *m_resizeHandler = nullptr;
     FrameOptions m_options = FrameOption_None;
     QPointer<Layouting::Item> m_layoutItem;
     bool m_updatingTitleBar = false;
     bool m_beingDeleted = false;
+    bool m_isRecycled = false;
     int m_userType = 0;
+    int m_pendingUpdates = PendingUpdate_None;
+    QVector<QPointer<DockWidgetBase>> m_pendingTabUpdates; // dock widgets whose tab text and icon need updating
     QMetaObject::Connection m_visibleWidgetCountChangedConnection;
 };
 
@@ -0,0 +1,178 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "IconCache_p.h"
+
+#include <QIconEngine>
+#include <QPainter>
+#include <QtMath>
+
+using namespace KDDockWidgets;
+
+// QCache costs are in KiB, so this is 8MiB worth of pixmaps
+static const int s_maxCost = 8 * 1024;
+
+namespace {
+
+/// Wraps the original icon, so its modes, states and sizes are all kept, but rasterizes through the cache
+class CachedIconEngine : public QIconEngine
+{
+public:
+    explicit CachedIconEngine(const QIcon &icon)
+        : m_icon(icon)
+    {
+    }
+
+    void paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state) override
+    {
+        m_icon.paint(painter, rect, Qt::AlignCenter, mode, state);
+    }
+
+    QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state) override
+    {
+        // QIcon asks its engine for device pixels
+        return IconCache::self()->pixmap(m_icon, size, 1.0, mode, state);
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QPixmap scaledPixmap(const QSize &size, QIcon::Mode mode, QIcon::State state, qreal scale) override
+    {
+        return IconCache::self()->pixmap(m_icon, size, scale, mode, state);
+    }
+#endif
+
+    QSize actualSize(const QSize &size, QIcon::Mode mode, QIcon::State state) override
+    {
+        return m_icon.actualSize(size, mode, state);
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QList<QSize> availableSizes(QIcon::Mode mode, QIcon::State state) override
+#else
+    QList<QSize> availableSizes(QIcon::Mode mode, QIcon::State state) const override
+#endif
+    {
+        return m_icon.availableSizes(mode, state);
+    }
+
+    QString key() const override
+    {
+        return QStringLiteral("KDDockWidgets::CachedIconEngine");
+    }
+
+    QIconEngine *clone() const override
+    {
+        return new CachedIconEngine(m_icon);
+    }
+
+private:
+    const QIcon m_icon;
+};
+
+void clearIconCache()
+{
+    IconCache::self()->clear();
+}
+
+}
+
+IconCache::IconCache()
+    : m_pixmaps(s_maxCost)
+{
+}
+
+IconCache *IconCache::self()
+{
+    static IconCache s_cache;
+    return &s_cache;
+}
+
+QPixmap IconCache::pixmap(const QIcon &icon, QSize size, qreal dpr, QIcon::Mode mode, QIcon::State state)
+{
+    if (icon.isNull() || size.isEmpty())
+        return {};
+
+    const Key key = { icon.cacheKey(), size, dpr, mode, state };
+    if (const QPixmap *pixmap = m_pixmaps.object(key)) {
+        m_stats.hits++;
+        return *pixmap;
+    }
+
+    m_stats.misses++;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QPixmap pixmap = icon.pixmap(size, dpr, mode, state);
+#else
+    // Qt 5 has no per-DPR overload, request device pixels and tag them ourselves.
+    // With AA_UseHighDpiPixmaps Qt 5 scales by the application's DPR, which might be bigger.
+    const QSize deviceSize(qCeil(size.width() * dpr), qCeil(size.height() * dpr));
+    QPixmap pixmap = icon.pixmap(deviceSize, mode, state);
+    if (pixmap.width() > deviceSize.width() || pixmap.height() > deviceSize.height())
+        pixmap = pixmap.scaled(deviceSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    pixmap.setDevicePixelRatio(dpr);
+#endif
+
+    // QCache deletes entries costing more than the whole cache, in which case we just don't cache
+    const int cost = qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / (8 * 1024));
+    if (cost <= m_pixmaps.maxCost()) {
+        clearWithApplication();
+        m_pixmaps.insert(key, new QPixmap(pixmap), cost);
+    }
+
+    return pixmap;
+}
+
+QIcon IconCache::icon(const QIcon &icon)
+{
+    if (icon.isNull())
+        return icon;
+
+    auto it = m_icons.constFind(icon.cacheKey());
+    if (it != m_icons.cend())
+        return *it;
+
+    clearWithApplication();
+    const QIcon cachedIcon(new CachedIconEngine(icon));
+    m_icons.insert(icon.cacheKey(), cachedIcon);
+    return cachedIcon;
+}
+
+void IconCache::clearWithApplication()
+{
+    // Post routines run while the application is being destroyed, even if exec() was never called.
+    // Once per application, tests create several.
+    if (!qApp || m_clearedWith == qApp)
+        return;
+
+    m_clearedWith = qApp;
+    qAddPostRoutine(clearIconCache);
+}
+
+void IconCache::clear()
+{
+    m_pixmaps.clear();
+    m_icons.clear();
+}
+
+int IconCache::count() const
+{
+    return m_pixmaps.count();
+}
+
+IconCache::Stats IconCache::stats() const
+{
+    return m_stats;
+}
+
+void IconCache::resetStats()
+{
+    m_stats = {};
+}
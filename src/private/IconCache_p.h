@@ -0,0 +1,104 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_ICON_CACHE_P_H
+#define KD_ICON_CACHE_P_H
+
+#include "kddockwidgets/docks_export.h"
+#include "kddockwidgets/Qt5Qt6Compat_p.h"
+
+#include <QCache>
+#include <QCoreApplication>
+#include <QHash>
+#include <QIcon>
+#include <QPixmap>
+#include <QPointer>
+#include <QSize>
+
+namespace KDDockWidgets {
+
+/**
+ * @brief A process-wide cache of rasterized icons, keyed by (QIcon::cacheKey(), size, DPR, mode, state).
+ *
+ * Title bars and tab bars showing the same dock widget icon share a single pixmap instead of
+ * each one rasterizing it. Matters when restoring layouts with many dock widgets, or when moving
+ * windows between screens with different device pixel ratios.
+ *
+ * Cleared when the application object is destroyed, pixmaps can't outlive the QGuiApplication.
+ */
+class DOCKS_EXPORT IconCache
+{
+public:
+    struct Stats
+    {
+        int hits = 0; ///< served from the cache
+        int misses = 0; ///< had to rasterize the icon
+    };
+
+    static IconCache *self();
+
+    /// @brief Returns @p icon rasterized at @p size logical pixels for a screen with @p dpr
+    /// The returned pixmap has its device pixel ratio set. Returns a null pixmap for null icons.
+    QPixmap pixmap(const QIcon &icon, QSize size, qreal dpr, QIcon::Mode mode = QIcon::Normal,
+                   QIcon::State state = QIcon::Off);
+
+    /// @brief Returns a QIcon which rasterizes @p icon through this cache
+    /// It keeps all the modes, states and high-DPI variants of @p icon. Since the same QIcon instance
+    /// is returned for the same @p icon, widgets which cache by QIcon::cacheKey() (like QStyle) also
+    /// share their work.
+    QIcon icon(const QIcon &icon);
+
+    /// @brief Removes all cached pixmaps and icons
+    void clear();
+
+    /// @brief Returns the number of cached pixmaps
+    int count() const;
+
+    /// @brief Returns the hit/miss counters
+    Stats stats() const;
+    void resetStats();
+
+private:
+    IconCache();
+    Q_DISABLE_COPY(IconCache)
+
+    struct Key
+    {
+        qint64 cacheKey;
+        QSize size;
+        qreal dpr;
+        QIcon::Mode mode;
+        QIcon::State state;
+
+        bool operator==(const Key &other) const
+        {
+            return cacheKey == other.cacheKey && size == other.size && dpr == other.dpr
+                && mode == other.mode && state == other.state;
+        }
+
+        friend Qt5Qt6Compat::qhashtype qHash(const Key &key, Qt5Qt6Compat::qhashtype seed = 0)
+        {
+            return ::qHash(key.cacheKey, seed) ^ ::qHash(key.size.width(), seed)
+                ^ ::qHash(key.size.height() << 16, seed) ^ ::qHash(key.dpr, seed)
+                ^ ::qHash((int(key.mode) << 1) | int(key.state), seed);
+        }
+    };
+
+    void clearWithApplication();
+    QCache<Key, QPixmap> m_pixmaps;
+    QHash<qint64, QIcon> m_icons; ///< by the wrapped icon's cacheKey
+    Stats m_stats;
+    QPointer<QCoreApplication> m_clearedWith; ///< the application whose destruction clears us
+};
+
+}
+
+#endif
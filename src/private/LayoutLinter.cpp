@@ -0,0 +1,420 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "LayoutLinter_p.h"
+#include "DockRegistry_p.h"
+#include "FloatingWindow_p.h"
+#include "LayoutSaver_p.h"
+#include "LayoutWidget_p.h"
+#include "MainWindowBase.h"
+#include "MultiSplitter_p.h"
+#include "multisplitter/Item_p.h"
+#include "multisplitter/ItemFreeContainer_p.h"
+#include "multisplitter/Widget_null.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QSet>
+
+#include <atomic>
+#include <memory>
+
+using namespace KDDockWidgets;
+
+namespace {
+
+/// The Item tree of a main window or floating window, copied out of the LayoutSaver::Layout
+struct ItemTree
+{
+    QString name;
+    bool isMDI = false;
+    QVariantMap layout;
+    QStringList frameIds;
+};
+
+}
+
+static QMutex s_messageHandlerMutex;
+static int s_numMessageCaptures = 0;
+static std::atomic<QtMessageHandler> s_previousMessageHandler { nullptr };
+static thread_local QStringList *s_capturedMessages = nullptr;
+
+static void captureMessage(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (!s_capturedMessages || type == QtFatalMsg) {
+        if (QtMessageHandler previous = s_previousMessageHandler)
+            previous(type, context, message);
+        return;
+    }
+
+    // Item::dumpLayout() goes to qDebug(), only the warnings say what's wrong
+    if (type != QtDebugMsg && type != QtInfoMsg)
+        s_capturedMessages->push_back(message);
+}
+
+/// Collects the warnings emitted by the current thread while in scope, instead of printing them
+/// Our message handler is only installed while at least one thread is capturing. Other threads'
+/// messages go to the handler we replaced, which is restored once the last capture ends.
+class MessageCapture
+{
+public:
+    explicit MessageCapture(QStringList &messages)
+    {
+        {
+            QMutexLocker locker(&s_messageHandlerMutex);
+            if (s_numMessageCaptures++ == 0) {
+                // Store the previous handler before ours can run, so other threads' messages aren't
+                // dropped. In between, they go to Qt's default handler.
+                s_previousMessageHandler = qInstallMessageHandler(nullptr);
+                qInstallMessageHandler(captureMessage);
+            }
+        }
+
+        s_capturedMessages = &messages;
+    }
+
+    ~MessageCapture()
+    {
+        s_capturedMessages = nullptr;
+
+        QMutexLocker locker(&s_messageHandlerMutex);
+        if (--s_numMessageCaptures == 0) {
+            // Unless the application installed its own handler in the meantime, which we keep
+            const QtMessageHandler current = qInstallMessageHandler(s_previousMessageHandler);
+            if (current != captureMessage)
+                qInstallMessageHandler(current);
+
+            // Not reset, a thread might still be in captureMessage()
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(MessageCapture)
+};
+
+static void collectGuestIds(const QVariantMap &itemMap, QStringList &ids)
+{
+    const QString guestId = itemMap.value(QStringLiteral("guestId")).toString();
+    if (!guestId.isEmpty())
+        ids.push_back(guestId);
+
+    const QVariantList childrenV = itemMap.value(QStringLiteral("children")).toList();
+    for (const QVariant &childV : childrenV)
+        collectGuestIds(childV.toMap(), ids);
+}
+
+static bool checkLayout(const QVariantMap &map, QVector<ItemTree> &trees, QStringList &errors,
+                        qint64 &nsecs)
+{
+    // LayoutSaver::DockWidget instances live in a global registry and the Layout constructor
+    // registers itself as the layout being restored, so only one thread at a time gets here
+    static QMutex s_mutex;
+    QMutexLocker locker(&s_mutex);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    LayoutSaver::Layout layout;
+    layout.fromVariantMap(map);
+    bool valid = layout.isValid();
+    if (!valid)
+        errors.push_back(QStringLiteral("Invalid LayoutSaver::Layout"));
+
+    auto addTree = [&trees, &errors, &valid](const QString &name, const LayoutSaver::MultiSplitter &multiSplitter, bool isMDI) {
+        ItemTree tree;
+        tree.name = name;
+        tree.isMDI = isMDI;
+        tree.layout = multiSplitter.layout;
+        for (auto it = multiSplitter.frames.cbegin(), end = multiSplitter.frames.cend(); it != end; ++it) {
+            if (!it->isValid()) {
+                errors.push_back(QStringLiteral("%1: invalid frame %2").arg(name, it.key()));
+                valid = false;
+            }
+            tree.frameIds.push_back(it.key());
+        }
+        trees.push_back(tree);
+    };
+
+    if (valid) {
+        for (const LayoutSaver::MainWindow &mw : qAsConst(layout.mainWindows))
+            addTree(QStringLiteral("main window %1").arg(mw.uniqueName), mw.multiSplitterLayout,
+                    mw.options.testFlag(MainWindowOption_MDI));
+
+        for (int i = 0; i < layout.floatingWindows.size(); ++i)
+            addTree(QStringLiteral("floating window %1").arg(i), layout.floatingWindows.at(i).multiSplitterLayout, false);
+    }
+
+    nsecs = timer.nsecsElapsed();
+    return valid;
+}
+
+static bool checkItemTree(const ItemTree &tree, QStringList &errors)
+{
+    // Each saved frame is restored into exactly one item
+    QStringList guestIds;
+    collectGuestIds(tree.layout, guestIds);
+    bool valid = true;
+    QSet<QString> referencedIds;
+    for (const QString &id : qAsConst(guestIds)) {
+        if (!tree.frameIds.contains(id)) {
+            errors.push_back(QStringLiteral("%1: item references frame %2, which wasn't saved").arg(tree.name, id));
+            valid = false;
+        } else if (referencedIds.contains(id)) {
+            errors.push_back(QStringLiteral("%1: frame %2 is referenced by more than one item").arg(tree.name, id));
+            valid = false;
+        }
+        referencedIds.insert(id);
+    }
+
+    for (const QString &id : tree.frameIds) {
+        if (!referencedIds.contains(id)) {
+            errors.push_back(QStringLiteral("%1: frame %2 isn't in the layout").arg(tree.name, id));
+            valid = false;
+        }
+    }
+
+    if (!valid)
+        return false;
+
+    // Null guests are children of the host, so they're deleted after the items
+    Layouting::Widget_null host;
+    QHash<QString, Layouting::Widget *> guests;
+    for (const QString &id : tree.frameIds)
+        guests.insert(id, new Layouting::Widget_null(&host));
+
+    std::unique_ptr<Layouting::ItemContainer> root;
+    if (tree.isMDI) {
+        root.reset(new Layouting::ItemFreeContainer(&host));
+    } else {
+        root.reset(new Layouting::ItemBoxContainer(&host));
+    }
+
+    root->fillFromVariantMap(tree.layout, guests);
+
+    // Like LayoutWidget::deserialize(), as the window might be smaller than what the layout needs
+    root->setSize_recursive(root->size().expandedTo(root->minSize()));
+
+    if (!root->checkSanity()) {
+        errors.push_back(QStringLiteral("%1: layout items aren't consistent").arg(tree.name));
+        return false;
+    }
+
+    return true;
+}
+
+QVariantMap LayoutLinter::Result::toVariantMap() const
+{
+    QVariantMap map;
+    map.insert(QStringLiteral("file"), filename);
+    map.insert(QStringLiteral("success"), success);
+    map.insert(QStringLiteral("errors"), errors);
+    map.insert(QStringLiteral("layouts"), numLayouts);
+    map.insert(QStringLiteral("parseMs"), parseNSecs / 1000000.0);
+    map.insert(QStringLiteral("layoutMs"), layoutNSecs / 1000000.0);
+    map.insert(QStringLiteral("itemsMs"), itemsNSecs / 1000000.0);
+
+    return map;
+}
+
+QVariantMap LayoutLinter::Stats::toVariantMap() const
+{
+    QVariantMap map;
+    map.insert(QStringLiteral("file"), filename);
+    map.insert(QStringLiteral("success"), success);
+    map.insert(QStringLiteral("errors"), errors);
+    map.insert(QStringLiteral("jsonBytes"), jsonBytes);
+    map.insert(QStringLiteral("mainWindows"), numMainWindows);
+    map.insert(QStringLiteral("floatingWindows"), numFloatingWindows);
+    map.insert(QStringLiteral("closedDockWidgets"), numClosedDockWidgets);
+    map.insert(QStringLiteral("frames"), numFrames);
+    map.insert(QStringLiteral("tabs"), numTabs);
+    map.insert(QStringLiteral("items"), numItems);
+    map.insert(QStringLiteral("placeholders"), numPlaceholders);
+    map.insert(QStringLiteral("separators"), numSeparators);
+    map.insert(QStringLiteral("treeDepth"), treeDepth);
+    map.insert(QStringLiteral("parseMs"), parseNSecs / 1000000.0);
+    map.insert(QStringLiteral("restoreMs"), restoreNSecs / 1000000.0);
+    map.insert(QStringLiteral("restoreMainWindowsMs"), mainWindowsNSecs / 1000000.0);
+    map.insert(QStringLiteral("restoreFloatingWindowsMs"), floatingWindowsNSecs / 1000000.0);
+    map.insert(QStringLiteral("restoreClosedDockWidgetsMs"), closedDockWidgetsNSecs / 1000000.0);
+    map.insert(QStringLiteral("restorePlaceholdersMs"), placeholdersNSecs / 1000000.0);
+    map.insert(QStringLiteral("resizeMs"), resizeNSecs / 1000000.0);
+
+    return map;
+}
+
+LayoutLinter::Result LayoutLinter::lintFile(const QString &filename)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        Result result;
+        result.filename = filename;
+        result.errors.push_back(QStringLiteral("Couldn't open file: %1").arg(file.errorString()));
+        return result;
+    }
+
+    const QByteArray jsonData = file.readAll();
+    const qint64 readNSecs = timer.nsecsElapsed();
+
+    Result result = lintJson(jsonData, filename);
+    result.parseNSecs += readNSecs;
+    return result;
+}
+
+LayoutLinter::Result LayoutLinter::lintJson(const QByteArray &jsonData, const QString &name)
+{
+    Result result;
+    result.filename = name;
+    MessageCapture capture(result.errors);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(jsonData, &error);
+    if (error.error != QJsonParseError::NoError) {
+        result.parseNSecs = timer.nsecsElapsed();
+        result.errors.push_back(QStringLiteral("Invalid JSON at offset %1: %2").arg(error.offset).arg(error.errorString()));
+        return result;
+    }
+
+    const QVariantMap map = doc.toVariant().toMap();
+    result.parseNSecs = timer.nsecsElapsed();
+
+    QVector<ItemTree> trees;
+    if (!checkLayout(map, trees, result.errors, result.layoutNSecs))
+        return result;
+
+    timer.restart();
+    bool valid = true;
+    for (const ItemTree &tree : qAsConst(trees))
+        valid = checkItemTree(tree, result.errors) && valid;
+
+    result.itemsNSecs = timer.nsecsElapsed();
+    result.numLayouts = trees.size();
+    result.success = valid;
+
+    return result;
+}
+
+LayoutLinter::Stats LayoutLinter::stats(const QString &filename)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        Stats stats;
+        stats.filename = filename;
+        stats.errors.push_back(QStringLiteral("Couldn't open file: %1").arg(file.errorString()));
+        return stats;
+    }
+
+    const QByteArray jsonData = file.readAll();
+    const qint64 readNSecs = timer.nsecsElapsed();
+
+    Stats stats = statsForJson(jsonData, filename);
+    stats.parseNSecs += readNSecs;
+    return stats;
+}
+
+LayoutLinter::Stats LayoutLinter::statsForJson(const QByteArray &jsonData, const QString &name)
+{
+    Stats stats;
+    stats.filename = name;
+    stats.jsonBytes = jsonData.size();
+    MessageCapture capture(stats.errors);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    LayoutSaver::Layout layout;
+    if (!layout.fromJson(jsonData)) {
+        stats.errors.push_back(QStringLiteral("Invalid JSON"));
+        return stats;
+    }
+
+    stats.parseNSecs = timer.nsecsElapsed();
+
+    stats.numMainWindows = layout.mainWindows.size();
+    stats.numFloatingWindows = layout.floatingWindows.size();
+    stats.numClosedDockWidgets = layout.closedDockWidgets.size();
+    auto countFrames = [&stats](const LayoutSaver::MultiSplitter &multiSplitter) {
+        stats.numFrames += multiSplitter.frames.size();
+        for (const LayoutSaver::Frame &frame : multiSplitter.frames)
+            stats.numTabs += frame.dockWidgets.size();
+    };
+
+    for (const LayoutSaver::MainWindow &mw : qAsConst(layout.mainWindows))
+        countFrames(mw.multiSplitterLayout);
+    for (const LayoutSaver::FloatingWindow &fw : qAsConst(layout.floatingWindows))
+        countFrames(fw.multiSplitterLayout);
+
+    // Same as LayoutSaver::restoreLayout(), minus the parsing we already did
+    LayoutSaver saver;
+    LayoutSaver::Private *saverPrivate = saver.dptr();
+    saverPrivate->clearRestoredProperty();
+
+    timer.restart();
+    stats.success = saverPrivate->restoreLayout(layout);
+    stats.restoreNSecs = timer.nsecsElapsed();
+
+    const LayoutSaver::Private::RestoreTimings &timings = saverPrivate->m_restoreTimings;
+    stats.mainWindowsNSecs = timings.mainWindowsNSecs;
+    stats.floatingWindowsNSecs = timings.floatingWindowsNSecs;
+    stats.closedDockWidgetsNSecs = timings.closedDockWidgetsNSecs;
+    stats.placeholdersNSecs = timings.placeholdersNSecs;
+
+    if (!stats.success)
+        return stats;
+
+    QVector<LayoutWidget *> layoutWidgets;
+    for (const LayoutSaver::MainWindow &mw : qAsConst(layout.mainWindows)) {
+        if (MainWindowBase *mainWindow = DockRegistry::self()->mainWindowByName(mw.uniqueName))
+            layoutWidgets.push_back(mainWindow->layoutWidget());
+    }
+
+    for (const LayoutSaver::FloatingWindow &fw : qAsConst(layout.floatingWindows)) {
+        // null if skipped due to affinities
+        if (fw.floatingWindowInstance)
+            layoutWidgets.push_back(fw.floatingWindowInstance->layoutWidget());
+    }
+
+    for (LayoutWidget *layoutWidget : qAsConst(layoutWidgets)) {
+        const LayoutWidget::PlaceholderStats placeholderStats = layoutWidget->placeholderStats();
+        stats.numItems += placeholderStats.numItems;
+        stats.numPlaceholders += placeholderStats.numPlaceholders;
+
+        const Layouting::Item::List items = layoutWidget->items();
+        for (Layouting::Item *item : items) {
+            int depth = 0;
+            for (Layouting::ItemContainer *container = item->parentContainer(); container; container = container->parentContainer())
+                depth++;
+            stats.treeDepth = qMax(stats.treeDepth, depth);
+        }
+
+        // MDI layouts don't have separators
+        if (auto multiSplitter = qobject_cast<MultiSplitter *>(layoutWidget))
+            stats.numSeparators += multiSplitter->rootItem()->separators_recursive().size();
+    }
+
+    timer.restart();
+    for (LayoutWidget *layoutWidget : qAsConst(layoutWidgets))
+        layoutWidget->setLayoutSize(layoutWidget->QWidgetAdapter::size() + QSize(1, 1));
+    stats.resizeNSecs = timer.nsecsElapsed();
+
+    return stats;
+}
@@ -0,0 +1,106 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_LAYOUTLINTER_P_H
+#define KD_LAYOUTLINTER_P_H
+
+#include "kddockwidgets/docks_export.h"
+
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+namespace KDDockWidgets {
+
+/**
+ * @brief Validates saved layouts without creating any widget
+ *
+ * A layout is checked at two levels. First as a LayoutSaver::Layout: serialization version,
+ * window and frame geometries, tab indexes. Then the Layouting::Item tree of each main window
+ * and floating window is rebuilt on Layouting::Widget_null hosts, with one null guest per saved
+ * frame, and verified with checkSanity().
+ *
+ * lintFile() and lintJson() can be called from several threads at once. The LayoutSaver::Layout
+ * part is serialized internally, as it goes through LayoutSaver's global state. For the same
+ * reason, don't lint while the application is restoring a layout.
+ *
+ * stats() instead restores the layout with real widgets, to measure how expensive it is.
+ *
+ * Used by kddockwidgets_linter.
+ */
+class DOCKS_EXPORT LayoutLinter
+{
+public:
+    struct Result
+    {
+        QString filename;
+        bool success = false;
+        QStringList errors; ///< Why it failed, including the warnings emitted while validating
+        int numLayouts = 0; ///< Item trees validated, one per main window and floating window
+        qint64 parseNSecs = 0; ///< reading and parsing the JSON
+        qint64 layoutNSecs = 0; ///< LayoutSaver::Layout checks
+        qint64 itemsNSecs = 0; ///< Layouting::Item checks
+
+        ///@brief Returns the result as it appears in the linter's JSON report
+        QVariantMap toVariantMap() const;
+    };
+
+    ///@brief What a saved layout contains and how long it takes to restore, see stats()
+    struct Stats
+    {
+        QString filename;
+        bool success = false; ///< Whether the layout was restored
+        QStringList errors; ///< Warnings emitted while restoring
+        qint64 jsonBytes = 0;
+        int numMainWindows = 0;
+        int numFloatingWindows = 0;
+        int numClosedDockWidgets = 0;
+        int numFrames = 0;
+        int numTabs = 0; ///< dock widgets in frames, summed over all frames
+        int numItems = 0; ///< layout items, placeholders included
+        int numPlaceholders = 0;
+        int numSeparators = 0;
+        int treeDepth = 0; ///< containers above the deepest item, 1 if all items are children of the root
+        qint64 parseNSecs = 0; ///< reading and parsing into a LayoutSaver::Layout, see LayoutSaver::Layout::fromJson()
+        qint64 restoreNSecs = 0; ///< the whole restore, the four steps below included
+        qint64 mainWindowsNSecs = 0;
+        qint64 floatingWindowsNSecs = 0;
+        qint64 closedDockWidgetsNSecs = 0;
+        qint64 placeholdersNSecs = 0;
+        qint64 resizeNSecs = 0; ///< one setSize_recursive() of each restored layout, growing it by 1px
+
+        ///@brief Returns the stats as they appear in the linter's JSON report
+        QVariantMap toVariantMap() const;
+    };
+
+    ///@brief Validates the layout saved in @p filename
+    static Result lintFile(const QString &filename);
+
+    ///@brief Validates the already loaded @p jsonData. @p name is only used to fill Result::filename
+    static Result lintJson(const QByteArray &jsonData, const QString &name = {});
+
+    /**
+     * @brief Restores the layout saved in @p filename with real widgets and measures it
+     *
+     * Unlike lintFile(), this goes through LayoutSaver, so it must be called from the GUI thread
+     * and the dock widget and main window factories need to be set, see Config.
+     * The restored windows are left for the caller to delete.
+     */
+    static Stats stats(const QString &filename);
+
+    ///@brief Like stats(), but for the already loaded @p jsonData. @p name is only used to fill Stats::filename
+    /// Stats::parseNSecs then only covers the parsing.
+    static Stats statsForJson(const QByteArray &jsonData, const QString &name = {});
+};
+
+}
+
+#endif
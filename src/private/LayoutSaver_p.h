@@ -377,6 +377,13 @@ public:
     explicit Private(RestoreOptions options);
 
     bool matchesAffinity(const QStringList &affinities) const;
+
+    /// @brief Fills @p layout with the current state. The JSON-free part of LayoutSaver::serializeLayout()
+    bool serializeLayout(LayoutSaver::Layout &layout) const;
+
+    /// @brief Restores an already parsed layout. The JSON-free part of LayoutSaver::restoreLayout()
+    bool restoreLayout(LayoutSaver::Layout &layout);
+
     void floatWidgetsWhichSkipRestore(const QStringList &mainWindowNames);
     void floatUnknownWidgets(const LayoutSaver::Layout &layout);
 
@@ -390,6 +397,16 @@ public:
     InternalRestoreOptions m_restoreOptions = {};
     QStringList m_affinityNames;
 
+    /// @brief How long each step of the last restoreLayout() took. Reported by kddockwidgets_linter --stats
+    struct RestoreTimings
+    {
+        qint64 mainWindowsNSecs = 0;
+        qint64 floatingWindowsNSecs = 0;
+        qint64 closedDockWidgetsNSecs = 0;
+        qint64 placeholdersNSecs = 0;
+    };
+    RestoreTimings m_restoreTimings;
+
     static bool s_restoreInProgress;
 };
 }
@@ -20,6 +20,11 @@
 #include "Utils_p.h"
 
 #include "multisplitter/Item_p.h"
+#include "multisplitter/ResizeThrottler_p.h"
+
+#include <QTimer>
+
+#include <algorithm>
 
 using namespace KDDockWidgets;
 
@@ -31,6 +36,7 @@ LayoutWidget::LayoutWidget(QWidgetOrQuick *parent)
 
 LayoutWidget::~LayoutWidget()
 {
+    delete m_resizeThrottler;
     if (m_rootItem->hostWidget()->asQObject() == this)
         delete m_rootItem;
     DockRegistry::self()->unregisterLayout(this);
@@ -76,6 +82,8 @@ void LayoutWidget::setRootItem(Layouting::ItemContainer *root)
     m_rootItem = root;
     connect(m_rootItem, &Layouting::ItemContainer::numVisibleItemsChanged, this,
             &MultiSplitter::visibleWidgetCountChanged);
+    connect(m_rootItem, &Layouting::ItemContainer::numVisibleItemsChanged, this,
+            &LayoutWidget::scheduleCompactPlaceholders);
     connect(m_rootItem, &Layouting::ItemContainer::minSizeChanged, this,
             [this] { setMinimumSize(layoutMinimumSize()); });
 }
@@ -100,6 +108,10 @@ void LayoutWidget::setLayoutMinimumSize(QSize sz)
 
 QSize LayoutWidget::size() const
 {
+    // A throttled resize event might still be pending, don't return the size from before it
+    if (m_resizeThrottler && m_resizeThrottler->hasPendingWork())
+        m_resizeThrottler->runPendingWork();
+
     return m_rootItem->size();
 }
 
@@ -113,6 +125,15 @@ bool LayoutWidget::checkSanity() const
     return m_rootItem->checkSanity();
 }
 
+bool LayoutWidget::runSanityCheck() const
+{
+    if (auto root = qobject_cast<Layouting::ItemBoxContainer *>(m_rootItem))
+        return root->runSanityCheck();
+
+    // MDI layouts don't track what changed, they're cheap to check anyway
+    return Config::self().sanityCheckLevel() == Config::SanityCheckLevel_Off || checkSanity();
+}
+
 void LayoutWidget::dumpLayout() const
 {
     m_rootItem->dumpLayout();
@@ -121,7 +142,7 @@ void LayoutWidget::dumpLayout() const
 void LayoutWidget::restorePlaceholder(DockWidgetBase *dw, Layouting::Item *item, int tabIndex)
 {
     if (item->isPlaceholder()) {
-        Frame *newFrame = Config::self().frameworkWidgetFactory()->createFrame(this);
+        Frame *newFrame = Config::self().frameworkWidgetFactory()->acquireFrame(this);
         item->restore(newFrame);
     }
 
@@ -148,6 +169,11 @@ void LayoutWidget::unrefOldPlaceholders(const Frame::List &framesBeingAdded) con
 
 void LayoutWidget::setLayoutSize(QSize size)
 {
+    if (m_resizeThrottler && !m_inResizeEvent) {
+        // An explicit size wins over any pending resize event
+        m_resizeThrottler->cancel();
+    }
+
     if (size != this->size()) {
         m_rootItem->setSize_recursive(size);
         if (!m_inResizeEvent && !LayoutSaver::restoreInProgress())
@@ -185,6 +211,99 @@ int LayoutWidget::placeholderCount() const
     return count() - visibleCount();
 }
 
+LayoutWidget::PlaceholderStats LayoutWidget::placeholderStats() const
+{
+    PlaceholderStats stats;
+    stats.numCompacted = m_numCompactedPlaceholders;
+
+    const Layouting::Item::List items = this->items();
+    stats.numItems = items.size();
+    for (Layouting::Item *item : items) {
+        if (!item->isPlaceholder())
+            continue;
+
+        stats.numPlaceholders++;
+        stats.numPlaceholderRefs += item->refCount();
+        stats.oldestPlaceholderAge = qMax(stats.oldestPlaceholderAge, item->placeholderAge());
+    }
+
+    // Each placeholder is an Item, each reference an ItemRef owned by a std::unique_ptr
+    stats.placeholderBytes = stats.numPlaceholders * qint64(sizeof(Layouting::Item))
+        + stats.numPlaceholderRefs * qint64(sizeof(ItemRef) + sizeof(std::unique_ptr<ItemRef>));
+
+    return stats;
+}
+
+int LayoutWidget::compactPlaceholders(int maxCount, qint64 maxAgeMSecs)
+{
+    struct Placeholder
+    {
+        QPointer<Layouting::Item> item;
+        qint64 age;
+    };
+
+    QVector<Placeholder> placeholders;
+    const Layouting::Item::List items = this->items();
+    for (Layouting::Item *item : items) {
+        if (item->isPlaceholder())
+            placeholders.push_back({ item, item->placeholderAge() });
+    }
+
+    // Oldest first
+    std::sort(placeholders.begin(), placeholders.end(), [](const Placeholder &p1, const Placeholder &p2) {
+        return p1.age > p2.age;
+    });
+
+    const int numOverLimit = maxCount >= 0 ? qMax(0, placeholders.size() - maxCount) : 0;
+    const DockWidgetBase::List dockWidgets = DockRegistry::self()->dockwidgets();
+    int numRemoved = 0;
+
+    for (int i = 0; i < placeholders.size(); ++i) {
+        const Placeholder &placeholder = placeholders.at(i);
+        const bool tooOld = maxAgeMSecs >= 0 && placeholder.age > maxAgeMSecs;
+        if (i >= numOverLimit && !tooOld)
+            continue;
+
+        // The placeholder is only referenced by dock widget positions. Once the last reference
+        // is dropped the item removes itself from the layout.
+        Layouting::Item *item = placeholder.item;
+        for (DockWidgetBase *dw : dockWidgets) {
+            if (!placeholder.item)
+                break;
+            dw->d->lastPosition()->removePlaceholder(item);
+        }
+
+        if (!placeholder.item)
+            numRemoved++;
+    }
+
+    m_numCompactedPlaceholders += numRemoved;
+    return numRemoved;
+}
+
+void LayoutWidget::scheduleCompactPlaceholders()
+{
+    if (m_compactPlaceholdersScheduled)
+        return;
+
+    const int maxCount = Config::self().maxPlaceholdersPerLayout();
+    const int maxAge = Config::self().maxPlaceholderAge();
+    if (maxCount < 0 && maxAge < 0)
+        return;
+
+    // Deferred, as the item which just got hidden might be restored right away
+    m_compactPlaceholdersScheduled = true;
+    QTimer::singleShot(0, this, [this] {
+        m_compactPlaceholdersScheduled = false;
+        if (LayoutSaver::restoreInProgress()) {
+            scheduleCompactPlaceholders();
+            return;
+        }
+
+        compactPlaceholders(Config::self().maxPlaceholdersPerLayout(), Config::self().maxPlaceholderAge());
+    });
+}
+
 Layouting::Item *LayoutWidget::itemForFrame(const Frame *frame) const
 {
     if (!frame)
@@ -277,10 +396,23 @@ void LayoutWidget::onLayoutRequest()
 
 bool LayoutWidget::onResize(QSize newSize)
 {
-    QScopedValueRollback<bool> resizeGuard(m_inResizeEvent, true); // to avoid re-entrancy
-
-    if (!LayoutSaver::restoreInProgress()) {
+    if (LayoutSaver::restoreInProgress()) {
         // don't resize anything while we're restoring the layout
+        return false;
+    }
+
+    if (Layouting::ResizeThrottler::isEnabled()) {
+        // Coalesce the resize events the window manager sends while the user drags the window
+        // border. The deferred run uses the latest size.
+        if (!m_resizeThrottler)
+            m_resizeThrottler = new Layouting::ResizeThrottler(this);
+
+        m_resizeThrottler->request([this, newSize] {
+            QScopedValueRollback<bool> resizeGuard(m_inResizeEvent, true);
+            setLayoutSize(newSize);
+        });
+    } else {
+        QScopedValueRollback<bool> resizeGuard(m_inResizeEvent, true); // to avoid re-entrancy
         setLayoutSize(newSize);
     }
 
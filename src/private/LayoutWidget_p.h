@@ -34,6 +34,7 @@
 namespace Layouting {
 class Item;
 class ItemContainer;
+class ResizeThrottler;
 class Separator;
 class Widget_qwidget;
 }
@@ -109,6 +110,10 @@ public:
     /// @brief Runs some sanity checks. Returns true if everything is OK
     bool checkSanity() const;
 
+    /// @brief Runs the checks selected by Config::sanityCheckLevel()
+    /// Unlike checkSanity(), which always checks the whole layout, this might only check what changed
+    bool runSanityCheck() const;
+
     /// @brief clears the layout
     void clearLayout();
 
@@ -163,6 +168,32 @@ public:
      */
     int placeholderCount() const;
 
+    /// @brief Memory and traversal cost of the placeholders in this layout. @sa placeholderStats()
+    struct PlaceholderStats
+    {
+        int numItems = 0; ///< Items visited by recursive traversals, placeholders included
+        int numPlaceholders = 0; ///< Hidden items remembering where closed dock widgets were
+        int numPlaceholderRefs = 0; ///< How many dock widget positions point to those placeholders
+        qint64 oldestPlaceholderAge = -1; ///< In milliseconds, -1 if there are no placeholders
+        qint64 placeholderBytes = 0; ///< Lower bound of the memory held by placeholders
+        int numCompacted = 0; ///< Placeholders removed by compactPlaceholders() so far
+    };
+
+    /// @brief Returns how many placeholders this layout has and what they cost
+    PlaceholderStats placeholderStats() const;
+
+    /**
+     * @brief Removes placeholder items, so traversing the layout gets cheaper.
+     *
+     * Keeps at most the @p maxCount most recently hidden placeholders and removes the ones which
+     * are older than @p maxAgeMSecs. Pass -1 for no limit.
+     * Closed dock widgets which lose their placeholder will be shown floating.
+     *
+     * Also called automatically, see Config::setMaxPlaceholdersPerLayout() and Config::setMaxPlaceholderAge()
+     * @return the number of removed placeholders
+     */
+    int compactPlaceholders(int maxCount = 0, qint64 maxAgeMSecs = -1);
+
     /**
      * @brief returns the Item that holds @p frame in this layout
      */
@@ -224,7 +255,11 @@ Q_SIGNALS:
     void visibleWidgetCountChanged(int count);
 
 private:
+    void scheduleCompactPlaceholders();
     bool m_inResizeEvent = false;
+    Layouting::ResizeThrottler *m_resizeThrottler = nullptr; // Only with Layouting::Config::liveResizeInterval()
+    bool m_compactPlaceholdersScheduled = false;
+    int m_numCompactedPlaceholders = 0;
     Layouting::ItemContainer *m_rootItem = nullptr;
 };
 
@@ -46,7 +46,7 @@ void MDILayoutWidget::addDockWidget(DockWidgetBase *dw, QPoint localPt, InitialO
     if (frame) {
         newItem->setGuestWidget(frame);
     } else {
-        frame = Config::self().frameworkWidgetFactory()->createFrame(nullptr, FrameOption_None);
+        frame = Config::self().frameworkWidgetFactory()->acquireFrame(nullptr, FrameOption_None);
         frame->addWidget(dw, addingOption);
 
         newItem->setGuestWidget(frame);
@@ -114,3 +114,103 @@ void MDILayoutWidget::resizeDockWidget(Frame *frame, QSize size)
 
     item->setSize(size.expandedTo(frame->minimumSize()));
 }
+
+void MDILayoutWidget::raiseDockWidget(Frame *frame)
+{
+    if (!frame)
+        return;
+
+    if (Layouting::Item *item = mdiItemForFrame(frame)) {
+        const int z = m_rootItem->raiseItem(item);
+#ifdef KDDOCKWIDGETS_QTQUICK
+        frame->setZ(z);
+#else
+        Q_UNUSED(z);
+#endif
+    }
+
+    frame->raise();
+}
+
+void MDILayoutWidget::setDockWidgetZ(Frame *frame, int z)
+{
+    if (!frame)
+        return;
+
+    Layouting::Item *item = mdiItemForFrame(frame);
+    if (!item) {
+        qWarning() << Q_FUNC_INFO << "Frame not found in the layout" << frame;
+        return;
+    }
+
+    m_rootItem->setItemZ(item, z);
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+    frame->setZ(z);
+    // On top of the frames with the same z, like the item
+    frame->raise();
+#else
+    // QWidgets have no z, stack it under whatever frame is now above it
+    Frame *frameAbove = nullptr;
+    for (Layouting::Item *above = m_rootItem->itemAbove(item); above && !frameAbove; above = m_rootItem->itemAbove(above))
+        frameAbove = qobject_cast<Frame *>(above->guestAsQObject());
+
+    if (frameAbove)
+        frame->stackUnder(frameAbove);
+    else
+        frame->raise();
+#endif
+}
+
+int MDILayoutWidget::dockWidgetZ(Frame *frame) const
+{
+    Layouting::Item *item = mdiItemForFrame(frame);
+    return item ? m_rootItem->itemZ(item) : 0;
+}
+
+Frame *MDILayoutWidget::frameAt(QPoint localPos, int margin) const
+{
+    Layouting::Item *item = m_rootItem->itemAt(localPos, margin);
+    return item ? qobject_cast<Frame *>(item->guestAsQObject()) : nullptr;
+}
+
+QVector<Frame *> MDILayoutWidget::framesIntersecting(QRect localRect) const
+{
+    const Layouting::Item::List items = m_rootItem->itemsIntersecting(localRect);
+
+    QVector<Frame *> result;
+    result.reserve(items.size());
+    for (Layouting::Item *item : items) {
+        if (auto frame = qobject_cast<Frame *>(item->guestAsQObject()))
+            result.push_back(frame);
+    }
+
+    return result;
+}
+
+bool MDILayoutWidget::deserialize(const LayoutSaver::MultiSplitter &l)
+{
+    if (!LayoutWidget::deserialize(l))
+        return false;
+
+    // Restore the stacking order of the widgets too
+    const Layouting::Item::List items = m_rootItem->itemsInStackingOrder();
+    for (Layouting::Item *item : items) {
+        if (auto frame = qobject_cast<Frame *>(item->guestAsQObject())) {
+#ifdef KDDOCKWIDGETS_QTQUICK
+            frame->setZ(m_rootItem->itemZ(item));
+#endif
+            frame->raise();
+        }
+    }
+
+    return true;
+}
+
+Layouting::Item *MDILayoutWidget::mdiItemForFrame(Frame *frame) const
+{
+    // Cheaper than itemForFrame(), which searches all items
+    Layouting::Item *item = frame ? frame->layoutItem() : nullptr;
+    return item && item->parentContainer() == m_rootItem ? item : nullptr;
+}
+
@@ -55,7 +55,27 @@ public:
     /// @brief sets the size and position of the dock widget @p f
     void setDockWidgetGeometry(Frame *f, QRect);
 
+    /// @brief Stacks @p f on top of the other frames
+    /// Use this instead of raising the widget directly, so hit-testing knows about the new order
+    void raiseDockWidget(Frame *f);
+
+    /// @brief Sets the z of @p f. @sa DockWidgetBase::setMDIZ()
+    void setDockWidgetZ(Frame *f, int z);
+
+    /// @brief Returns the z of @p f
+    int dockWidgetZ(Frame *f) const;
+
+    /// @brief Returns the topmost frame at @p localPos. nullptr if none
+    /// @param margin if > 0 frames are hit-tested as if they were @p margin pixels bigger on each side
+    Frame *frameAt(QPoint localPos, int margin = 0) const;
+
+    /// @brief Returns the frames intersecting @p localRect, from bottom to top
+    QVector<Frame *> framesIntersecting(QRect localRect) const;
+
+    bool deserialize(const LayoutSaver::MultiSplitter &) override;
+
 private:
+    Layouting::Item *mdiItemForFrame(Frame *f) const;
     Layouting::ItemFreeContainer *const m_rootItem;
 };
 
@@ -34,6 +34,10 @@
 #include "multisplitter/Widget.h"
 #include "multisplitter/Item_p.h"
 
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+#include "multisplitter/SeparatorOverlay_qwidget.h"
+#endif
+
 #include <QScopedValueRollback>
 
 using namespace KDDockWidgets;
@@ -42,6 +46,13 @@ MultiSplitter::MultiSplitter(QWidgetOrQuick *parent)
     : LayoutWidget(parent)
 {
     Q_ASSERT(parent);
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    // Needs to exist before the first separator is created
+    if (Config::self().flags() & Config::Flag_SeparatorOverlay)
+        m_separatorOverlay = new Layouting::SeparatorOverlay(this);
+#endif
+
     setRootItem(new Layouting::ItemBoxContainer(this));
     DockRegistry::self()->registerLayout(this);
 
@@ -140,7 +151,7 @@ void MultiSplitter::addWidget(QWidgetOrQuick *w, Location location,
         newItem->setGuestWidget(frame);
     } else if (dw) {
         newItem = new Layouting::Item(this);
-        frame = Config::self().frameworkWidgetFactory()->createFrame();
+        frame = Config::self().frameworkWidgetFactory()->acquireFrame();
         newItem->setGuestWidget(frame);
         frame->addWidget(dw, option);
     } else if (auto ms = qobject_cast<MultiSplitter *>(w)) {
@@ -213,6 +224,11 @@ void MultiSplitter::setRootItem(Layouting::ItemBoxContainer *root)
 {
     LayoutWidget::setRootItem(root);
     m_rootItem = root;
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    if (m_separatorOverlay)
+        m_separatorOverlay->setRootItem(root);
+#endif
 }
 
 Layouting::ItemBoxContainer *MultiSplitter::rootItem() const
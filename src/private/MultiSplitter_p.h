@@ -29,6 +29,10 @@
 
 class TestDocks;
 
+namespace Layouting {
+class SeparatorOverlay;
+}
+
 namespace KDDockWidgets {
 
 struct WindowBeingDragged;
@@ -118,6 +122,7 @@ private:
     QSize availableSize() const;
 
     Layouting::ItemBoxContainer *m_rootItem = nullptr;
+    Layouting::SeparatorOverlay *m_separatorOverlay = nullptr; // Only with Config::Flag_SeparatorOverlay
 };
 
 }
@@ -22,6 +22,7 @@
 #include "DockWidgetBase_p.h"
 #include "DragController_p.h"
 #include "FloatingWindow_p.h"
+#include "FloatingWindowPool_p.h"
 #include "Frame_p.h"
 #include "FrameworkWidgetFactory.h"
 #include "Logging_p.h"
@@ -235,7 +236,7 @@ std::unique_ptr<WindowBeingDragged> TabWidget::makeWindow()
 
     const QPoint globalPoint = m_thisWidget->mapToGlobal(QPoint(0, 0));
 
-    auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(m_frame);
+    auto floatingWindow = FloatingWindowPool::self()->acquire(m_frame);
     r.moveTopLeft(globalPoint);
     floatingWindow->setSuggestedGeometry(r, SuggestedGeometryHint_GeometryIsFromDocked);
     floatingWindow->show();
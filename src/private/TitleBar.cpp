@@ -12,6 +12,7 @@
 #include "TitleBar_p.h"
 #include "Frame_p.h"
 #include "FloatingWindow_p.h"
+#include "FloatingWindowPool_p.h"
 #include "Logging_p.h"
 #include "WindowBeingDragged_p.h"
 #include "Utils_p.h"
@@ -261,7 +262,7 @@ std::unique_ptr<WindowBeingDragged> TitleBar::makeWindow()
     QRect r = m_frame->QWidgetAdapter::geometry();
     r.moveTopLeft(m_frame->mapToGlobal(QPoint(0, 0)));
 
-    auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(m_frame);
+    auto floatingWindow = FloatingWindowPool::self()->acquire(m_frame);
     floatingWindow->setSuggestedGeometry(r, SuggestedGeometryHint_GeometryIsFromDocked);
     floatingWindow->show();
 
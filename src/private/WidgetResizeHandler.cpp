@@ -18,6 +18,8 @@
 #include "Utils_p.h"
 #include "DockRegistry_p.h"
 #include "MDILayoutWidget_p.h"
+#include "FrameworkWidgetFactory.h"
+#include "multisplitter/ResizeThrottler_p.h"
 
 #include <QEvent>
 #include <QMouseEvent>
@@ -51,6 +53,14 @@ WidgetResizeHandler::WidgetResizeHandler(EventFilterMode filterMode, WindowMode
 
 WidgetResizeHandler::~WidgetResizeHandler()
 {
+    if (m_dispatcher)
+        m_dispatcher->unregisterHandler(this);
+
+    if (m_hasOverrideCursor)
+        qApp->restoreOverrideCursor();
+
+    delete m_rubberBand;
+    delete m_throttler;
 }
 
 void WidgetResizeHandler::setAllowedResizeSides(CursorPositions sides)
@@ -74,6 +84,29 @@ bool WidgetResizeHandler::isResizing() const
     return m_resizingInProgress;
 }
 
+WidgetResizeHandlerDispatcher *WidgetResizeHandler::dispatcher() const
+{
+    return m_dispatcher;
+}
+
+bool WidgetResizeHandler::usesLazyResize() const
+{
+    if (!(Config::self().flags() & Config::Flag_LazyResize))
+        return false;
+
+    if (m_isTopLevelWindowResizer) {
+#ifdef KDDOCKWIDGETS_QTQUICK
+        // The outline would need to be a window of its own, not supported
+        return false;
+#else
+        return true;
+#endif
+    }
+
+    // The side-bar overlay is still resized live
+    return isMDI();
+}
+
 int WidgetResizeHandler::widgetResizeHandlerMargin()
 {
     return 4; // pixels
@@ -110,8 +143,10 @@ bool WidgetResizeHandler::eventFilter(QObject *o, QEvent *e)
             // Not needed to mess with the cursor, it gets set when moving over another window.
             return false;
         }
-    } else if (isMDI()) {
+    } else if (isMDI() && !m_dispatcher) {
         // Case #2: Resizing an embedded MDI "Window"
+        // (When there's a WidgetResizeHandlerDispatcher it already did this work, and only calls us
+        // for events which are ours)
 
         // Each Frame has a WidgetResizeHandler instance.
         // mTarget is the Frame we want to resize.
@@ -161,6 +196,9 @@ bool WidgetResizeHandler::eventFilter(QObject *o, QEvent *e)
         return true;
     }
     case QEvent::MouseButtonRelease: {
+        if (m_resizingInProgress)
+            finishResize();
+
         m_resizingInProgress = false;
         if (isMDI()) {
             Q_EMIT DockRegistry::self()->frameInMDIResizeChanged();
@@ -196,7 +234,12 @@ bool WidgetResizeHandler::eventFilter(QObject *o, QEvent *e)
         }
 
         auto mouseEvent = static_cast<QMouseEvent *>(e);
+        const bool wasResizing = m_resizingInProgress;
         m_resizingInProgress = m_resizingInProgress && (mouseEvent->buttons() & Qt::LeftButton);
+        if (wasResizing && !m_resizingInProgress) {
+            // Someone ate our release event
+            finishResize();
+        }
 
         const bool consumed = mouseMoveEvent(mouseEvent);
         return consumed;
@@ -216,7 +259,27 @@ bool WidgetResizeHandler::mouseMoveEvent(QMouseEvent *e)
         return pos != CursorPosition_Undefined;
     }
 
-    const QRect oldGeometry = KDDockWidgets::globalGeometry(mTarget);
+    if (!usesLazyResize() && Layouting::ResizeThrottler::isEnabled()) {
+        if (!m_throttler)
+            m_throttler = new Layouting::ResizeThrottler(this);
+
+        m_throttler->request([this, globalPos] {
+            resizeTo(globalPos);
+        });
+    } else {
+        resizeTo(globalPos);
+    }
+
+    return true;
+}
+
+void WidgetResizeHandler::resizeTo(QPoint globalPos)
+{
+    // With lazy resize the target keeps its size until the mouse is released, so continue from
+    // where the outline is
+    const bool lazy = usesLazyResize();
+    const QRect oldGeometry = lazy && m_lazyGeometry.isValid() ? m_lazyGeometry
+                                                               : KDDockWidgets::globalGeometry(mTarget);
     QRect newGeometry = oldGeometry;
 
     QRect parentGeometry;
@@ -237,8 +300,8 @@ bool WidgetResizeHandler::mouseMoveEvent(QMouseEvent *e)
         case CursorPosition_BottomLeft: {
             parentGeometry = parentGeometry.adjusted(0, m_resizeGap, 0, 0);
             deltaWidth = oldGeometry.left() - globalPos.x();
-            newWidth = qBound(minWidth, mTarget->width() + deltaWidth, maxWidth);
-            deltaWidth = newWidth - mTarget->width();
+            newWidth = qBound(minWidth, oldGeometry.width() + deltaWidth, maxWidth);
+            deltaWidth = newWidth - oldGeometry.width();
             if (deltaWidth != 0) {
                 newGeometry.setLeft(newGeometry.left() - deltaWidth);
             }
@@ -251,8 +314,8 @@ bool WidgetResizeHandler::mouseMoveEvent(QMouseEvent *e)
         case CursorPosition_BottomRight: {
             parentGeometry = parentGeometry.adjusted(0, 0, -m_resizeGap, 0);
             deltaWidth = globalPos.x() - newGeometry.right();
-            newWidth = qBound(minWidth, mTarget->width() + deltaWidth, maxWidth);
-            deltaWidth = newWidth - mTarget->width();
+            newWidth = qBound(minWidth, oldGeometry.width() + deltaWidth, maxWidth);
+            deltaWidth = newWidth - oldGeometry.width();
             if (deltaWidth != 0) {
                 newGeometry.setRight(oldGeometry.right() + deltaWidth);
             }
@@ -274,8 +337,8 @@ bool WidgetResizeHandler::mouseMoveEvent(QMouseEvent *e)
         case CursorPosition_TopRight: {
             parentGeometry = parentGeometry.adjusted(0, m_resizeGap, 0, 0);
             deltaHeight = oldGeometry.top() - globalPos.y();
-            newHeight = qBound(minHeight, mTarget->height() + deltaHeight, maxHeight);
-            deltaHeight = newHeight - mTarget->height();
+            newHeight = qBound(minHeight, oldGeometry.height() + deltaHeight, maxHeight);
+            deltaHeight = newHeight - oldGeometry.height();
             if (deltaHeight != 0) {
                 newGeometry.setTop(newGeometry.top() - deltaHeight);
             }
@@ -288,8 +351,8 @@ bool WidgetResizeHandler::mouseMoveEvent(QMouseEvent *e)
         case CursorPosition_BottomRight: {
             parentGeometry = parentGeometry.adjusted(0, 0, 0, -m_resizeGap);
             deltaHeight = globalPos.y() - newGeometry.bottom();
-            newHeight = qBound(minHeight, mTarget->height() + deltaHeight, maxHeight);
-            deltaHeight = newHeight - mTarget->height();
+            newHeight = qBound(minHeight, oldGeometry.height() + deltaHeight, maxHeight);
+            deltaHeight = newHeight - oldGeometry.height();
             if (deltaHeight != 0) {
                 newGeometry.setBottom(oldGeometry.bottom() + deltaHeight);
             }
@@ -300,9 +363,17 @@ bool WidgetResizeHandler::mouseMoveEvent(QMouseEvent *e)
         }
     }
 
+    if (lazy) {
+        if (!mTarget->isTopLevel())
+            newGeometry = newGeometry.intersected(parentGeometry);
+
+        setLazyGeometry(newGeometry);
+        return;
+    }
+
     if (newGeometry == mTarget->geometry()) {
         // Nothing to do.
-        return true;
+        return;
     }
 
     if (!mTarget->isTopLevel()) {
@@ -315,7 +386,60 @@ bool WidgetResizeHandler::mouseMoveEvent(QMouseEvent *e)
     }
 
     mTarget->setGeometry(newGeometry);
-    return true;
+}
+
+void WidgetResizeHandler::setLazyGeometry(QRect globalGeometry)
+{
+    if (globalGeometry == m_lazyGeometry)
+        return;
+
+    // Top-level windows grow beyond themselves, so their outline needs to be a window too
+    QWidgetOrQuick *parent = mTarget->isTopLevel() ? nullptr
+                                                   : qobject_cast<QWidgetOrQuick *>(KDDockWidgets::Private::parentWidget(mTarget));
+    if (!mTarget->isTopLevel() && !parent) {
+        qWarning() << Q_FUNC_INFO << "Unexpected null parent";
+        return;
+    }
+
+    if (!m_rubberBand)
+        m_rubberBand = Config::self().frameworkWidgetFactory()->createRubberBand(parent);
+
+    m_lazyGeometry = globalGeometry;
+
+    QRect rubberBandGeometry = globalGeometry;
+    if (parent)
+        rubberBandGeometry.moveTopLeft(parent->mapFromGlobal(globalGeometry.topLeft()));
+
+    m_rubberBand->setGeometry(rubberBandGeometry);
+    m_rubberBand->setVisible(true);
+    m_rubberBand->raise();
+}
+
+void WidgetResizeHandler::finishResize()
+{
+    // Final exact pass with the latest mouse position
+    if (m_throttler)
+        m_throttler->flush();
+
+    applyLazyGeometry();
+}
+
+void WidgetResizeHandler::applyLazyGeometry()
+{
+    if (m_rubberBand)
+        m_rubberBand->setVisible(false);
+
+    QRect newGeometry = m_lazyGeometry;
+    m_lazyGeometry = QRect();
+    if (!newGeometry.isValid() || newGeometry == KDDockWidgets::globalGeometry(mTarget))
+        return;
+
+    if (!mTarget->isTopLevel()) {
+        // Back to local.
+        newGeometry.moveTopLeft(mTarget->mapFromGlobal(newGeometry.topLeft()) + mTarget->pos());
+    }
+
+    mTarget->setGeometry(newGeometry);
 }
 
 #ifdef Q_OS_WIN
@@ -452,7 +576,16 @@ void WidgetResizeHandler::setTarget(QWidgetOrQuick *w)
         mTarget = w;
         mTarget->setMouseTracking(true);
         if (m_usesGlobalEventFilter) {
-            qApp->installEventFilter(this);
+            if (!m_isTopLevelWindowResizer) {
+                // Docked widgets share a single filter with their siblings
+                auto host = qobject_cast<QWidgetOrQuick *>(KDDockWidgets::Private::parentWidget(mTarget));
+                m_dispatcher = WidgetResizeHandlerDispatcher::dispatcherForHost(host, /*create=*/true);
+            }
+
+            if (m_dispatcher)
+                m_dispatcher->registerHandler(this);
+            else
+                qApp->installEventFilter(this);
         } else {
             mTarget->installEventFilter(this);
         }
@@ -506,18 +639,29 @@ void WidgetResizeHandler::updateCursor(CursorPosition m)
 
 void WidgetResizeHandler::setMouseCursor(Qt::CursorShape cursor)
 {
-    if (m_usesGlobalEventFilter)
-        qApp->setOverrideCursor(cursor);
-    else
+    if (m_usesGlobalEventFilter) {
+        // Keep at most one entry in the override cursor stack, as this is called on every mouse move
+        if (m_hasOverrideCursor) {
+            qApp->changeOverrideCursor(cursor);
+        } else {
+            qApp->setOverrideCursor(cursor);
+            m_hasOverrideCursor = true;
+        }
+    } else {
         mTarget->setCursor(cursor);
+    }
 }
 
 void WidgetResizeHandler::restoreMouseCursor()
 {
-    if (m_usesGlobalEventFilter)
-        qApp->restoreOverrideCursor();
-    else
+    if (m_usesGlobalEventFilter) {
+        if (m_hasOverrideCursor) {
+            qApp->restoreOverrideCursor();
+            m_hasOverrideCursor = false;
+        }
+    } else {
         mTarget->setCursor(Qt::ArrowCursor);
+    }
 }
 
 CursorPosition WidgetResizeHandler::cursorPosition(QPoint globalPos) const
@@ -529,7 +673,7 @@ CursorPosition WidgetResizeHandler::cursorPosition(QPoint globalPos) const
     if (isMDI()) {
         // Special case for QtQuick. The MouseAreas are driving it and know better what's the
         // cursor position
-        return CursorPosition(mTarget->property("cursorPosition").toInt());
+        return mTarget->redirectedCursorPosition();
     }
 #endif
 
@@ -561,6 +705,173 @@ CursorPosition WidgetResizeHandler::cursorPosition(QPoint globalPos) const
     return static_cast<CursorPosition>(result);
 }
 
+WidgetResizeHandlerDispatcher::WidgetResizeHandlerDispatcher(QWidgetOrQuick *host)
+    : QObject(host)
+    , m_host(host)
+{
+    setObjectName(QStringLiteral("WidgetResizeHandlerDispatcher"));
+}
+
+WidgetResizeHandlerDispatcher::~WidgetResizeHandlerDispatcher()
+{
+    if (!m_handlers.isEmpty())
+        qApp->removeEventFilter(this);
+}
+
+/** static */
+WidgetResizeHandlerDispatcher *WidgetResizeHandlerDispatcher::dispatcherForHost(QWidgetOrQuick *host, bool create)
+{
+    if (!host)
+        return nullptr;
+
+    auto dispatcher = host->findChild<WidgetResizeHandlerDispatcher *>(QString(), Qt::FindDirectChildrenOnly);
+    if (!dispatcher && create)
+        dispatcher = new WidgetResizeHandlerDispatcher(host);
+
+    return dispatcher;
+}
+
+int WidgetResizeHandlerDispatcher::handlerCount() const
+{
+    return m_handlers.size();
+}
+
+WidgetResizeHandler *WidgetResizeHandlerDispatcher::handlerAt(QPoint localPos) const
+{
+    if (auto layout = qobject_cast<MDILayoutWidget *>(m_host)) {
+        // The MDI layout has a spatial index of its frames already
+        Frame *frame = layout->frameAt(localPos, WidgetResizeHandler::widgetResizeHandlerMargin());
+        return frame ? m_handlers.value(frame) : nullptr;
+    }
+
+    if (m_edgesDirty)
+        rebuildEdgeMap();
+
+    // Last one is on top
+    for (auto it = m_edges.crbegin(), end = m_edges.crend(); it != end; ++it) {
+        if (it->rect.contains(localPos))
+            return it->handler;
+    }
+
+    return nullptr;
+}
+
+void WidgetResizeHandlerDispatcher::registerHandler(WidgetResizeHandler *handler)
+{
+    // Only filter while there's someone to route to
+    if (m_handlers.isEmpty())
+        qApp->installEventFilter(this);
+
+    m_handlers.insert(handler->mTarget, handler);
+    m_edgesDirty = true;
+}
+
+void WidgetResizeHandlerDispatcher::unregisterHandler(WidgetResizeHandler *handler)
+{
+    auto it = m_handlers.find(handler->mTarget);
+    if (it == m_handlers.end() || it.value() != handler)
+        return;
+
+    m_handlers.erase(it);
+    m_edgesDirty = true;
+
+    // The QPointer is only cleared by ~QObject, which didn't run yet
+    if (m_lastHandler == handler)
+        m_lastHandler = nullptr;
+
+    if (m_handlers.isEmpty())
+        qApp->removeEventFilter(this);
+}
+
+bool WidgetResizeHandlerDispatcher::eventFilter(QObject *o, QEvent *e)
+{
+    switch (e->type()) {
+    case QEvent::Move:
+    case QEvent::Resize:
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::ZOrderChange:
+        if (m_handlers.contains(o))
+            m_edgesDirty = true;
+        return false;
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseMove:
+        break;
+    default:
+        return false;
+    }
+
+    if (WidgetResizeHandler::s_disableAllHandlers)
+        return false;
+
+    auto receiver = qobject_cast<QWidgetOrQuick *>(o);
+    if (!receiver)
+        return false;
+
+    const QPoint globalPos = Qt5Qt6Compat::eventGlobalPos(static_cast<QMouseEvent *>(e));
+    WidgetResizeHandler *handler = handlerForReceiver(receiver, globalPos);
+
+    if (m_lastHandler && m_lastHandler != handler) {
+        // The cursor left the previous handler's margin, it won't see any more events, so reset its cursor
+        m_lastHandler->updateCursor(CursorPosition_Undefined);
+    }
+
+    m_lastHandler = handler;
+    return handler && handler->eventFilter(o, e);
+}
+
+WidgetResizeHandler *WidgetResizeHandlerDispatcher::handlerForReceiver(QWidgetOrQuick *receiver, QPoint globalPos) const
+{
+    // A resize in progress gets everything until the mouse is released. It's necessarily the handler
+    // which got the press.
+    if (m_lastHandler && m_lastHandler->isResizing())
+        return m_lastHandler;
+
+    if (receiver->window() != m_host->window())
+        return nullptr;
+
+    // The cursor is over one of our frames, only that one can be resized, even if its margin
+    // overlaps with a sibling's margin
+    auto frame = firstParentOfType<Frame>(receiver);
+    if (frame && frame->isMDIWrapper()) {
+        // We don't care about the inner Option_MDINestable helper frame
+        frame = frame->mdiFrame();
+    }
+
+    if (frame) {
+        auto it = m_handlers.constFind(frame);
+        if (it != m_handlers.cend())
+            return it.value();
+    }
+
+    // Otherwise it's over the layout, between frames, or over a non-MDI frame. Use the margins.
+    return handlerAt(m_host->mapFromGlobal(globalPos));
+}
+
+void WidgetResizeHandlerDispatcher::rebuildEdgeMap() const
+{
+    m_edges.clear();
+    m_edges.reserve(m_handlers.size());
+
+    const int margin = WidgetResizeHandler::widgetResizeHandlerMargin();
+    const QMargins margins(margin, margin, margin, margin);
+
+    // Children are in stacking order
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    const QObjectList children = m_host->children();
+#else
+    const QList<QQuickItem *> children = m_host->childItems();
+#endif
+    for (auto child : children) {
+        WidgetResizeHandler *handler = m_handlers.value(child);
+        if (handler && handler->mTarget->isVisible())
+            m_edges.push_back({ handler->mTarget->geometry().marginsAdded(margins), handler });
+    }
+
+    m_edgesDirty = false;
+}
+
 /** static */
 void WidgetResizeHandler::setupWindow(QWindow *window)
 {
@@ -21,16 +21,22 @@
 #include <QPoint>
 #include <QPointer>
 #include <QDebug>
+#include <QHash>
+#include <QVector>
 #include <QAbstractNativeEventFilter>
 
 QT_BEGIN_NAMESPACE
 class QMouseEvent;
 QT_END_NAMESPACE
 
+namespace Layouting {
+class ResizeThrottler;
+}
+
 namespace KDDockWidgets {
 
 class FloatingWindow;
-
+class WidgetResizeHandlerDispatcher;
 
 class DOCKS_EXPORT WidgetResizeHandler : public QObject
 {
@@ -138,6 +144,10 @@ public:
 
     bool isResizing() const;
 
+    ///@brief Returns whether only an outline is shown while resizing, see Config::Flag_LazyResize
+    /// The actual geometry is set once the mouse is released.
+    bool usesLazyResize() const;
+
     static int widgetResizeHandlerMargin();
 
     static void setupWindow(QWindow *window);
@@ -149,12 +159,22 @@ public:
 #endif
     static bool s_disableAllHandlers;
 
+    ///@brief Returns the dispatcher routing mouse events to this handler, if any
+    /// Handlers of docked widgets (MDI frames, the side-bar overlay) share a dispatcher with their siblings
+    /// instead of installing an application-wide event filter each.
+    WidgetResizeHandlerDispatcher *dispatcher() const;
+
 protected:
     bool eventFilter(QObject *o, QEvent *e) override;
 
 private:
+    friend class WidgetResizeHandlerDispatcher;
     void setTarget(QWidgetOrQuick *w);
     bool mouseMoveEvent(QMouseEvent *e);
+    void resizeTo(QPoint globalPos);
+    void setLazyGeometry(QRect globalGeometry);
+    void applyLazyGeometry();
+    void finishResize();
     void updateCursor(CursorPosition m);
     void setMouseCursor(Qt::CursorShape cursor);
     void restoreMouseCursor();
@@ -167,6 +187,63 @@ private:
     const bool m_isTopLevelWindowResizer;
     int m_resizeGap = 10;
     CursorPositions mAllowedResizeSides = CursorPosition_All;
+    QPointer<QWidgetOrQuick> m_rubberBand;
+    QRect m_lazyGeometry; // global coordinates
+    Layouting::ResizeThrottler *m_throttler = nullptr;
+    QPointer<WidgetResizeHandlerDispatcher> m_dispatcher;
+    bool m_hasOverrideCursor = false;
+};
+
+/**
+ * @brief Routes mouse events to the WidgetResizeHandlers of sibling docked widgets
+ *
+ * Each MDI frame has a resize handler which needs to see mouse events outside of its frame, as the
+ * resize margin extends a few pixels beyond it. Instead of each handler installing an application-wide
+ * event filter, there's a single one per host (the MDILayoutWidget, or the MainWindowBase for the side-bar
+ * overlay), which delivers each event only to the handler under the cursor.
+ *
+ * The handler is found via the frame containing the receiver, or by hit-testing the frames' resize margins.
+ * MDI layouts are hit-tested via MDILayoutWidget::frameAt(), other hosts use a cached map of the frame
+ * edges, in host coordinates and stacking order, which is rebuilt when a frame moves, resizes, shows or hides.
+ */
+class DOCKS_EXPORT WidgetResizeHandlerDispatcher : public QObject
+{
+    Q_OBJECT
+public:
+    ~WidgetResizeHandlerDispatcher() override;
+
+    ///@brief Returns the dispatcher of @p host. Creates it if it doesn't exist yet and @p create is true
+    static WidgetResizeHandlerDispatcher *dispatcherForHost(QWidgetOrQuick *host, bool create = false);
+
+    ///@brief Returns the number of handlers registered
+    int handlerCount() const;
+
+    ///@brief Returns the handler whose resize margin contains @p localPos, in host coordinates. nullptr if none
+    /// If frames overlap, the one stacked on top wins.
+    WidgetResizeHandler *handlerAt(QPoint localPos) const;
+
+protected:
+    bool eventFilter(QObject *o, QEvent *e) override;
+
+private:
+    friend class WidgetResizeHandler;
+    explicit WidgetResizeHandlerDispatcher(QWidgetOrQuick *host);
+    void registerHandler(WidgetResizeHandler *);
+    void unregisterHandler(WidgetResizeHandler *);
+    WidgetResizeHandler *handlerForReceiver(QWidgetOrQuick *receiver, QPoint globalPos) const;
+    void rebuildEdgeMap() const;
+
+    struct Edge
+    {
+        QRect rect; // target geometry plus the resize margin, in host coordinates
+        WidgetResizeHandler *handler;
+    };
+
+    QWidgetOrQuick *const m_host;
+    QHash<QObject *, WidgetResizeHandler *> m_handlers; // keyed by target
+    QPointer<WidgetResizeHandler> m_lastHandler;
+    mutable QVector<Edge> m_edges;
+    mutable bool m_edgesDirty = true;
 };
 
 #if defined(Q_OS_WIN) && defined(KDDOCKWIDGETS_QTWIDGETS)
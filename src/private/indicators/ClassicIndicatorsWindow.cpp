@@ -267,19 +267,56 @@ Indicator::Indicator(ClassicIndicators *classicIndicators, IndicatorWindow *pare
 
 #else
 
-#include <QQmlContext>
+#include <QImage>
+#include <QSGSimpleTextureNode>
+#include <QSGTexture>
+
+namespace {
+
+const DropLocation s_indicatorLocations[] = {
+    DropLocation_OutterLeft, DropLocation_OutterRight, DropLocation_OutterTop, DropLocation_OutterBottom,
+    DropLocation_Left, DropLocation_Center, DropLocation_Right, DropLocation_Top, DropLocation_Bottom
+};
+const int s_numIndicators = int(sizeof(s_indicatorLocations) / sizeof(s_indicatorLocations[0]));
+const qreal s_indicatorSize = 64;
+const qreal s_outterMargin = 10;
+const qreal s_innerMargin = 10;
+
+/// The root node. Owns the textures, so they're deleted in the render thread, together with the nodes
+class IndicatorsNode : public QSGNode
+{
+public:
+    ~IndicatorsNode() override
+    {
+        qDeleteAll(m_textures);
+    }
+
+    QSGTexture *texture(QQuickWindow *window, DropLocation loc, bool active)
+    {
+        const QString name = KDDockWidgets::iconName(loc, active);
+        QSGTexture *&texture = m_textures[name];
+        if (!texture)
+            texture = window->createTextureFromImage(QImage(QStringLiteral(":/img/classic_indicators/%1.png").arg(name)));
+
+        return texture;
+    }
+
+    QSGSimpleTextureNode *m_indicatorNodes[s_numIndicators] = {};
+
+private:
+    QHash<QString, QSGTexture *> m_textures;
+};
+
+}
 
 IndicatorWindow::IndicatorWindow(KDDockWidgets::ClassicIndicators *classicIndicators)
     : QQuickView()
     , m_classicIndicators(classicIndicators)
+    , m_indicatorsItem(new IndicatorsItem(classicIndicators, contentItem()))
 {
     setFlags(flags() | Qt::FramelessWindowHint | Qt::BypassWindowManagerHint | Qt::Tool);
     setColor(Qt::transparent);
 
-    rootContext()->setContextProperty(QStringLiteral("_window"), QVariant::fromValue<QObject *>(this));
-    setSource(QUrl(QStringLiteral("qrc:/kddockwidgets/private/quick/qml/ClassicIndicatorsOverlay.qml")));
-
-
     // Two workarounds for two unrelated bugs:
     if (KDDockWidgets::isOffscreen()) {
         // 1. We need to create the window asap, otherwise, if a drag triggers the indicator window
@@ -302,92 +339,144 @@ IndicatorWindow::IndicatorWindow(KDDockWidgets::ClassicIndicators *classicIndica
 
 DropLocation IndicatorWindow::hover(QPoint pt)
 {
-    QQuickItem *item = indicatorForPos(pt);
-    const DropLocation loc = item ? locationForIndicator(item)
-                                  : DropLocation_None;
+    const DropLocation loc = m_indicatorsItem->indicatorAt(m_indicatorsItem->mapFromGlobal(QPointF(pt)));
     classicIndicators()->setDropLocation(loc);
     return loc;
 }
 
-QQuickItem *IndicatorWindow::indicatorForPos(QPoint pt) const
+void IndicatorWindow::updatePositions()
 {
-    const QVector<QQuickItem *> indicators = indicatorItems();
-    Q_ASSERT(indicators.size() == 9);
-
-    for (QQuickItem *item : indicators) {
-        if (item->isVisible()) {
-            QRect rect(0, 0, int(item->width()), int(item->height()));
-            rect.moveTopLeft(item->mapToGlobal(QPointF(0, 0)).toPoint());
-            if (rect.contains(pt)) {
-                return item;
-            }
-        }
-    }
+    // Not needed to implement, IndicatorsItem calculates the positions when painting
+}
 
-    return nullptr;
+QPoint IndicatorWindow::posForIndicator(KDDockWidgets::DropLocation loc) const
+{
+    return m_indicatorsItem->mapToGlobal(m_indicatorsItem->indicatorRect(loc).center()).toPoint();
 }
 
-void IndicatorWindow::updatePositions()
+ClassicIndicators *IndicatorWindow::classicIndicators() const
 {
-    // Not needed to implement, the Indicators use QML anchors
+    return m_classicIndicators;
 }
 
-QPoint IndicatorWindow::posForIndicator(KDDockWidgets::DropLocation loc) const
+IndicatorsItem *IndicatorWindow::indicatorsItem() const
 {
-    QQuickItem *indicator = IndicatorWindow::indicatorForLocation(loc);
-    return indicator->mapToGlobal(indicator->boundingRect().center()).toPoint();
+    return m_indicatorsItem;
 }
 
-QString IndicatorWindow::iconName(int loc, bool active) const
+void IndicatorWindow::resizeEvent(QResizeEvent *ev)
 {
-    return KDDockWidgets::iconName(DropLocation(loc), active);
+    QQuickView::resizeEvent(ev);
+    m_indicatorsItem->setSize(size());
 }
 
-ClassicIndicators *IndicatorWindow::classicIndicators() const
+IndicatorsItem::IndicatorsItem(ClassicIndicators *classicIndicators, QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_classicIndicators(classicIndicators)
 {
-    return m_classicIndicators;
+    setFlag(QQuickItem::ItemHasContents);
+
+    connect(classicIndicators, &ClassicIndicators::indicatorsVisibleChanged, this, &QQuickItem::update);
+    connect(classicIndicators, &ClassicIndicators::hoveredFrameRectChanged, this, &QQuickItem::update);
+    connect(classicIndicators, &ClassicIndicators::currentDropLocationChanged, this, &QQuickItem::update);
+    connect(this, &QQuickItem::widthChanged, this, &QQuickItem::update);
+    connect(this, &QQuickItem::heightChanged, this, &QQuickItem::update);
 }
 
-QQuickItem *IndicatorWindow::indicatorForLocation(DropLocation loc) const
+QRectF IndicatorsItem::indicatorRect(DropLocation loc) const
 {
-    const QVector<QQuickItem *> indicators = indicatorItems();
-    Q_ASSERT(indicators.size() == 9);
+    QRectF rect(0, 0, s_indicatorSize, s_indicatorSize);
 
-    for (QQuickItem *item : indicators) {
-        if (locationForIndicator(item) == loc)
-            return item;
+    switch (loc) {
+    case DropLocation_OutterLeft:
+        rect.moveTo(s_outterMargin, (height() - s_indicatorSize) / 2);
+        break;
+    case DropLocation_OutterRight:
+        rect.moveTo(width() - s_outterMargin - s_indicatorSize, (height() - s_indicatorSize) / 2);
+        break;
+    case DropLocation_OutterTop:
+        rect.moveTo((width() - s_indicatorSize) / 2, s_outterMargin);
+        break;
+    case DropLocation_OutterBottom:
+        rect.moveTo((width() - s_indicatorSize) / 2, height() - s_outterMargin - s_indicatorSize);
+        break;
+    case DropLocation_Left:
+    case DropLocation_Center:
+    case DropLocation_Right:
+    case DropLocation_Top:
+    case DropLocation_Bottom: {
+        // The inner indicators are around the center of the hovered frame
+        rect.moveCenter(QRectF(m_classicIndicators->hoveredFrameRect()).center());
+        const qreal offset = s_indicatorSize + s_innerMargin;
+        if (loc == DropLocation_Left)
+            rect.translate(-offset, 0);
+        else if (loc == DropLocation_Right)
+            rect.translate(offset, 0);
+        else if (loc == DropLocation_Top)
+            rect.translate(0, -offset);
+        else if (loc == DropLocation_Bottom)
+            rect.translate(0, offset);
+        break;
+    }
+    default:
+        return {};
     }
 
-    qWarning() << Q_FUNC_INFO << "Couldn't find indicator for location" << loc;
-    return nullptr;
+    return rect;
 }
 
-DropLocation IndicatorWindow::locationForIndicator(const QQuickItem *item) const
+DropLocation IndicatorsItem::indicatorAt(QPointF pos) const
 {
-    return DropLocation(item->property("indicatorType").toInt());
+    for (DropLocation loc : s_indicatorLocations) {
+        if (indicatorVisible(loc) && indicatorRect(loc).contains(pos))
+            return loc;
+    }
+
+    return DropLocation_None;
 }
 
-QVector<QQuickItem *> IndicatorWindow::indicatorItems() const
+bool IndicatorsItem::indicatorVisible(DropLocation loc) const
 {
-    QVector<QQuickItem *> indicators;
-    indicators.reserve(9);
-
-    QQuickItem *root = rootObject();
-    const QList<QQuickItem *> items = root->childItems();
-    for (QQuickItem *item : items) {
-        if (QString::fromLatin1(item->metaObject()->className()).startsWith(QLatin1String("ClassicIndicator_QMLTYPE"))) {
-            indicators.push_back(item);
-        } else if (item->objectName() == QLatin1String("innerIndicators")) {
-            const QList<QQuickItem *> innerIndicators = item->childItems();
-            for (QQuickItem *innerItem : innerIndicators) {
-                if (QString::fromLatin1(innerItem->metaObject()->className()).startsWith(QLatin1String("ClassicIndicator_QMLTYPE"))) {
-                    indicators.push_back(innerItem);
-                }
-            }
+    // Don't show if window is too small
+    if (width() <= 50 || height() <= 50)
+        return false;
+
+    return m_classicIndicators->dropIndicatorVisible(loc);
+}
+
+QSGNode *IndicatorsItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto root = static_cast<IndicatorsNode *>(oldNode);
+    if (!root)
+        root = new IndicatorsNode();
+
+    const DropLocation currentLocation = m_classicIndicators->currentDropLocation();
+    for (int i = 0; i < s_numIndicators; ++i) {
+        const DropLocation loc = s_indicatorLocations[i];
+        QSGSimpleTextureNode *&node = root->m_indicatorNodes[i];
+
+        if (!indicatorVisible(loc)) {
+            // An empty rect draws nothing, and the node is ready for when it's shown again
+            if (node)
+                node->setRect(QRectF());
+            continue;
+        }
+
+        QSGTexture *texture = root->texture(window(), loc, loc == currentLocation);
+        if (!texture)
+            continue;
+
+        if (!node) {
+            node = new QSGSimpleTextureNode();
+            node->setFiltering(QSGTexture::Linear);
+            root->appendChildNode(node);
         }
+
+        node->setTexture(texture);
+        node->setRect(indicatorRect(loc));
     }
 
-    return indicators;
+    return root;
 }
 
 #endif // QtQuick
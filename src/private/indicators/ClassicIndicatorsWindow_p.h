@@ -81,10 +81,12 @@ public:
 
 #else
 
+#include <QQuickItem>
 #include <QQuickView>
 
 namespace KDDockWidgets {
 class ClassicIndicators;
+class IndicatorsItem;
 
 class IndicatorWindow : public QQuickView
 {
@@ -95,14 +97,42 @@ public:
     DropLocation hover(QPoint);
     void updatePositions();
     QPoint posForIndicator(DropLocation) const;
-    Q_INVOKABLE QString iconName(int loc, bool active) const;
     KDDockWidgets::ClassicIndicators *classicIndicators() const;
-    QQuickItem *indicatorForLocation(DropLocation loc) const;
+    IndicatorsItem *indicatorsItem() const;
+
+protected:
+    void resizeEvent(QResizeEvent *) override;
+
+private:
+    ClassicIndicators *const m_classicIndicators;
+    IndicatorsItem *const m_indicatorsItem;
+};
+
+/**
+ * @brief Draws the classic drop indicators directly as scene-graph nodes
+ *
+ * Only the textures and rects of the nodes change when the hovered frame or drop location changes,
+ * there's no QML binding to evaluate during drags. Each icon is uploaded once per window.
+ */
+class IndicatorsItem : public QQuickItem
+{
+    Q_OBJECT
+public:
+    explicit IndicatorsItem(ClassicIndicators *, QQuickItem *parent);
+
+    ///@brief Returns the geometry of the indicator for @p loc, in item coordinates
+    QRectF indicatorRect(DropLocation loc) const;
+
+    ///@brief Returns the visible indicator at @p pos, in item coordinates. DropLocation_None if none
+    DropLocation indicatorAt(QPointF pos) const;
+
+    ///@brief Returns whether the indicator for @p loc is currently shown
+    bool indicatorVisible(DropLocation loc) const;
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *, UpdatePaintNodeData *) override;
 
 private:
-    DropLocation locationForIndicator(const QQuickItem *) const;
-    QQuickItem *indicatorForPos(QPoint) const;
-    QVector<QQuickItem *> indicatorItems() const;
     ClassicIndicators *const m_classicIndicators;
 };
 }
@@ -17,10 +17,13 @@
 
 #include <QEvent>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QPointer>
 #include <QScopedValueRollback>
 #include <QTimer>
 #include <QGuiApplication>
 #include <QScreen>
+#include <QThread>
 #include <algorithm>
 
 #ifdef Q_CC_MSVC
@@ -86,6 +89,19 @@ inline QRect adjustedRect(QRect r, Qt::Orientation o, int p1, int p2)
     return r;
 }
 
+/// Milliseconds since the first call. Used to know how old placeholders are.
+static qint64 monotonicMSecs()
+{
+    // Magic static, items can be created outside of the GUI thread (see LayoutLinter)
+    static const QElapsedTimer s_timer = [] {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+
+    return s_timer.elapsed();
+}
+
 namespace Layouting {
 struct LengthOnSide
 {
@@ -187,7 +203,8 @@ void Item::setGuestWidget(Widget *guest)
     if (m_guest) {
         m_guest->setParent(m_hostWidget);
         m_guest->setLayoutItem(this);
-        newWidget->installEventFilter(this);
+        if (!m_guest->notifiesParentChanges())
+            newWidget->installEventFilter(this);
 
         {
             QScopedValueRollback<bool> guard(m_isSettingGuest, true);
@@ -195,7 +212,6 @@ void Item::setGuestWidget(Widget *guest)
             setMaxSizeHint(guest->maxSizeHint());
         }
 
-        connect(newWidget, &QObject::objectNameChanged, this, &Item::updateObjectName);
         connect(newWidget, &QObject::destroyed, this, &Item::onWidgetDestroyed);
         connect(newWidget, SIGNAL(layoutInvalidated()), this, SLOT(onWidgetLayoutRequested()));
 
@@ -209,8 +225,6 @@ void Item::setGuestWidget(Widget *guest)
             updateWidgetGeometries();
         }
     }
-
-    updateObjectName();
 }
 
 void Item::updateWidgetGeometries()
@@ -227,7 +241,7 @@ QVariantMap Item::toVariantMap() const
     result[QStringLiteral("sizingInfo")] = m_sizingInfo.toVariantMap();
     result[QStringLiteral("isVisible")] = m_isVisible;
     result[QStringLiteral("isContainer")] = isContainer();
-    result[QStringLiteral("objectName")] = objectName();
+    result[QStringLiteral("objectName")] = displayName();
     if (m_guest)
         result[QStringLiteral("guestId")] = m_guest->id(); // just for coorelation purposes when restoring
 
@@ -238,7 +252,14 @@ void Item::fillFromVariantMap(const QVariantMap &map, const QHash<QString, Widge
 {
     m_sizingInfo.fromVariantMap(map[QStringLiteral("sizingInfo")].toMap());
     m_isVisible = map[QStringLiteral("isVisible")].toBool();
-    setObjectName(map[QStringLiteral("objectName")].toString());
+
+    // Non-containers compute their name on demand, see displayName()
+    const QString name = map[QStringLiteral("objectName")].toString();
+    if (isContainer() && !name.isEmpty())
+        setObjectName(name);
+
+    if (m_parent)
+        m_parent->invalidateSizeCache();
 
     const QString guestId = map.value(QStringLiteral("guestId")).toString();
     if (!guestId.isEmpty()) {
@@ -279,6 +300,14 @@ int Item::refCount() const
     return m_refCount;
 }
 
+qint64 Item::placeholderAge() const
+{
+    if (m_hiddenSince == -1)
+        return -1;
+
+    return monotonicMSecs() - m_hiddenSince;
+}
+
 Widget *Item::hostWidget() const
 {
     return m_hostWidget;
@@ -369,6 +398,8 @@ bool Item::isBeingInserted() const
 void Item::setBeingInserted(bool is)
 {
     m_sizingInfo.isBeingInserted = is;
+    if (m_parent)
+        m_parent->invalidateSizeCache();
 
     // Trickle up the hierarchy too, as the parent might be hidden due to not having visible children
     if (auto parent = parentContainer()) {
@@ -387,9 +418,9 @@ void Item::setParentContainer(ItemContainer *parent)
         return;
 
     if (m_parent) {
-        disconnect(this, &Item::minSizeChanged, m_parent, &ItemContainer::onChildMinSizeChanged);
-        disconnect(this, &Item::visibleChanged, m_parent, &ItemContainer::onChildVisibleChanged);
+        // Only for external listeners, the old parent isn't notified
         Q_EMIT visibleChanged(this, false);
+        m_parent->invalidateSizeCache();
     }
 
     if (auto c = asContainer()) {
@@ -402,21 +433,25 @@ void Item::setParentContainer(ItemContainer *parent)
     }
 
     m_parent = parent;
+    if (m_parent)
+        m_parent->invalidateSizeCache();
     connectParent(parent); // Reused by the ctor too
 
     QObject::setParent(parent);
+
+    if (Config::self().sanityCheckLevel() == Config::SanityCheckLevel::Incremental) {
+        if (ItemBoxContainer *c = parentBoxContainer())
+            c->markDirtyForSanityCheck();
+    }
 }
 
 void Item::connectParent(ItemContainer *parent)
 {
     if (parent) {
-        connect(this, &Item::minSizeChanged, parent, &ItemContainer::onChildMinSizeChanged);
-        connect(this, &Item::visibleChanged, parent, &ItemContainer::onChildVisibleChanged);
-
         setHostWidget(parent->hostWidget());
         updateWidgetGeometries();
 
-        Q_EMIT visibleChanged(this, isVisible());
+        notifyVisibleChanged(isVisible());
     }
 }
 
@@ -449,7 +484,9 @@ void Item::setMinSize(QSize sz)
 {
     if (sz != m_sizingInfo.minSize) {
         m_sizingInfo.minSize = sz;
-        Q_EMIT minSizeChanged(this);
+        if (m_parent)
+            m_parent->invalidateSizeCache();
+        notifyMinSizeChanged();
         if (!m_isSettingGuest)
             setSize_recursive(size().expandedTo(sz));
     }
@@ -459,6 +496,8 @@ void Item::setMaxSizeHint(QSize sz)
 {
     if (sz != m_sizingInfo.maxSizeHint) {
         m_sizingInfo.maxSizeHint = sz;
+        if (m_parent)
+            m_parent->invalidateSizeCache();
         Q_EMIT maxSizeChanged(this);
     }
 }
@@ -598,15 +637,16 @@ void Item::setIsVisible(bool is)
 {
     if (is != m_isVisible) {
         m_isVisible = is;
-        Q_EMIT visibleChanged(this, is);
+        m_hiddenSince = is ? -1 : monotonicMSecs();
+        if (m_parent)
+            m_parent->invalidateSizeCache();
+        notifyVisibleChanged(is);
     }
 
     if (is && m_guest) {
         m_guest->setGeometry(mapToRoot(rect()));
         m_guest->setVisible(true); // TODO: Only set visible when apply*() ?
     }
-
-    updateObjectName();
 }
 
 void Item::setGeometry_recursive(QRect rect)
@@ -701,21 +741,73 @@ void Item::setGeometry(QRect rect)
                        << ": parent=" << parentContainer();
         }
 
-        Q_EMIT geometryChanged();
+        if (Config::self().sanityCheckLevel() == Config::SanityCheckLevel::Incremental) {
+            if (ItemBoxContainer *c = parentBoxContainer())
+                c->markDirtyForSanityCheck();
+            if (ItemBoxContainer *c = asBoxContainer())
+                c->markDirtyForSanityCheck();
+        }
 
-        if (oldGeo.x() != x())
-            Q_EMIT xChanged();
-        if (oldGeo.y() != y())
-            Q_EMIT yChanged();
-        if (oldGeo.width() != width())
-            Q_EMIT widthChanged();
-        if (oldGeo.height() != height())
-            Q_EMIT heightChanged();
+        if (m_parent)
+            m_parent->onChildGeometryChanged(this, oldGeo);
+
+        // Batching needs the GUI thread's event loop. Items hosted by a Widget_null, for example
+        // while linting a layout on a worker thread, emit right away.
+        const bool batch = (Config::self().flags() & Config::Flag::BatchedGeometryChanges)
+            && qApp && QThread::currentThread() == qApp->thread();
+        if (batch) {
+            scheduleGeometryChanged(oldGeo.topLeft() != rect.topLeft());
+        } else {
+            Q_EMIT geometryChanged(rect);
+
+            if (oldGeo.x() != x())
+                Q_EMIT xChanged();
+            if (oldGeo.y() != y())
+                Q_EMIT yChanged();
+            if (oldGeo.width() != width())
+                Q_EMIT widthChanged();
+            if (oldGeo.height() != height())
+                Q_EMIT heightChanged();
+        }
 
         updateWidgetGeometries();
     }
 }
 
+static QVector<QPointer<Item>> s_pendingGeometryChanges;
+
+void Item::scheduleGeometryChanged(bool moved)
+{
+    if (!m_geometryChangePending) {
+        m_geometryChangePending = true;
+        if (s_pendingGeometryChanges.isEmpty())
+            QTimer::singleShot(0, &Item::flushGeometryChanges);
+        s_pendingGeometryChanges.push_back(this);
+    }
+
+    if (moved) {
+        // Same as the xChanged()/yChanged() forwarding ItemContainer does in the non-batched case
+        if (ItemContainer *container = asContainer()) {
+            for (Item *child : container->childItems())
+                child->scheduleGeometryChanged(true);
+        }
+    }
+}
+
+void Item::flushGeometryChanges()
+{
+    // A relayout may have touched the same item many times, it's only notified once
+    const QVector<QPointer<Item>> items = std::move(s_pendingGeometryChanges);
+    s_pendingGeometryChanges.clear();
+
+    for (Item *item : items) {
+        if (item) {
+            item->m_geometryChangePending = false;
+            Q_EMIT item->geometryChanged(item->geometry());
+        }
+    }
+}
+
 void Item::dumpLayout(int level)
 {
     QString indent;
@@ -723,7 +815,7 @@ void Item::dumpLayout(int level)
 
     auto dbg = qDebug().noquote();
 
-    dbg << indent << "- Widget: " << objectName()
+    dbg << indent << "- Widget: " << displayName()
         << m_sizingInfo.geometry // << "r=" << m_geometry.right() << "b=" << m_geometry.bottom()
         << "; min=" << minSize();
 
@@ -749,6 +841,7 @@ Item::Item(Widget *hostWidget, ItemContainer *parent)
     , m_parent(parent)
     , m_hostWidget(hostWidget)
 {
+    m_hiddenSince = monotonicMSecs(); // Items start hidden
     connectParent(parent);
 }
 
@@ -765,19 +858,25 @@ Item::~Item()
 {
 }
 
-bool Item::eventFilter(QObject *widget, QEvent *e)
+bool Item::eventFilter(QObject *, QEvent *e)
 {
-    if (e->type() != QEvent::ParentChange)
-        return false;
+    if (e->type() == QEvent::ParentChange)
+        onGuestParentChanged();
+
+    return false;
+}
+
+void Item::onGuestParentChanged()
+{
+    if (!m_guest)
+        return;
 
     QObject *host = hostWidget() ? hostWidget()->asQObject() : nullptr;
-    if (widget->parent() != host) {
+    if (m_guest->parent() != host) {
         // Frame was detached into floating window. Turn into placeholder
         Q_ASSERT(isVisible());
         turnIntoPlaceholder();
     }
-
-    return false;
 }
 
 
@@ -791,20 +890,47 @@ void Item::turnIntoPlaceholder()
     parentContainer()->removeItem(this, /*hardDelete=*/false);
 }
 
-void Item::updateObjectName()
+QString Item::displayName() const
 {
     if (isContainer())
-        return;
+        return objectName();
 
     if (auto w = guestAsQObject()) {
-        setObjectName(w->objectName().isEmpty() ? QStringLiteral("widget") : w->objectName());
+        return w->objectName().isEmpty() ? QStringLiteral("widget") : w->objectName();
     } else if (!isVisible()) {
-        setObjectName(QStringLiteral("hidden"));
+        return QStringLiteral("hidden");
     } else if (!m_guest) {
-        setObjectName(QStringLiteral("null"));
+        return QStringLiteral("null");
     } else {
-        setObjectName(QStringLiteral("empty"));
+        return QStringLiteral("empty");
+    }
+}
+
+void Item::notifyMinSizeChanged()
+{
+    // The parent is called directly instead of through a connection, as a connection per item adds up
+    if (m_parent)
+        m_parent->onChildMinSizeChanged(this);
+
+    Q_EMIT minSizeChanged(this);
+}
+
+void Item::notifyVisibleChanged(bool visible)
+{
+    if (m_parent)
+        m_parent->onChildVisibleChanged(this, visible);
+
+    Q_EMIT visibleChanged(this, visible);
+}
+
+void Item::releaseGuest()
+{
+    if (QObject *guest = guestAsQObject()) {
+        guest->removeEventFilter(this);
+        disconnect(guest, nullptr, this, nullptr);
     }
+
+    onWidgetDestroyed();
 }
 
 void Item::onWidgetDestroyed()
@@ -936,6 +1062,9 @@ struct ItemBoxContainer::Private
     void resizeChildren(QSize oldSize, QSize newSize, SizingInfo::List &sizes, ChildrenResizeStrategy);
     void honourMaxSizes(SizingInfo::List &sizes);
     void scheduleCheckSanity() const;
+    bool checkSanity(bool recursive, int &numContainersChecked);
+    void markDirtyForSanityCheck();
+    bool checkDirtyContainers(int &numContainersChecked);
     Separator *neighbourSeparator(const Item *item, Side, Qt::Orientation) const;
     Separator *neighbourSeparator_recursive(const Item *item, Side, Qt::Orientation) const;
     void updateWidgets_recursive();
@@ -949,15 +1078,29 @@ struct ItemBoxContainer::Private
     void deleteSeparators_recursive();
     void updateSeparators_recursive();
     QSize minSize(const Item::List &items) const;
+    QSize computeMaxSizeHint() const;
+    void discardCacheIfThicknessChanged();
     int excessLength() const;
 
-    mutable bool m_checkSanityScheduled = false;
+    mutable bool m_checkSanityScheduled = false; // Only used in the root container
+    bool m_isDirtyForSanityCheck = false;
+    QVector<QPointer<ItemBoxContainer>> m_dirtyContainers; // Only used in the root container
     QVector<Layouting::Separator *> m_separators;
     bool m_convertingItemToContainer = false;
     bool m_blockUpdatePercentages = false;
     bool m_isDeserializing = false;
     bool m_isSimplifying = false;
     Qt::Orientation m_orientation = Qt::Vertical;
+
+    // minSize() and maxSizeHint() are queried many times per resize, so they're cached.
+    // See ItemBoxContainer::invalidateSizeCache()
+    QSize m_cachedMinSize;
+    QSize m_cachedMaxSizeHint;
+    bool m_minSizeDirty = true;
+    bool m_maxSizeHintDirty = true;
+    int m_cachedSeparatorThickness = -1; // Config::setSeparatorThickness() isn't restricted to startup
+    QSize m_lastNotifiedMinSize; // So the parent is only bothered if our min-size actually changed
+
     ItemBoxContainer *const q;
 };
 
@@ -1006,177 +1149,237 @@ int ItemBoxContainer::numSideBySide_recursive(Qt::Orientation o) const
 }
 
 bool ItemBoxContainer::checkSanity()
+{
+    int numContainersChecked = 0;
+    return d->checkSanity(/*recursive=*/true, numContainersChecked);
+}
+
+bool ItemBoxContainer::runSanityCheck()
 {
     d->m_checkSanityScheduled = false;
 
-    if (!hostWidget()) {
+    Config &config = Config::self();
+    const Config::SanityCheckLevel level = config.sanityCheckLevel();
+    if (level == Config::SanityCheckLevel::Off)
+        return true;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int numContainersChecked = 0;
+    const bool result = level == Config::SanityCheckLevel::Incremental ? d->checkDirtyContainers(numContainersChecked)
+                                                                       : d->checkSanity(/*recursive=*/true, numContainersChecked);
+
+    const qint64 elapsed = timer.nsecsElapsed();
+    Config::SanityCheckStats &stats = config.m_sanityCheckStats;
+    stats.numChecks++;
+    stats.numContainersChecked += numContainersChecked;
+    stats.lastCheckNSecs = elapsed;
+    stats.maxCheckNSecs = qMax(stats.maxCheckNSecs, elapsed);
+    stats.totalCheckNSecs += elapsed;
+
+    return result;
+}
+
+bool ItemBoxContainer::Private::checkSanity(bool recursive, int &numContainersChecked)
+{
+    if (q->isRoot())
+        m_checkSanityScheduled = false;
+
+    if (!q->hostWidget()) {
         /// This is a dummy ItemBoxContainer, just return true
         return true;
     }
 
-    if (!Item::checkSanity())
+    numContainersChecked++;
+
+    if (!q->Item::checkSanity())
         return false;
 
-    if (numChildren() == 0 && !isRoot()) {
+    if (q->numChildren() == 0 && !q->isRoot()) {
         qWarning() << Q_FUNC_INFO << "Container is empty. Should be deleted";
         return false;
     }
 
-    if (d->m_orientation != Qt::Vertical && d->m_orientation != Qt::Horizontal) {
-        qWarning() << Q_FUNC_INFO << "Invalid orientation" << d->m_orientation << this;
+    if (m_orientation != Qt::Vertical && m_orientation != Qt::Horizontal) {
+        qWarning() << Q_FUNC_INFO << "Invalid orientation" << m_orientation << q;
+        return false;
+    }
+
+    if (!m_minSizeDirty && m_cachedMinSize != minSize(q->m_children)) {
+        qWarning() << Q_FUNC_INFO << "Stale min-size cache" << m_cachedMinSize << minSize(q->m_children) << q;
+        return false;
+    }
+
+    if (!m_maxSizeHintDirty && m_cachedMaxSizeHint != computeMaxSizeHint()) {
+        qWarning() << Q_FUNC_INFO << "Stale max-size cache" << m_cachedMaxSizeHint << computeMaxSizeHint() << q;
         return false;
     }
 
     // Check that the geometries don't overlap
     int expectedPos = 0;
-    const auto children = childItems();
+    const auto children = q->childItems();
     for (Item *item : children) {
         if (!item->isVisible())
             continue;
-        const int pos = Layouting::pos(item->pos(), d->m_orientation);
+        const int pos = Layouting::pos(item->pos(), m_orientation);
         if (expectedPos != pos) {
-            root()->dumpLayout();
+            q->root()->dumpLayout();
             qWarning() << Q_FUNC_INFO << "Unexpected pos" << pos << "; expected=" << expectedPos
                        << "; for item=" << item
                        << "; isContainer=" << item->isContainer();
             return false;
         }
 
-        expectedPos = pos + Layouting::length(item->size(), d->m_orientation) + separatorThickness;
+        expectedPos = pos + Layouting::length(item->size(), m_orientation) + separatorThickness;
     }
 
-    const int h1 = Layouting::length(size(), oppositeOrientation(d->m_orientation));
+    const int h1 = Layouting::length(q->size(), oppositeOrientation(m_orientation));
     for (Item *item : children) {
-        if (item->parentContainer() != this) {
+        if (item->parentContainer() != q) {
             qWarning() << "Invalid parent container for" << item
-                       << "; is=" << item->parentContainer() << "; expected=" << this;
+                       << "; is=" << item->parentContainer() << "; expected=" << q;
             return false;
         }
 
-        if (item->parent() != this) {
+        if (item->parent() != q) {
             qWarning() << "Invalid QObject parent for" << item
-                       << "; is=" << item->parent() << "; expected=" << this;
+                       << "; is=" << item->parent() << "; expected=" << q;
             return false;
         }
 
         if (item->isVisible()) {
             // Check the children height (if horizontal, and vice-versa)
-            const int h2 = Layouting::length(item->size(), oppositeOrientation(d->m_orientation));
+            const int h2 = Layouting::length(item->size(), oppositeOrientation(m_orientation));
             if (h1 != h2) {
-                root()->dumpLayout();
+                q->root()->dumpLayout();
                 qWarning() << Q_FUNC_INFO << "Invalid size for item." << item
                            << "Container.length=" << h1 << "; item.length=" << h2;
                 return false;
             }
 
-            if (!rect().contains(item->geometry())) {
-                root()->dumpLayout();
+            if (!q->rect().contains(item->geometry())) {
+                q->root()->dumpLayout();
                 qWarning() << Q_FUNC_INFO << "Item geo is out of bounds. item=" << item << "; geo="
-                           << item->geometry() << "; parent.rect=" << rect();
+                           << item->geometry() << "; parent.rect=" << q->rect();
                 return false;
             }
         }
 
-        if (!item->checkSanity())
+        if (ItemBoxContainer *container = item->asBoxContainer()) {
+            // In incremental mode child containers are only checked if they changed too
+            if (recursive && !container->d->checkSanity(recursive, numContainersChecked))
+                return false;
+        } else if (!item->checkSanity()) {
             return false;
+        }
     }
 
-    const Item::List visibleChildren = this->visibleChildren();
-    const bool isEmptyRoot = isRoot() && visibleChildren.isEmpty();
+    const Item::List visibleChildren = q->visibleChildren();
+    const bool isEmptyRoot = q->isRoot() && visibleChildren.isEmpty();
     if (!isEmptyRoot) {
         auto occupied = qMax(0, Item::separatorThickness * (visibleChildren.size() - 1));
         for (Item *item : visibleChildren) {
-            occupied += item->length(d->m_orientation);
+            occupied += item->length(m_orientation);
         }
 
-        if (occupied != length()) {
-            root()->dumpLayout();
+        if (occupied != q->length()) {
+            q->root()->dumpLayout();
             qWarning() << Q_FUNC_INFO << "Unexpected length. Expected=" << occupied
-                       << "; got=" << length() << "; this=" << this;
+                       << "; got=" << q->length() << "; this=" << q;
             return false;
         }
 
-        const QVector<double> percentages = d->childPercentages();
+        const QVector<double> percentages = childPercentages();
         const double totalPercentage = std::accumulate(percentages.begin(), percentages.end(), 0.0);
         const double expectedPercentage = visibleChildren.isEmpty() ? 0.0 : 1.0;
         if (!qFuzzyCompare(totalPercentage, expectedPercentage)) {
-            root()->dumpLayout();
+            q->root()->dumpLayout();
             qWarning() << Q_FUNC_INFO << "Percentages don't add up"
                        << totalPercentage << percentages
-                       << this;
-            const_cast<ItemBoxContainer *>(this)->d->updateSeparators_recursive();
-            qWarning() << Q_FUNC_INFO << d->childPercentages();
+                       << q;
+            updateSeparators_recursive();
+            qWarning() << Q_FUNC_INFO << childPercentages();
             return false;
         }
     }
 
     const auto numVisibleChildren = visibleChildren.size();
-    if (d->m_separators.size() != qMax(0, numVisibleChildren - 1)) {
-        root()->dumpLayout();
-        qWarning() << Q_FUNC_INFO << "Unexpected number of separators" << d->m_separators.size()
+    if (m_separators.size() != qMax(0, numVisibleChildren - 1)) {
+        q->root()->dumpLayout();
+        qWarning() << Q_FUNC_INFO << "Unexpected number of separators" << m_separators.size()
                    << numVisibleChildren;
         return false;
     }
 
-    const QSize expectedSeparatorSize = isVertical() ? QSize(width(), Item::separatorThickness)
-                                                     : QSize(Item::separatorThickness, height());
+    const QSize expectedSeparatorSize = q->isVertical() ? QSize(q->width(), Item::separatorThickness)
+                                                        : QSize(Item::separatorThickness, q->height());
 
-    const int pos2 = Layouting::pos(mapToRoot(QPoint(0, 0)), oppositeOrientation(d->m_orientation));
+    const int pos2 = Layouting::pos(q->mapToRoot(QPoint(0, 0)), oppositeOrientation(m_orientation));
 
-    for (int i = 0; i < d->m_separators.size(); ++i) {
-        Separator *separator = d->m_separators.at(i);
+    for (int i = 0; i < m_separators.size(); ++i) {
+        Separator *separator = m_separators.at(i);
         Item *item = visibleChildren.at(i);
-        const int expectedSeparatorPos = mapToRoot(item->m_sizingInfo.edge(d->m_orientation) + 1, d->m_orientation);
+        const int expectedSeparatorPos = q->mapToRoot(item->m_sizingInfo.edge(m_orientation) + 1, m_orientation);
 
-        if (separator->host() != host()) {
+        if (separator->host() != q->host()) {
             qWarning() << Q_FUNC_INFO << "Invalid host widget for separator"
-                       << separator->host() << host() << this;
+                       << separator->host() << q->host() << q;
             return false;
         }
 
-        if (separator->parentContainer() != this) {
+        if (separator->parentContainer() != q) {
             qWarning() << Q_FUNC_INFO << "Invalid parent container for separator"
-                       << separator->parentContainer() << separator << this;
+                       << separator->parentContainer() << separator << q;
             return false;
         }
 
         if (separator->position() != expectedSeparatorPos) {
-            root()->dumpLayout();
+            q->root()->dumpLayout();
             qWarning() << Q_FUNC_INFO << "Unexpected separator position" << separator->position()
                        << "; expected=" << expectedSeparatorPos
-                       << separator << "; this=" << this;
+                       << separator << "; this=" << q;
             return false;
         }
 
-        Widget *separatorWidget = separator->asWidget();
-        if (separatorWidget->geometry().size() != expectedSeparatorSize) {
-            qWarning() << Q_FUNC_INFO << "Unexpected separator size" << separatorWidget->geometry().size()
+        const QRect separatorGeometry = separator->geometry();
+        if (Widget *separatorWidget = separator->asWidget()) {
+            if (separatorWidget->geometry() != separatorGeometry) {
+                qWarning() << Q_FUNC_INFO << "Separator widget out of sync" << separatorWidget->geometry()
+                           << "; expected=" << separatorGeometry
+                           << separator << "; this=" << q;
+                return false;
+            }
+        }
+
+        if (separatorGeometry.size() != expectedSeparatorSize) {
+            qWarning() << Q_FUNC_INFO << "Unexpected separator size" << separatorGeometry.size()
                        << "; expected=" << expectedSeparatorSize
-                       << separator << "; this=" << this;
+                       << separator << "; this=" << q;
             return false;
         }
 
-        const int separatorPos2 = Layouting::pos(separatorWidget->geometry().topLeft(), oppositeOrientation(d->m_orientation));
-        if (Layouting::pos(separatorWidget->geometry().topLeft(), oppositeOrientation(d->m_orientation)) != pos2) {
-            root()->dumpLayout();
+        const int separatorPos2 = Layouting::pos(separatorGeometry.topLeft(), oppositeOrientation(m_orientation));
+        if (separatorPos2 != pos2) {
+            q->root()->dumpLayout();
             qWarning() << Q_FUNC_INFO << "Unexpected position pos2=" << separatorPos2
                        << "; expected=" << pos2
-                       << separator << "; this=" << this;
+                       << separator << "; this=" << q;
             return false;
         }
 
-        if (separator->host() != host()) {
+        if (separator->host() != q->host()) {
             qWarning() << Q_FUNC_INFO << "Unexpected host widget in separator"
-                       << separator->host() << "; expected=" << host();
+                       << separator->host() << "; expected=" << q->host();
             return false;
         }
 
         // Check that the separator bounds are correct. We can't always honour widget's max-size constraints, so only honour min-size
-        const int separatorMinPos = minPosForSeparator_global(separator, /*honourMax=*/false);
-        const int separatorMaxPos = maxPosForSeparator_global(separator, /*honourMax=*/false);
+        const int separatorMinPos = q->minPosForSeparator_global(separator, /*honourMax=*/false);
+        const int separatorMaxPos = q->maxPosForSeparator_global(separator, /*honourMax=*/false);
         const int separatorPos = separator->position();
         if (separatorPos < separatorMinPos || separatorPos > separatorMaxPos || separatorMinPos < 0 || separatorMaxPos <= 0) {
-            root()->dumpLayout();
+            q->root()->dumpLayout();
             qWarning() << Q_FUNC_INFO << "Invalid bounds for separator, pos="
                        << separatorPos << "; min=" << separatorMinPos
                        << "; max=" << separatorMaxPos
@@ -1187,8 +1390,8 @@ bool ItemBoxContainer::checkSanity()
 
 #ifdef DOCKS_DEVELOPER_MODE
     // Can cause slowdown, so just use it in developer mode.
-    if (isRoot()) {
-        if (!asBoxContainer()->test_suggestedRect())
+    if (recursive && q->isRoot()) {
+        if (!q->test_suggestedRect())
             return false;
     }
 #endif
@@ -1198,10 +1401,54 @@ bool ItemBoxContainer::checkSanity()
 
 void ItemBoxContainer::Private::scheduleCheckSanity() const
 {
-    if (!m_checkSanityScheduled) {
-        m_checkSanityScheduled = true;
-        QTimer::singleShot(0, q->root(), &ItemBoxContainer::checkSanity);
+    if (Config::self().sanityCheckLevel() == Config::SanityCheckLevel::Off)
+        return;
+
+    ItemBoxContainer *root = q->root();
+    if (!root->d->m_checkSanityScheduled) {
+        root->d->m_checkSanityScheduled = true;
+        QTimer::singleShot(0, root, &ItemBoxContainer::runSanityCheck);
+    }
+}
+
+void ItemBoxContainer::Private::markDirtyForSanityCheck()
+{
+    if (m_isDirtyForSanityCheck || Config::self().sanityCheckLevel() != Config::SanityCheckLevel::Incremental)
+        return;
+
+    if (ItemBoxContainer *root = q->root()) {
+        m_isDirtyForSanityCheck = true;
+        root->d->m_dirtyContainers.push_back(q);
+    }
+}
+
+void ItemBoxContainer::markDirtyForSanityCheck()
+{
+    d->markDirtyForSanityCheck();
+}
+
+bool ItemBoxContainer::Private::checkDirtyContainers(int &numContainersChecked)
+{
+    const QVector<QPointer<ItemBoxContainer>> dirtyContainers = std::move(m_dirtyContainers);
+    m_dirtyContainers.clear();
+
+    bool result = true;
+    for (ItemBoxContainer *container : dirtyContainers) {
+        if (!container)
+            continue;
+
+        container->d->m_isDirtyForSanityCheck = false;
+        if (container->root() != q) {
+            // Moved into another layout meanwhile, that one will check it
+            container->d->markDirtyForSanityCheck();
+            continue;
+        }
+
+        if (result && !container->d->checkSanity(/*recursive=*/false, numContainersChecked))
+            result = false;
     }
+
+    return result;
 }
 
 bool ItemBoxContainer::hasOrientation() const
@@ -1230,6 +1477,8 @@ void ItemBoxContainer::removeItem(Item *item, bool hardRemove)
         return;
     }
 
+    d->markDirtyForSanityCheck();
+
     Item *side1Item = visibleNeighbourFor(item, Side1);
     Item *side2Item = visibleNeighbourFor(item, Side2);
 
@@ -1238,6 +1487,7 @@ void ItemBoxContainer::removeItem(Item *item, bool hardRemove)
 
     if (hardRemove) {
         m_children.removeOne(item);
+        invalidateSizeCache();
         delete item;
         if (!isContainer)
             Q_EMIT root()->numItemsChanged();
@@ -1294,6 +1544,7 @@ ItemBoxContainer *ItemBoxContainer::convertChildToContainer(Item *leaf)
 
     insertItem(container, index, DefaultSizeMode::NoDefaultSizeMode);
     m_children.removeOne(leaf);
+    invalidateSizeCache();
     container->setGeometry(leaf->geometry());
     container->insertItem(leaf, Location_OnTop, DefaultSizeMode::NoDefaultSizeMode);
     Q_EMIT itemsChanged();
@@ -1373,6 +1624,7 @@ void ItemBoxContainer::insertItem(Item *item, Location loc,
         container->setGeometry(rect());
         container->setChildren(m_children, d->m_orientation);
         m_children.clear();
+        invalidateSizeCache();
         setOrientation(oppositeOrientation(d->m_orientation));
         insertItem(container, 0, DefaultSizeMode::NoDefaultSizeMode);
 
@@ -1391,9 +1643,14 @@ void ItemBoxContainer::onChildMinSizeChanged(Item *child)
 {
     if (d->m_convertingItemToContainer || d->m_isDeserializing || !child->isVisible()) {
         // Don't bother our parents, we're converting
+        if (ItemBoxContainer *c = child->asBoxContainer()) {
+            // We ignored it, so make sure the child tells us again next time
+            c->d->m_lastNotifiedMinSize = QSize();
+        }
         return;
     }
 
+    d->markDirtyForSanityCheck();
     updateSizeConstraints();
 
     if (child->isBeingInserted())
@@ -1426,20 +1683,27 @@ void ItemBoxContainer::updateSizeConstraints()
     }
 
     // Our min-size changed, notify our parent, and so on until it reaches root()
-    Q_EMIT minSizeChanged(this);
+    // If it didn't change there's nothing for our ancestors to do
+    const QSize newMinSize = minSize();
+    if (newMinSize != d->m_lastNotifiedMinSize) {
+        d->m_lastNotifiedMinSize = newMinSize;
+        notifyMinSizeChanged();
+    }
 }
 
 void ItemBoxContainer::onChildVisibleChanged(Item *, bool visible)
 {
+    d->markDirtyForSanityCheck();
+
     if (d->m_isDeserializing || isInSimplify())
         return;
 
     const int numVisible = numVisibleChildren();
     if (visible && numVisible == 1) {
         // Child became visible and there's only 1 visible child. Meaning there were 0 visible before.
-        Q_EMIT visibleChanged(this, true);
+        notifyVisibleChanged(true);
     } else if (!visible && numVisible == 0) {
-        Q_EMIT visibleChanged(this, false);
+        notifyVisibleChanged(false);
     }
 }
 
@@ -1655,7 +1919,9 @@ void ItemBoxContainer::clear()
         delete item;
     }
     m_children.clear();
+    invalidateSizeCache();
     d->deleteSeparators();
+    d->markDirtyForSanityCheck();
 }
 
 Item *ItemBoxContainer::itemAt(QPoint p) const
@@ -1763,6 +2029,7 @@ int ItemBoxContainer::usableLength() const
 void ItemBoxContainer::setChildren(const List &children, Qt::Orientation o)
 {
     m_children = children;
+    invalidateSizeCache();
     for (Item *item : children)
         item->setParentContainer(this);
 
@@ -1773,6 +2040,7 @@ void ItemBoxContainer::setOrientation(Qt::Orientation o)
 {
     if (o != d->m_orientation) {
         d->m_orientation = o;
+        invalidateSizeCache();
         d->updateSeparators_recursive();
     }
 }
@@ -1808,15 +2076,50 @@ QSize ItemBoxContainer::Private::minSize(const Item::List &items) const
 
 QSize ItemBoxContainer::minSize() const
 {
-    return d->minSize(m_children);
+    d->discardCacheIfThicknessChanged();
+    if (d->m_minSizeDirty) {
+        d->m_cachedMinSize = d->minSize(m_children);
+        d->m_minSizeDirty = false;
+    }
+
+    return d->m_cachedMinSize;
 }
 
 QSize ItemBoxContainer::maxSizeHint() const
 {
-    int maxW = isVertical() ? hardcodedMaximumSize.width() : 0;
-    int maxH = isVertical() ? 0 : hardcodedMaximumSize.height();
+    d->discardCacheIfThicknessChanged();
+    if (d->m_maxSizeHintDirty) {
+        d->m_cachedMaxSizeHint = d->computeMaxSizeHint();
+        d->m_maxSizeHintDirty = false;
+    }
+
+    return d->m_cachedMaxSizeHint;
+}
+
+void ItemBoxContainer::invalidateSizeCache()
+{
+    d->m_minSizeDirty = true;
+    d->m_maxSizeHintDirty = true;
 
-    const Item::List visibleChildren = this->visibleChildren(/*includeBeingInserted=*/false);
+    // Our parent's sizes are calculated from ours
+    ItemContainer::invalidateSizeCache();
+}
+
+void ItemBoxContainer::Private::discardCacheIfThicknessChanged()
+{
+    if (m_cachedSeparatorThickness != separatorThickness) {
+        m_cachedSeparatorThickness = separatorThickness;
+        m_minSizeDirty = true;
+        m_maxSizeHintDirty = true;
+    }
+}
+
+QSize ItemBoxContainer::Private::computeMaxSizeHint() const
+{
+    int maxW = q->isVertical() ? hardcodedMaximumSize.width() : 0;
+    int maxH = q->isVertical() ? 0 : hardcodedMaximumSize.height();
+
+    const Item::List visibleChildren = q->visibleChildren(/*includeBeingInserted=*/false);
     if (!visibleChildren.isEmpty()) {
         for (Item *item : visibleChildren) {
             if (item->isBeingInserted())
@@ -1824,7 +2127,7 @@ QSize ItemBoxContainer::maxSizeHint() const
             const QSize itemMaxSz = item->maxSizeHint();
             const int itemMaxWidth = itemMaxSz.width();
             const int itemMaxHeight = itemMaxSz.height();
-            if (isVertical()) {
+            if (q->isVertical()) {
                 maxW = qMin(maxW, itemMaxWidth);
                 maxH = qMin(maxH + itemMaxHeight, hardcodedMaximumSize.height());
             } else {
@@ -1834,7 +2137,7 @@ QSize ItemBoxContainer::maxSizeHint() const
         }
 
         const auto separatorWaste = (visibleChildren.size() - 1) * separatorThickness;
-        if (isVertical()) {
+        if (q->isVertical()) {
             maxH = qMin(maxH + separatorWaste, hardcodedMaximumSize.height());
         } else {
             maxW = qMin(maxW + separatorWaste, hardcodedMaximumSize.width());
@@ -1847,7 +2150,7 @@ QSize ItemBoxContainer::maxSizeHint() const
     if (maxH == 0)
         maxH = hardcodedMaximumSize.height();
 
-    return QSize(maxW, maxH).expandedTo(d->minSize(visibleChildren));
+    return QSize(maxW, maxH).expandedTo(minSize(visibleChildren));
 }
 
 void ItemBoxContainer::Private::resizeChildren(QSize oldSize, QSize newSize, SizingInfo::List &childSizes,
@@ -2123,8 +2426,8 @@ void ItemBoxContainer::dumpLayout(int level)
             if (i < d->m_separators.size()) {
                 auto separator = d->m_separators.at(i);
                 qDebug().noquote() << indent << " - Separator: "
-                                   << "local.geo=" << mapFromRoot(separator->asWidget()->geometry())
-                                   << "global.geo=" << separator->asWidget()->geometry()
+                                   << "local.geo=" << mapFromRoot(separator->geometry())
+                                   << "global.geo=" << separator->geometry()
                                    << separator;
             }
             ++i;
@@ -3067,6 +3370,8 @@ void ItemBoxContainer::Private::updateSeparators()
         m_separators = newSeparators;
     }
 
+    markDirtyForSanityCheck();
+
     // Update their positions:
     const int pos2 = q->isVertical() ? q->mapToRoot(QPoint(0, 0)).x()
                                      : q->mapToRoot(QPoint(0, 0)).y();
@@ -3148,6 +3453,8 @@ void ItemBoxContainer::simplify()
 
     if (m_children != newChildren) {
         m_children = newChildren;
+        invalidateSizeCache();
+        d->markDirtyForSanityCheck();
         positionItems();
         updateChildPercentages();
     }
@@ -3274,6 +3581,8 @@ void ItemBoxContainer::fillFromVariantMap(const QVariantMap &map,
         m_children.push_back(child);
     }
 
+    invalidateSizeCache();
+
     if (isRoot()) {
         updateChildPercentages_recursive();
         if (hostWidget()) {
@@ -3284,7 +3593,8 @@ void ItemBoxContainer::fillFromVariantMap(const QVariantMap &map,
         d->relayoutIfNeeded();
         positionItems_recursive();
 
-        Q_EMIT minSizeChanged(this);
+        d->m_lastNotifiedMinSize = minSize();
+        notifyMinSizeChanged();
 #ifdef DOCKS_DEVELOPER_MODE
         if (!checkSanity())
             qWarning() << Q_FUNC_INFO << "Resulting layout is invalid";
@@ -3347,6 +3657,28 @@ QVector<Separator *> ItemBoxContainer::separators_recursive() const
     return separators;
 }
 
+Separator *ItemBoxContainer::separatorAt_recursive(QPoint p) const
+{
+    // Separators are in root coordinates and never overlap children, so we only need to descend
+    // into the single child container which contains p
+    for (Separator *separator : qAsConst(d->m_separators)) {
+        if (separator->geometry().contains(p))
+            return separator;
+    }
+
+    for (Item *item : qAsConst(m_children)) {
+        if (!item->isVisible())
+            continue;
+
+        if (auto c = item->asBoxContainer()) {
+            if (c->mapToRoot(c->rect()).contains(p))
+                return c->separatorAt_recursive(p);
+        }
+    }
+
+    return nullptr;
+}
+
 QVector<Separator *> ItemBoxContainer::separators() const
 {
     return d->m_separators;
@@ -3586,6 +3918,16 @@ ItemContainer::~ItemContainer()
     delete d;
 }
 
+void ItemContainer::invalidateSizeCache()
+{
+    if (ItemContainer *parent = parentContainer())
+        parent->invalidateSizeCache();
+}
+
+void ItemContainer::onChildGeometryChanged(Item *, QRect)
+{
+}
+
 const Item::List ItemContainer::childItems() const
 {
     return m_children;
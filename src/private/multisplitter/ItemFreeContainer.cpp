@@ -11,20 +11,159 @@
 
 #include "ItemFreeContainer_p.h"
 
+#include <QMap>
+#include <QHash>
+
 using namespace Layouting;
 
+namespace {
+
+// Side of the grid buckets, in pixels. A MDI frame usually spans a handful of them
+const int s_cellSize = 256;
+
+/// Stacking position. Higher z is on top, for the same z the most recently raised is on top
+struct StackKey
+{
+    int z = 0;
+    quint64 serial = 0;
+
+    bool operator<(StackKey other) const
+    {
+        return z < other.z || (z == other.z && serial < other.serial);
+    }
+};
+
+int cellIndex(int coord)
+{
+    // Rounds towards negative infinity, children can have negative coordinates
+    return coord >= 0 ? coord / s_cellSize : -((-coord - 1) / s_cellSize) - 1;
+}
+
+quint64 cellKey(int column, int row)
+{
+    return (quint64(quint32(column)) << 32) | quint32(row);
+}
+
+}
+
+struct ItemFreeContainer::Private
+{
+    void addToIndex(Item *child, int z);
+    void removeFromIndex(Item *child);
+    void setStackKey(Item *child, StackKey key);
+    void insertIntoGrid(Item *child);
+    void removeFromGrid(Item *child);
+    int topZ() const;
+
+    /// Calls @p func for each child bucketed in a cell touched by @p rect. Might call it more than
+    /// once for the same child.
+    template<typename Func>
+    void forEachCandidate(QRect rect, Func func) const
+    {
+        if (rect.isEmpty())
+            return;
+
+        for (int column = cellIndex(rect.left()), lastColumn = cellIndex(rect.right()); column <= lastColumn; ++column) {
+            for (int row = cellIndex(rect.top()), lastRow = cellIndex(rect.bottom()); row <= lastRow; ++row) {
+                auto it = m_cells.constFind(cellKey(column, row));
+                if (it == m_cells.cend())
+                    continue;
+                for (Item *child : it.value())
+                    func(child);
+            }
+        }
+    }
+
+    QMap<StackKey, Item *> m_stack; // bottom to top
+    QHash<const Item *, StackKey> m_stackKeys;
+    QHash<quint64, QVector<Item *>> m_cells;
+    QHash<const Item *, QRect> m_gridRects; // the geometry each child was bucketed with
+    quint64 m_nextSerial = 0;
+};
+
+void ItemFreeContainer::Private::addToIndex(Item *child, int z)
+{
+    setStackKey(child, { z, ++m_nextSerial });
+    insertIntoGrid(child);
+}
+
+void ItemFreeContainer::Private::removeFromIndex(Item *child)
+{
+    removeFromGrid(child);
+
+    auto it = m_stackKeys.find(child);
+    if (it != m_stackKeys.end()) {
+        m_stack.remove(it.value());
+        m_stackKeys.erase(it);
+    }
+}
+
+void ItemFreeContainer::Private::setStackKey(Item *child, StackKey key)
+{
+    auto it = m_stackKeys.find(child);
+    if (it != m_stackKeys.end()) {
+        m_stack.remove(it.value());
+        it.value() = key;
+    } else {
+        m_stackKeys.insert(child, key);
+    }
+
+    m_stack.insert(key, child);
+}
+
+void ItemFreeContainer::Private::insertIntoGrid(Item *child)
+{
+    const QRect rect = child->geometry();
+    if (rect.isEmpty())
+        return;
+
+    for (int column = cellIndex(rect.left()), lastColumn = cellIndex(rect.right()); column <= lastColumn; ++column) {
+        for (int row = cellIndex(rect.top()), lastRow = cellIndex(rect.bottom()); row <= lastRow; ++row)
+            m_cells[cellKey(column, row)].push_back(child);
+    }
+
+    m_gridRects.insert(child, rect);
+}
+
+void ItemFreeContainer::Private::removeFromGrid(Item *child)
+{
+    const QRect rect = m_gridRects.take(child);
+    if (rect.isEmpty())
+        return;
+
+    for (int column = cellIndex(rect.left()), lastColumn = cellIndex(rect.right()); column <= lastColumn; ++column) {
+        for (int row = cellIndex(rect.top()), lastRow = cellIndex(rect.bottom()); row <= lastRow; ++row) {
+            auto it = m_cells.find(cellKey(column, row));
+            if (it == m_cells.end())
+                continue;
+
+            it.value().removeOne(child);
+            if (it.value().isEmpty())
+                m_cells.erase(it);
+        }
+    }
+}
+
+int ItemFreeContainer::Private::topZ() const
+{
+    return m_stack.isEmpty() ? 0 : m_stack.lastKey().z;
+}
+
 ItemFreeContainer::ItemFreeContainer(Widget *hostWidget, ItemContainer *parent)
     : ItemContainer(hostWidget, parent)
+    , d(new Private())
 {
 }
 
 ItemFreeContainer::ItemFreeContainer(Widget *hostWidget)
     : ItemContainer(hostWidget)
+    , d(new Private())
 {
 }
 
 ItemFreeContainer::~ItemFreeContainer()
 {
+    delete d;
 }
 
 void ItemFreeContainer::addDockWidget(Item *item, QPoint localPt)
@@ -38,6 +177,7 @@ void ItemFreeContainer::addDockWidget(Item *item, QPoint localPt)
 
     m_children.append(item);
     item->setParentContainer(this);
+    d->addToIndex(item, d->topZ());
     item->setPos(localPt);
 
     Q_EMIT itemsChanged();
@@ -52,6 +192,11 @@ void ItemFreeContainer::clear()
 {
     qDeleteAll(m_children);
     m_children.clear();
+
+    d->m_stack.clear();
+    d->m_stackKeys.clear();
+    d->m_cells.clear();
+    d->m_gridRects.clear();
 }
 
 void ItemFreeContainer::removeItem(Item *item, bool hardRemove)
@@ -59,9 +204,11 @@ void ItemFreeContainer::removeItem(Item *item, bool hardRemove)
     const bool wasVisible = item->isVisible();
 
     if (hardRemove) {
+        d->removeFromIndex(item);
         m_children.removeOne(item);
         delete item;
     } else {
+        // Placeholders keep their place in the stack, hit-testing skips them
         item->setIsVisible(false);
         item->setGuestWidget(nullptr);
     }
@@ -86,3 +233,165 @@ void ItemFreeContainer::onChildVisibleChanged(Item *, bool)
 {
     // Nothing needed to do in this layout type
 }
+
+void ItemFreeContainer::onChildGeometryChanged(Item *child, QRect)
+{
+    if (!d->m_stackKeys.contains(child)) {
+        // Not added yet
+        return;
+    }
+
+    d->removeFromGrid(child);
+    d->insertIntoGrid(child);
+}
+
+QVariantMap ItemFreeContainer::toVariantMap() const
+{
+    QVariantMap result = Item::toVariantMap();
+
+    QVariantList childrenV;
+    childrenV.reserve(m_children.size());
+    for (auto it = d->m_stack.cbegin(), end = d->m_stack.cend(); it != end; ++it) {
+        QVariantMap childV = it.value()->toVariantMap();
+        childV[QStringLiteral("z")] = it.key().z;
+        childrenV.push_back(childV);
+    }
+
+    result[QStringLiteral("children")] = childrenV;
+
+    return result;
+}
+
+void ItemFreeContainer::fillFromVariantMap(const QVariantMap &map, const QHash<QString, Widget *> &widgets)
+{
+    Item::fillFromVariantMap(map, widgets);
+
+    // Saved from bottom to top, so children with the same z keep their order
+    const QVariantList childrenV = map[QStringLiteral("children")].toList();
+    for (const QVariant &childV : childrenV) {
+        const QVariantMap childMap = childV.toMap();
+        auto child = new Item(hostWidget(), this);
+        child->fillFromVariantMap(childMap, widgets);
+        m_children.push_back(child);
+        d->addToIndex(child, childMap.value(QStringLiteral("z")).toInt());
+    }
+
+    Q_EMIT itemsChanged();
+    Q_EMIT numVisibleItemsChanged(numVisibleChildren());
+    Q_EMIT numItemsChanged();
+}
+
+int ItemFreeContainer::raiseItem(Item *child)
+{
+    auto it = d->m_stackKeys.constFind(child);
+    if (it == d->m_stackKeys.cend()) {
+        qWarning() << Q_FUNC_INFO << "Unknown child" << child;
+        return 0;
+    }
+
+    const int z = d->topZ();
+    if (d->m_stack.last() != child)
+        d->setStackKey(child, { z, ++d->m_nextSerial });
+
+    return z;
+}
+
+void ItemFreeContainer::setItemZ(Item *child, int z)
+{
+    if (!d->m_stackKeys.contains(child)) {
+        qWarning() << Q_FUNC_INFO << "Unknown child" << child;
+        return;
+    }
+
+    d->setStackKey(child, { z, ++d->m_nextSerial });
+}
+
+int ItemFreeContainer::itemZ(const Item *child) const
+{
+    return d->m_stackKeys.value(child).z;
+}
+
+Item *ItemFreeContainer::itemAbove(const Item *child) const
+{
+    auto keyIt = d->m_stackKeys.constFind(child);
+    if (keyIt == d->m_stackKeys.cend())
+        return nullptr;
+
+    auto it = d->m_stack.upperBound(keyIt.value());
+    return it == d->m_stack.cend() ? nullptr : it.value();
+}
+
+Item::List ItemFreeContainer::itemsInStackingOrder() const
+{
+    Item::List result;
+    result.reserve(d->m_stack.size());
+    for (Item *child : qAsConst(d->m_stack))
+        result.push_back(child);
+
+    return result;
+}
+
+Item *ItemFreeContainer::itemAt(QPoint pos, int margin) const
+{
+    const QMargins margins(margin, margin, margin, margin);
+    Item *result = nullptr;
+    StackKey resultKey;
+
+    d->forEachCandidate(QRect(pos, QSize(1, 1)).marginsAdded(margins), [&](Item *child) {
+        if (!child->isVisible() || !child->geometry().marginsAdded(margins).contains(pos))
+            return;
+
+        const StackKey key = d->m_stackKeys.value(child);
+        if (!result || resultKey < key) {
+            result = child;
+            resultKey = key;
+        }
+    });
+
+    return result;
+}
+
+Item::List ItemFreeContainer::itemsIntersecting(QRect rect) const
+{
+    // Also dedups children found in more than one cell
+    QMap<StackKey, Item *> found;
+    d->forEachCandidate(rect, [&](Item *child) {
+        if (child->isVisible() && child->geometry().intersects(rect))
+            found.insert(d->m_stackKeys.value(child), child);
+    });
+
+    Item::List result;
+    result.reserve(found.size());
+    for (Item *child : qAsConst(found))
+        result.push_back(child);
+
+    return result;
+}
+
+bool ItemFreeContainer::checkSanity()
+{
+    if (!Item::checkSanity())
+        return false;
+
+    if (d->m_stack.size() != m_children.size() || d->m_stackKeys.size() != m_children.size()) {
+        qWarning() << Q_FUNC_INFO << "Stacking order out of sync with children"
+                   << d->m_stack.size() << d->m_stackKeys.size() << m_children.size();
+        return false;
+    }
+
+    for (Item *child : qAsConst(m_children)) {
+        if (!d->m_stackKeys.contains(child)) {
+            qWarning() << Q_FUNC_INFO << "Child not in the stacking order" << child;
+            return false;
+        }
+
+        const QRect geometry = child->geometry();
+        if (!geometry.isEmpty() && d->m_gridRects.value(child) != geometry) {
+            qWarning() << Q_FUNC_INFO << "Stale geometry in the hit-testing grid" << child
+                       << d->m_gridRects.value(child) << geometry;
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -25,6 +25,10 @@ namespace Layouting {
 /// layouting with nesting.
 ///
 /// This free layout can be used to implement MDI style windows
+///
+/// Children can overlap, so each one has a z value. Items with the same z are stacked in the order
+/// they were raised. Their geometries are kept in a grid of buckets, so hit-testing doesn't need
+/// to look at every child.
 class DOCKS_EXPORT_FOR_UNIT_TESTS ItemFreeContainer : public ItemContainer
 {
 public:
@@ -35,6 +39,7 @@ public:
     ~ItemFreeContainer();
 
     /// @brief adds the item to the specified position
+    /// The item is stacked on top of the existing ones
     void addDockWidget(Item *item, QPoint localPt);
 
     void clear() override;
@@ -42,6 +47,37 @@ public:
     void restore(Item *child) override;
     void onChildMinSizeChanged(Item *child) override;
     void onChildVisibleChanged(Item *child, bool visible) override;
+    void onChildGeometryChanged(Item *child, QRect oldGeometry) override;
+    QVariantMap toVariantMap() const override;
+    void fillFromVariantMap(const QVariantMap &map, const QHash<QString, Widget *> &widgets) override;
+
+    /// @brief Stacks @p child on top of all others. Returns its new z
+    int raiseItem(Item *child);
+
+    /// @brief Sets the z of @p child. It goes on top of the other children with the same z
+    void setItemZ(Item *child, int z);
+
+    /// @brief Returns the z of @p child
+    int itemZ(const Item *child) const;
+
+    /// @brief Returns the child stacked right above @p child, or nullptr if it's the top one
+    Item *itemAbove(const Item *child) const;
+
+    /// @brief Returns the children, from bottom to top
+    Item::List itemsInStackingOrder() const;
+
+    /// @brief Returns the topmost visible child at @p pos. nullptr if none
+    /// @param margin if > 0 the children are hit-tested as if they were @p margin pixels bigger on each side
+    Item *itemAt(QPoint pos, int margin = 0) const;
+
+    /// @brief Returns the visible children intersecting @p rect, from bottom to top
+    Item::List itemsIntersecting(QRect rect) const;
+
+    Q_REQUIRED_RESULT bool checkSanity() override;
+
+private:
+    struct Private;
+    Private *const d;
 };
 
 }
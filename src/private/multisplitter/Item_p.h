@@ -308,6 +308,17 @@ public:
     int refCount() const;
     void turnIntoPlaceholder();
 
+    ///@brief To be called by guests when their parent changes. Turns this item into a placeholder
+    /// if the guest left the layout. @sa Widget::notifiesParentChanges()
+    void onGuestParentChanged();
+
+    ///@brief Returns for how many milliseconds this item has been a placeholder, or -1 if it's visible
+    qint64 placeholderAge() const;
+
+    ///@brief Detaches the guest the same way as if it had been destroyed, but the guest stays alive
+    /// Used when the guest is recycled instead of deleted.
+    void releaseGuest();
+
     int minLength(Qt::Orientation) const;
     int maxLengthHint(Qt::Orientation) const;
 
@@ -317,6 +328,11 @@ public:
 
     QVector<int> pathFromRoot() const;
 
+    ///@brief Returns a name for debug output and serialization
+    /// For non-containers it's the guest's objectName, or its state if there's no guest.
+    /// Computed on demand, so items don't each hold an objectName which would need updating.
+    QString displayName() const;
+
     Q_REQUIRED_RESULT virtual bool checkSanity();
 
     bool isMDI() const;
@@ -334,8 +350,16 @@ public:
     static Item *createFromVariantMap(Widget *hostWidget, ItemContainer *parent,
                                       const QVariantMap &map, const QHash<QString, Widget *> &widgets);
 
+    ///@brief Emits the pending geometryChanged() signals now, instead of on the next event loop pass
+    /// Only relevant with Config::Flag::BatchedGeometryChanges
+    static void flushGeometryChanges();
+
 Q_SIGNALS:
-    void geometryChanged();
+    ///@brief Emitted when the geometry changes
+    /// With Config::Flag::BatchedGeometryChanges it's emitted once per event loop pass instead,
+    /// and replaces xChanged(), yChanged(), widthChanged() and heightChanged(), which aren't emitted.
+    /// Outside of the GUI thread nothing is batched.
+    void geometryChanged(QRect);
     void xChanged();
     void yChanged();
     void widthChanged();
@@ -377,9 +401,13 @@ private:
     friend class ItemFreeContainer;
     bool eventFilter(QObject *o, QEvent *event) override;
     int m_refCount = 0;
-    void updateObjectName();
+    qint64 m_hiddenSince = -1; // See placeholderAge()
+    void notifyMinSizeChanged();
+    void notifyVisibleChanged(bool visible);
+    void scheduleGeometryChanged(bool moved);
     void onWidgetDestroyed();
     bool m_isVisible = false;
+    bool m_geometryChangePending = false;
     Widget *m_hostWidget = nullptr;
     Widget *m_guest = nullptr;
 };
@@ -398,6 +426,9 @@ public:
     virtual void onChildMinSizeChanged(Item *child) = 0;
     virtual void onChildVisibleChanged(Item *child, bool visible) = 0;
 
+    ///@brief Called by a child after its geometry changed. Does nothing by default
+    virtual void onChildGeometryChanged(Item *child, QRect oldGeometry);
+
     int numVisibleChildren() const;
     int numChildren() const;
     bool hasChildren() const;
@@ -414,6 +445,10 @@ public:
     int count_recursive() const;
     virtual void clear() = 0;
 
+    ///@brief Marks the cached min/max sizes of this container and its ancestors as stale
+    /// Called when a child's size constraints or visibility change, or children are added or removed.
+    virtual void invalidateSizeCache();
+
 protected:
     bool hasSingleVisibleItem() const;
 
@@ -456,8 +491,13 @@ public:
     void removeItem(Item *, bool hardRemove = true) override;
     QSize minSize() const override;
     QSize maxSizeHint() const override;
+    void invalidateSizeCache() override;
     QSize availableSize() const;
     Q_REQUIRED_RESULT bool checkSanity() override;
+
+    /// @brief Runs the checks selected by Config::sanityCheckLevel() and records how long they took
+    /// Called on the root container after layout operations. checkSanity() always checks everything.
+    Q_REQUIRED_RESULT bool runSanityCheck();
     void dumpLayout(int level = 0) override;
     void setSize_recursive(QSize newSize, ChildrenResizeStrategy strategy = ChildrenResizeStrategy::Percentage) override;
     QRect suggestedDropRect(const Item *item, const Item *relativeTo, KDDockWidgets::Location) const;
@@ -552,6 +592,7 @@ private:
 
     int indexOf(Separator *) const;
     bool isInSimplify() const;
+    void markDirtyForSanityCheck();
 
 #ifdef DOCKS_DEVELOPER_MODE
     bool test_suggestedRect();
@@ -561,6 +602,10 @@ public:
     QVector<Layouting::Separator *> separators_recursive() const;
     QVector<Layouting::Separator *> separators() const;
 
+    ///@brief Returns the separator at @p p, which is in root coordinates. nullptr if none
+    /// Only descends into the containers containing @p p, instead of visiting every separator.
+    Separator *separatorAt_recursive(QPoint p) const;
+
 private:
     void simplify();
     static bool s_inhibitSimplify;
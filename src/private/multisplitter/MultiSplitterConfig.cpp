@@ -13,6 +13,7 @@
 #include "Widget.h"
 #include "Item_p.h"
 #include "Separator_p.h"
+#include "Widget_null.h"
 
 #ifdef KDMULTISPLITTER_QTQUICK
 #include <QQmlEngine>
@@ -27,6 +28,11 @@ Config::Config()
 
 Separator *Config::createSeparator(Widget *parent) const
 {
+    // Layouts without a frontend don't get the frontend's separators, so they can coexist with
+    // real layouts and be built on any thread
+    if (parent && qobject_cast<Widget_null *>(parent->asQObject()))
+        return new SeparatorNull(parent);
+
     if (m_separatorFactoryFunc)
         return m_separatorFactoryFunc(parent);
 
@@ -97,4 +103,44 @@ void Config::setFlags(Flags flags)
     m_flags = flags;
 }
 
+void Config::setSanityCheckLevel(SanityCheckLevel level)
+{
+    m_sanityCheckLevel = level;
+}
+
+Config::SanityCheckLevel Config::sanityCheckLevel() const
+{
+    return m_sanityCheckLevel;
+}
+
+Config::SanityCheckStats Config::sanityCheckStats() const
+{
+    return m_sanityCheckStats;
+}
+
+void Config::resetSanityCheckStats()
+{
+    m_sanityCheckStats = {};
+}
+
+void Config::setLiveResizeInterval(int msecs)
+{
+    m_liveResizeInterval = qMax(-1, msecs);
+}
+
+int Config::liveResizeInterval() const
+{
+    return m_liveResizeInterval;
+}
+
+Config::LiveResizeStats Config::liveResizeStats() const
+{
+    return m_liveResizeStats;
+}
+
+void Config::resetLiveResizeStats()
+{
+    m_liveResizeStats = {};
+}
+
 }
@@ -27,10 +27,38 @@ class DOCKS_EXPORT_FOR_UNIT_TESTS Config
 public:
     enum class Flag {
         None = 0,
-        LazyResize = 1
+        LazyResize = 1,
+        BatchedGeometryChanges = 2 ///< Items emit geometryChanged(QRect) once per event loop pass, and no per-axis signals. See Item::flushGeometryChanges()
     };
     Q_DECLARE_FLAGS(Flags, Flag)
 
+    ///@brief How much of the layout is verified by the automatic sanity checks
+    enum class SanityCheckLevel {
+        Off = 0, ///< No automatic checks. Explicit calls to checkSanity() still work.
+        Incremental, ///< Only verifies the containers which changed since the last check
+        Full ///< Verifies the whole tree. The default.
+    };
+
+    ///@brief Timing of the automatic sanity checks, see sanityCheckStats()
+    struct SanityCheckStats
+    {
+        int numChecks = 0; ///< number of automatic checks which ran
+        int numContainersChecked = 0; ///< containers verified, summed over all checks
+        qint64 lastCheckNSecs = 0; ///< how long the last check took
+        qint64 maxCheckNSecs = 0; ///< how long the slowest check took
+        qint64 totalCheckNSecs = 0; ///< time spent in all checks
+    };
+
+    ///@brief Counters for the throttled live resizes, see setLiveResizeInterval()
+    struct LiveResizeStats
+    {
+        int numResizes = 0; ///< finished mouse resizes (separators, floating windows, MDI frames)
+        int numRequests = 0; ///< resize events received
+        int numRelayouts = 0; ///< relayouts which actually ran
+        qint64 totalNSecs = 0; ///< time spent relayouting
+        qint64 maxRelayoutNSecs = 0; ///< how long the slowest relayout took
+    };
+
     ///@brief returns the singleton Config instance
     static Config &self();
 
@@ -60,9 +88,42 @@ public:
     ///@brief sets the flags. Set only before creating any Item
     void setFlags(Flags);
 
+    /**
+     * @brief Sets which sanity checks run after each layout operation and before saving
+     *
+     * Can be changed at runtime. In incremental mode only changes done after switching
+     * to it are tracked.
+     */
+    void setSanityCheckLevel(SanityCheckLevel);
+
+    ///@brief Returns the sanity check level. SanityCheckLevel::Full by default.
+    SanityCheckLevel sanityCheckLevel() const;
+
+    ///@brief Returns how long the automatic sanity checks took
+    SanityCheckStats sanityCheckStats() const;
+    void resetSanityCheckStats();
+
+    /**
+     * @brief Caps how often live resizes relayout
+     *
+     * Applies to dragging separators, resizing floating windows and MDI frames with the mouse,
+     * and to resizing the main window. Resize events arriving faster than @p msecs are coalesced
+     * and only the latest one is applied. Once the mouse is released a final exact pass runs.
+     *
+     * 0 disables throttling, the default. -1 uses the refresh rate of the primary screen.
+     */
+    void setLiveResizeInterval(int msecs);
+    int liveResizeInterval() const;
+
+    ///@brief Returns the live resize counters, accumulated since the last reset
+    /// Reset before a resize to get per-resize numbers.
+    LiveResizeStats liveResizeStats() const;
+    void resetLiveResizeStats();
+
 private:
     friend class Item;
     friend class ItemBoxContainer;
+    friend class ResizeThrottler;
 
     Config();
     Separator *createSeparator(Layouting::Widget *) const;
@@ -71,6 +132,10 @@ private:
 
     SeparatorFactoryFunc m_separatorFactoryFunc = nullptr;
     Flags m_flags = Flag::None;
+    SanityCheckLevel m_sanityCheckLevel = SanityCheckLevel::Full;
+    SanityCheckStats m_sanityCheckStats;
+    int m_liveResizeInterval = 0;
+    LiveResizeStats m_liveResizeStats;
 
     Q_DISABLE_COPY(Config)
 };
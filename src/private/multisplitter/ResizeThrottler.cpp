@@ -0,0 +1,124 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "ResizeThrottler_p.h"
+#include "MultiSplitterConfig.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QTimer>
+
+using namespace Layouting;
+
+namespace {
+
+/// Returns the interval in ms, resolving -1 to the refresh rate of the primary screen
+int effectiveInterval()
+{
+    const int interval = Config::self().liveResizeInterval();
+    if (interval != -1)
+        return interval;
+
+    const QScreen *screen = QGuiApplication::primaryScreen();
+    const qreal refreshRate = screen ? screen->refreshRate() : 60;
+    return refreshRate > 0 ? qMax(1, qRound(1000 / refreshRate)) : 16;
+}
+
+}
+
+ResizeThrottler::ResizeThrottler(QObject *context)
+    : m_context(context)
+{
+}
+
+ResizeThrottler::~ResizeThrottler()
+{
+}
+
+bool ResizeThrottler::isEnabled()
+{
+    return Config::self().liveResizeInterval() != 0;
+}
+
+void ResizeThrottler::request(std::function<void()> work)
+{
+    Config::self().m_liveResizeStats.numRequests++;
+    m_pendingWork = std::move(work);
+    m_resizeInProgress = true;
+
+    if (m_timerScheduled)
+        return; // The deferred run will pick up the latest work
+
+    const int interval = effectiveInterval();
+    const qint64 elapsed = m_sinceLastRun.isValid() ? m_sinceLastRun.elapsed() : interval;
+    if (elapsed >= interval) {
+        run();
+    } else {
+        m_timerScheduled = true;
+        QTimer::singleShot(int(interval - elapsed), m_context, [this] {
+            onTimeout();
+        });
+    }
+}
+
+void ResizeThrottler::flush()
+{
+    run();
+
+    if (m_resizeInProgress) {
+        m_resizeInProgress = false;
+        Config::self().m_liveResizeStats.numResizes++;
+    }
+
+    // Next resize starts fresh, without waiting for the interval
+    m_sinceLastRun.invalidate();
+}
+
+void ResizeThrottler::cancel()
+{
+    m_pendingWork = nullptr;
+}
+
+void ResizeThrottler::runPendingWork()
+{
+    run();
+}
+
+bool ResizeThrottler::hasPendingWork() const
+{
+    return bool(m_pendingWork);
+}
+
+void ResizeThrottler::run()
+{
+    const std::function<void()> work = std::move(m_pendingWork);
+    m_pendingWork = nullptr;
+    if (!work)
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+    work();
+    const qint64 nsecs = timer.nsecsElapsed();
+
+    Config::LiveResizeStats &stats = Config::self().m_liveResizeStats;
+    stats.numRelayouts++;
+    stats.totalNSecs += nsecs;
+    stats.maxRelayoutNSecs = qMax(stats.maxRelayoutNSecs, nsecs);
+
+    m_sinceLastRun.start();
+}
+
+void ResizeThrottler::onTimeout()
+{
+    m_timerScheduled = false;
+    run();
+}
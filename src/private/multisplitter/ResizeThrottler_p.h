@@ -0,0 +1,65 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_MULTISPLITTER_RESIZETHROTTLER_P_H
+#define KD_MULTISPLITTER_RESIZETHROTTLER_P_H
+
+#include "kddockwidgets/docks_export.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+
+#include <functional>
+
+namespace Layouting {
+
+/**
+ * @brief Coalesces live resize work so it runs at most once per Config::liveResizeInterval()
+ *
+ * request() runs the work right away if the interval already elapsed since the last run,
+ * otherwise it's deferred to the end of the interval and only the latest request survives.
+ * flush() runs the pending work immediately, it's the final exact pass once the mouse is released.
+ *
+ * Timings are accumulated into Config::liveResizeStats().
+ */
+class DOCKS_EXPORT_FOR_UNIT_TESTS ResizeThrottler
+{
+public:
+    ///@brief @p context is used for the deferred run, it must outlive this throttler
+    explicit ResizeThrottler(QObject *context);
+    ~ResizeThrottler();
+
+    ///@brief Returns whether live resizes should go through a ResizeThrottler
+    static bool isEnabled();
+
+    void request(std::function<void()> work);
+    void flush();
+    void cancel();
+
+    ///@brief Runs the pending work now, unlike flush() the resize isn't considered finished
+    /// For when the result is needed before the deferred run.
+    void runPendingWork();
+    bool hasPendingWork() const;
+
+private:
+    Q_DISABLE_COPY(ResizeThrottler)
+    void run();
+    void onTimeout();
+    QObject *const m_context;
+    std::function<void()> m_pendingWork;
+    QElapsedTimer m_sinceLastRun;
+    bool m_timerScheduled = false;
+    bool m_resizeInProgress = false;
+};
+
+}
+
+#endif
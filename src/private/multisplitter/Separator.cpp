@@ -14,9 +14,12 @@
 #include "Logging_p.h"
 #include "Item_p.h"
 #include "MultiSplitterConfig.h"
+#include "ResizeThrottler_p.h"
 #include "Config.h"
 
+#include <QAtomicInt>
 #include <QGuiApplication>
+#include <QPointer>
 
 #ifdef KDDOCKWIDGETS_QTWIDGETS
 #include <QWidget>
@@ -37,10 +40,29 @@ bool rubberBandIsTopLevel()
     return KDDockWidgets::Config::self().internalFlags() & KDDockWidgets::Config::InternalFlag_TopLevelIndicatorRubberBand;
 }
 
+/// Only one separator is dragged at a time, so they all share one throttler.
+/// Created on demand and deleted with the application, together with its context.
+ResizeThrottler *separatorThrottler()
+{
+    static QPointer<QObject> s_context;
+    static ResizeThrottler *s_throttler = nullptr;
+
+    if (!s_context) {
+        s_context = new QObject(qApp);
+        s_throttler = new ResizeThrottler(s_context);
+        QObject::connect(s_context, &QObject::destroyed, [] {
+            delete s_throttler;
+            s_throttler = nullptr;
+        });
+    }
+
+    return s_throttler;
+}
+
 }
 
 /// @brief internal counter just for unit-tests
-static int s_numSeparators = 0;
+static QAtomicInt s_numSeparators;
 
 struct Separator::Private
 {
@@ -65,15 +87,17 @@ struct Separator::Private
 Separator::Separator(Widget *hostWidget)
     : d(new Private(hostWidget))
 {
-    s_numSeparators++;
+    s_numSeparators.ref();
 }
 
 Separator::~Separator()
 {
-    s_numSeparators--;
+    s_numSeparators.deref();
     delete d;
-    if (isBeingDragged())
+    if (isBeingDragged()) {
         s_separatorBeingDragged = nullptr;
+        separatorThrottler()->cancel();
+    }
 }
 
 bool Separator::isVertical() const
@@ -162,14 +186,23 @@ void Separator::onMouseMove(QPoint pos)
                                                        : (positionToGoTo > position() ? Side2
                                                                                       : Side1); // Last case shouldn't happen though.
 
-    if (d->lazyResizeRubberBand)
+    if (d->lazyResizeRubberBand) {
         setLazyPosition(positionToGoTo);
-    else
+    } else if (ResizeThrottler::isEnabled()) {
+        // The delta is calculated when the relayout actually runs, as we might have moved meanwhile
+        separatorThrottler()->request([this, positionToGoTo] {
+            d->parentContainer->requestSeparatorMove(this, positionToGoTo - position());
+        });
+    } else {
         d->parentContainer->requestSeparatorMove(this, positionToGoTo - position());
+    }
 }
 
 void Separator::onMouseReleased()
 {
+    // Final exact pass with the latest position
+    separatorThrottler()->flush();
+
     if (d->lazyResizeRubberBand) {
         d->lazyResizeRubberBand->hide();
         d->parentContainer->requestSeparatorMove(this, d->lazyPosition - position());
@@ -181,14 +214,22 @@ void Separator::onMouseReleased()
 void Separator::setGeometry(QRect r)
 {
     if (r != d->geometry) {
+        const QRect oldGeometry = d->geometry;
         d->geometry = r;
         if (auto w = asWidget()) {
             w->setGeometry(r);
             w->setVisible(true);
         }
+
+        onGeometryChanged(oldGeometry);
     }
 }
 
+QRect Separator::geometry() const
+{
+    return d->geometry;
+}
+
 int Separator::position() const
 {
     const QPoint topLeft = d->geometry.topLeft();
@@ -211,7 +252,8 @@ void Separator::init(ItemBoxContainer *parentContainer, Qt::Orientation orientat
     d->orientation = orientation;
     d->lazyResizeRubberBand = d->usesLazyResize ? createRubberBand(rubberBandIsTopLevel() ? nullptr : d->m_hostWidget)
                                                 : nullptr;
-    asWidget()->setVisible(true);
+    if (auto w = asWidget())
+        w->setVisible(true);
 }
 
 ItemBoxContainer *Separator::parentContainer() const
@@ -242,7 +284,7 @@ bool Separator::isResizing()
 
 int Separator::numSeparators()
 {
-    return s_numSeparators;
+    return s_numSeparators.loadRelaxed();
 }
 
 void Separator::setLazyPosition(int pos)
@@ -250,7 +292,7 @@ void Separator::setLazyPosition(int pos)
     if (d->lazyPosition != pos) {
         d->lazyPosition = pos;
 
-        QRect geo = asWidget()->geometry();
+        QRect geo = d->geometry;
         if (isVertical()) {
             geo.moveTop(pos);
         } else {
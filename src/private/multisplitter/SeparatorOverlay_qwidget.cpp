@@ -0,0 +1,217 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "SeparatorOverlay_qwidget.h"
+#include "Separator_qwidget.h"
+#include "Widget_qwidget.h"
+#include "Item_p.h"
+#include "Logging_p.h"
+#include "Config.h"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QStyleOption>
+#include <QMouseEvent>
+
+using namespace Layouting;
+
+OverlaySeparator::OverlaySeparator(Layouting::Widget *hostWidget)
+    : Separator(hostWidget)
+    , m_overlay(SeparatorOverlay::overlayForHost(hostWidget))
+{
+    if (!m_overlay)
+        qWarning() << Q_FUNC_INFO << "Host has no SeparatorOverlay, separator won't be visible";
+}
+
+OverlaySeparator::~OverlaySeparator()
+{
+    if (m_overlay)
+        m_overlay->onSeparatorRemoved(this, geometry());
+}
+
+Layouting::Widget *OverlaySeparator::createRubberBand(Layouting::Widget *parent)
+{
+    return new Layouting::Widget_qwidget(new RubberBand(parent));
+}
+
+void OverlaySeparator::onGeometryChanged(QRect oldGeometry)
+{
+    if (m_overlay)
+        m_overlay->onSeparatorGeometryChanged(oldGeometry, geometry());
+}
+
+SeparatorOverlay::SeparatorOverlay(QWidget *hostWidget)
+    : QWidget(hostWidget)
+{
+    setObjectName(QStringLiteral("SeparatorOverlay"));
+    setMouseTracking(true);
+    setGeometry(hostWidget->rect());
+
+    // Frames are added later, so they'll be stacked on top of us. We only see what's between them.
+    lower();
+    hostWidget->installEventFilter(this);
+}
+
+SeparatorOverlay::~SeparatorOverlay()
+{
+}
+
+void SeparatorOverlay::setRootItem(ItemBoxContainer *root)
+{
+    m_rootItem = root;
+    m_hoveredSeparator = nullptr;
+    m_pressedSeparator = nullptr;
+    update();
+}
+
+ItemBoxContainer *SeparatorOverlay::rootItem() const
+{
+    return m_rootItem;
+}
+
+Separator *SeparatorOverlay::separatorAt(QPoint pos) const
+{
+    return m_rootItem ? m_rootItem->separatorAt_recursive(pos) : nullptr;
+}
+
+SeparatorOverlay *SeparatorOverlay::overlayForHost(Layouting::Widget *hostWidget)
+{
+    QWidget *host = hostWidget ? hostWidget->asQWidget() : nullptr;
+    return host ? host->findChild<SeparatorOverlay *>(QString(), Qt::FindDirectChildrenOnly)
+                : nullptr;
+}
+
+bool SeparatorOverlay::eventFilter(QObject *o, QEvent *ev)
+{
+    if (ev->type() == QEvent::Resize && o == parentWidget())
+        setGeometry(parentWidget()->rect());
+
+    return QWidget::eventFilter(o, ev);
+}
+
+void SeparatorOverlay::paintEvent(QPaintEvent *ev)
+{
+    if (!m_rootItem)
+        return;
+
+    if (KDDockWidgets::Config::self().disabledPaintEvents() & KDDockWidgets::Config::CustomizableWidget_Separator)
+        return;
+
+    QPainter p(this);
+    QStyle *style = parentWidget()->style();
+
+    QStyleOption opt;
+    opt.palette = palette();
+
+    const QRect dirtyRect = ev->rect();
+    const Separator::List separators = m_rootItem->separators_recursive();
+    for (Separator *separator : separators) {
+        const QRect geo = separator->geometry();
+        if (!geo.intersects(dirtyRect))
+            continue;
+
+        opt.rect = geo;
+        opt.state = QStyle::State_None;
+        if (!separator->isVertical())
+            opt.state |= QStyle::State_Horizontal;
+
+        if (isEnabled())
+            opt.state |= QStyle::State_Enabled;
+
+        style->drawControl(QStyle::CE_Splitter, &opt, &p, this);
+    }
+}
+
+void SeparatorOverlay::leaveEvent(QEvent *)
+{
+    setHoveredSeparator(nullptr);
+}
+
+void SeparatorOverlay::mousePressEvent(QMouseEvent *ev)
+{
+    m_pressedSeparator = separatorAt(ev->pos());
+    if (!m_pressedSeparator) {
+        // Not ours, let the host handle it
+        ev->ignore();
+        return;
+    }
+
+    m_pressedSeparator->onMousePress();
+}
+
+void SeparatorOverlay::mouseMoveEvent(QMouseEvent *ev)
+{
+    if (m_pressedSeparator) {
+        m_pressedSeparator->onMouseMove(mapToParent(ev->pos()));
+        return;
+    }
+
+    setHoveredSeparator(separatorAt(ev->pos()));
+    if (!m_hoveredSeparator)
+        ev->ignore();
+}
+
+void SeparatorOverlay::mouseReleaseEvent(QMouseEvent *ev)
+{
+    if (!m_pressedSeparator) {
+        ev->ignore();
+        return;
+    }
+
+    Separator *separator = m_pressedSeparator;
+    m_pressedSeparator = nullptr;
+    separator->onMouseReleased();
+    setHoveredSeparator(separatorAt(ev->pos()));
+}
+
+void SeparatorOverlay::mouseDoubleClickEvent(QMouseEvent *ev)
+{
+    if (Separator *separator = separatorAt(ev->pos())) {
+        separator->onMouseDoubleClick();
+    } else {
+        ev->ignore();
+    }
+}
+
+void SeparatorOverlay::onSeparatorGeometryChanged(QRect oldGeometry, QRect newGeometry)
+{
+    // Qt merges these into a single paint event after the relayout
+    update(oldGeometry);
+    update(newGeometry);
+}
+
+void SeparatorOverlay::onSeparatorRemoved(Separator *separator, QRect geometry)
+{
+    if (m_hoveredSeparator == separator)
+        setHoveredSeparator(nullptr);
+
+    if (m_pressedSeparator == separator)
+        m_pressedSeparator = nullptr;
+
+    update(geometry);
+}
+
+void SeparatorOverlay::setHoveredSeparator(Separator *separator)
+{
+    if (separator == m_hoveredSeparator)
+        return;
+
+    qCDebug(separators) << Q_FUNC_INFO << separator;
+    m_hoveredSeparator = separator;
+
+    if (!separator) {
+        unsetCursor();
+    } else if (separator->isVertical()) {
+        setCursor(Qt::SizeVerCursor);
+    } else {
+        setCursor(Qt::SizeHorCursor);
+    }
+}
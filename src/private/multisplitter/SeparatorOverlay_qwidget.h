@@ -0,0 +1,91 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_MULTISPLITTER_SEPARATOROVERLAY_QWIDGET_P_H
+#define KD_MULTISPLITTER_SEPARATOROVERLAY_QWIDGET_P_H
+
+#include "kddockwidgets/docks_export.h"
+#include "Separator_p.h"
+
+#include <QPointer>
+#include <QWidget>
+
+namespace Layouting {
+
+class ItemBoxContainer;
+class SeparatorOverlay;
+
+/**
+ * @brief A Separator without a widget of its own
+ *
+ * Just holds the geometry and orientation, the SeparatorOverlay of its host paints it and
+ * forwards the mouse events to it.
+ */
+class DOCKS_EXPORT OverlaySeparator : public Layouting::Separator
+{
+public:
+    explicit OverlaySeparator(Layouting::Widget *hostWidget);
+    ~OverlaySeparator() override;
+
+protected:
+    Widget *createRubberBand(Widget *parent) override;
+    void onGeometryChanged(QRect oldGeometry) override;
+
+private:
+    const QPointer<SeparatorOverlay> m_overlay;
+};
+
+/**
+ * @brief Transparent layer which paints and hit-tests all the separators of a layout
+ *
+ * Used with Config::Flag_SeparatorOverlay. It's a child of the layout's host widget, stacked
+ * below the frames, so it only receives the mouse events which land between them.
+ * There's one per layout instead of one widget per separator.
+ */
+class DOCKS_EXPORT SeparatorOverlay : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit SeparatorOverlay(QWidget *hostWidget);
+    ~SeparatorOverlay() override;
+
+    ///@brief Sets the root item whose separators are painted. Called when the layout's root changes
+    void setRootItem(ItemBoxContainer *);
+    ItemBoxContainer *rootItem() const;
+
+    ///@brief Returns the separator at @p pos, in host coordinates. nullptr if none
+    Separator *separatorAt(QPoint pos) const;
+
+    ///@brief Returns the overlay of @p hostWidget, if any
+    static SeparatorOverlay *overlayForHost(Layouting::Widget *hostWidget);
+
+protected:
+    bool eventFilter(QObject *, QEvent *) override;
+    void paintEvent(QPaintEvent *) override;
+    void leaveEvent(QEvent *) override;
+    void mousePressEvent(QMouseEvent *) override;
+    void mouseMoveEvent(QMouseEvent *) override;
+    void mouseReleaseEvent(QMouseEvent *) override;
+    void mouseDoubleClickEvent(QMouseEvent *) override;
+
+private:
+    friend class OverlaySeparator;
+    void onSeparatorGeometryChanged(QRect oldGeometry, QRect newGeometry);
+    void onSeparatorRemoved(Separator *, QRect geometry);
+    void setHoveredSeparator(Separator *);
+    QPointer<ItemBoxContainer> m_rootItem;
+    Separator *m_hoveredSeparator = nullptr;
+    Separator *m_pressedSeparator = nullptr;
+};
+
+}
+
+#endif
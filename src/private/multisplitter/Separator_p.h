@@ -16,6 +16,7 @@
 
 #include <QObject>
 #include <QPoint>
+#include <QRect>
 
 namespace Layouting {
 
@@ -36,6 +37,7 @@ public:
     Qt::Orientation orientation() const;
     void setGeometry(int pos, int pos2, int length);
     void setGeometry(QRect r);
+    QRect geometry() const;
     int position() const;
     QObject *host() const;
 
@@ -45,7 +47,13 @@ public:
 
     ///@brief Returns whether we're dragging a separator. Can be useful for the app to stop other work while we're not in the final size
     static bool isResizing();
-    virtual Widget *asWidget() = 0;
+
+    ///@brief Returns the widget representing this separator
+    /// Can be nullptr if the separator is painted by a SeparatorOverlay instead
+    virtual Widget *asWidget()
+    {
+        return nullptr;
+    }
 
     /// @internal Just for the unit-tests.
     /// Returns the total amount of Separator() instances currently alive.
@@ -58,6 +66,13 @@ protected:
         Q_UNUSED(parent);
         return nullptr;
     }
+
+    ///@brief Called after the geometry changed, for separators without a widget of their own
+    virtual void onGeometryChanged(QRect oldGeometry)
+    {
+        Q_UNUSED(oldGeometry);
+    }
+
     void onMousePress();
     void onMouseReleased();
     void onMouseDoubleClick();
@@ -65,6 +80,7 @@ protected:
 
 private:
     friend class Config;
+    friend class SeparatorOverlay;
 
     Q_DISABLE_COPY(Separator)
     void setLazyPosition(int);
@@ -12,12 +12,14 @@
 #include "Widget.h"
 #include "Item_p.h"
 
+#include <QAtomicInteger>
+
 using namespace Layouting;
 
-static qint64 s_nextFrameId = 1;
+static QAtomicInteger<qint64> s_nextFrameId(1);
 
 Widget::Widget(QObject *thisObj)
-    : m_id(QString::number(s_nextFrameId++))
+    : m_id(QString::number(s_nextFrameId.fetchAndAddRelaxed(1)))
     , m_thisObj(thisObj)
 {
 }
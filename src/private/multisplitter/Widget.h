@@ -109,6 +109,13 @@ public:
     virtual void hide() = 0;
     virtual void update() = 0;
 
+    ///@brief Returns whether this guest calls Item::onGuestParentChanged() itself when reparented
+    /// Otherwise its Item installs an event filter on it, just to catch QEvent::ParentChange.
+    virtual bool notifiesParentChanges() const
+    {
+        return false;
+    }
+
     QSize size() const
     {
         return geometry().size();
@@ -0,0 +1,179 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "Widget_null.h"
+#include "Item_p.h"
+
+#include <QDebug>
+
+#include <atomic>
+
+using namespace Layouting;
+
+// Trees hosted by a Widget_null are built on several threads at once, see LayoutLinter
+static std::atomic<int> s_geometryChanges { 0 };
+static std::atomic<int> s_visibilityChanges { 0 };
+
+Widget_null::Widget_null(Widget_null *parent)
+    : QObject(parent)
+    , Widget(this)
+    , m_minSize(Item::hardcodedMinimumSize)
+    , m_maxSize(Item::hardcodedMaximumSize)
+{
+}
+
+Widget_null::~Widget_null()
+{
+}
+
+QSize Widget_null::minSize() const
+{
+    return m_minSize.expandedTo(Item::hardcodedMinimumSize);
+}
+
+QSize Widget_null::maxSizeHint() const
+{
+    return boundedMaxSize(minSize(), m_maxSize);
+}
+
+QRect Widget_null::geometry() const
+{
+    return m_geometry;
+}
+
+void Widget_null::setGeometry(QRect rect)
+{
+    if (rect != m_geometry) {
+        m_geometry = rect;
+        s_geometryChanges++;
+    }
+}
+
+void Widget_null::setParent(Widget *parent)
+{
+    QObject *newParent = parent ? parent->asQObject() : nullptr;
+    if (newParent == QObject::parent())
+        return;
+
+    QObject::setParent(newParent);
+
+    // There's no QEvent::ParentChange without a frontend, tell the item directly
+    if (m_layoutItem)
+        m_layoutItem->onGuestParentChanged();
+}
+
+QDebug &Widget_null::dumpDebug(QDebug &d) const
+{
+    d << " Dump Start: Host=" << static_cast<const QObject *>(this) << rect();
+    return d;
+}
+
+bool Widget_null::isVisible() const
+{
+    return m_visible;
+}
+
+void Widget_null::setVisible(bool is) const
+{
+    if (is != m_visible) {
+        m_visible = is;
+        s_visibilityChanges++;
+    }
+}
+
+std::unique_ptr<Widget> Widget_null::parentWidget() const
+{
+    // A Widget_null is its own Widget, there's no wrapper we could hand ownership of
+    return {};
+}
+
+void Widget_null::setLayoutItem(Item *item)
+{
+    m_layoutItem = item;
+}
+
+void Widget_null::show()
+{
+    setVisible(true);
+}
+
+void Widget_null::hide()
+{
+    setVisible(false);
+}
+
+void Widget_null::move(int x, int y)
+{
+    setGeometry(QRect(QPoint(x, y), m_geometry.size()));
+}
+
+void Widget_null::setSize(int width, int height)
+{
+    setGeometry(QRect(m_geometry.topLeft(), QSize(width, height)));
+}
+
+void Widget_null::setWidth(int width)
+{
+    setSize(width, m_geometry.height());
+}
+
+void Widget_null::setHeight(int height)
+{
+    setSize(m_geometry.width(), height);
+}
+
+void Widget_null::update()
+{
+}
+
+bool Widget_null::notifiesParentChanges() const
+{
+    return true;
+}
+
+void Widget_null::setMinSize(QSize sz)
+{
+    if (sz != m_minSize) {
+        m_minSize = sz;
+        Q_EMIT layoutInvalidated();
+    }
+}
+
+void Widget_null::setMaxSizeHint(QSize sz)
+{
+    if (sz != m_maxSize) {
+        m_maxSize = sz;
+        Q_EMIT layoutInvalidated();
+    }
+}
+
+Widget_null::Stats Widget_null::stats()
+{
+    Stats stats;
+    stats.geometryChanges = s_geometryChanges;
+    stats.visibilityChanges = s_visibilityChanges;
+    return stats;
+}
+
+void Widget_null::resetStats()
+{
+    s_geometryChanges = 0;
+    s_visibilityChanges = 0;
+}
+
+SeparatorNull::SeparatorNull(Widget *hostWidget)
+    : Separator(hostWidget)
+{
+}
+
+SeparatorNull::~SeparatorNull()
+{
+}
@@ -0,0 +1,88 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include "Widget.h"
+#include "Separator_p.h"
+
+#include <QPointer>
+
+///@file
+///@brief A Layouting::Widget without any frontend
+
+namespace Layouting {
+
+///@brief A Layouting::Widget that's not backed by any QWidget or QQuickItem
+/// Geometry, visibility and size constraints are plain members, so hosting it only
+/// costs what the layouting engine itself costs. Useful to benchmark the engine in
+/// isolation and to compare against the frontends.
+class DOCKS_EXPORT_FOR_UNIT_TESTS Widget_null : public QObject, public Widget
+{
+    Q_OBJECT
+public:
+    struct Stats
+    {
+        int geometryChanges = 0; ///< setGeometry() calls which changed the geometry
+        int visibilityChanges = 0; ///< setVisible() calls which changed the visibility
+    };
+
+    explicit Widget_null(Widget_null *parent = nullptr);
+    ~Widget_null() override;
+
+    QSize minSize() const override;
+    QSize maxSizeHint() const override;
+    QRect geometry() const override;
+    void setGeometry(QRect) override;
+    void setParent(Widget *) override;
+    QDebug &dumpDebug(QDebug &) const override;
+    bool isVisible() const override;
+    void setVisible(bool) const override;
+    std::unique_ptr<Widget> parentWidget() const override;
+    void setLayoutItem(Item *) override;
+    void show() override;
+    void hide() override;
+    void move(int x, int y) override;
+    void setSize(int width, int height) override;
+    void setWidth(int width) override;
+    void setHeight(int height) override;
+    void update() override;
+    bool notifiesParentChanges() const override;
+
+    void setMinSize(QSize);
+    void setMaxSizeHint(QSize);
+
+    ///@brief Returns the counters accumulated by all Widget_null instances, of all threads
+    static Stats stats();
+    static void resetStats();
+
+Q_SIGNALS:
+    void layoutInvalidated();
+
+private:
+    QRect m_geometry;
+    QSize m_minSize;
+    QSize m_maxSize;
+    mutable bool m_visible = false;
+    QPointer<Item> m_layoutItem;
+    Q_DISABLE_COPY(Widget_null)
+};
+
+///@brief A Separator for layouts hosted by a Widget_null
+/// Has no widget, the geometry is only stored by the Separator base class.
+class DOCKS_EXPORT_FOR_UNIT_TESTS SeparatorNull : public Separator
+{
+public:
+    explicit SeparatorNull(Widget *hostWidget);
+    ~SeparatorNull() override;
+};
+
+}
@@ -13,6 +13,8 @@
 #include "Item_p.h"
 
 #include <QDebug>
+#include <QHash>
+#include <QQmlComponent>
 #include <QQmlEngine>
 
 using namespace Layouting;
@@ -139,10 +141,24 @@ QQuickItem *Widget_quick::createQQuickItem(const QString &filename, QQuickItem *
         return nullptr;
     }
 
-    QQmlComponent component(engine, filename);
-    auto qquickitem = qobject_cast<QQuickItem *>(component.create());
+    // There's one separator per pair of items, so compile its QML only once per engine
+    static QHash<QQmlEngine *, QHash<QString, QQmlComponent *>> s_components;
+    auto engineIt = s_components.find(engine);
+    if (engineIt == s_components.end()) {
+        engineIt = s_components.insert(engine, {});
+        QObject::connect(engine, &QObject::destroyed, [engine] {
+            // The components were children of the engine
+            s_components.remove(engine);
+        });
+    }
+
+    QQmlComponent *&component = (*engineIt)[filename];
+    if (!component)
+        component = new QQmlComponent(engine, filename, engine);
+
+    auto qquickitem = qobject_cast<QQuickItem *>(component->create());
     if (!qquickitem) {
-        qWarning() << Q_FUNC_INFO << component.errorString();
+        qWarning() << Q_FUNC_INFO << component->errorString();
         return nullptr;
     }
 
@@ -25,9 +25,36 @@
 #include "../WidgetResizeHandler_p.h"
 
 #include <QDebug>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQmlIncubator>
+#include <QTimer>
 
 using namespace KDDockWidgets;
 
+class FrameQuick::VisualItemIncubator : public QQmlIncubator
+{
+public:
+    explicit VisualItemIncubator(FrameQuick *frame)
+        : QQmlIncubator(QQmlIncubator::Asynchronous)
+        , m_frame(frame)
+    {
+    }
+
+protected:
+    void statusChanged(Status status) override
+    {
+        if (status == QQmlIncubator::Ready) {
+            m_frame->onVisualItemIncubated(qobject_cast<QQuickItem *>(object()));
+        } else if (status == QQmlIncubator::Error) {
+            qWarning() << Q_FUNC_INFO << "Failed to create item" << errors();
+        }
+    }
+
+private:
+    FrameQuick *const m_frame;
+};
+
 FrameQuick::FrameQuick(QWidgetAdapter *parent, FrameOptions options, int userType)
     : Frame(parent, options, userType)
 {
@@ -40,41 +67,90 @@ FrameQuick::FrameQuick(QWidgetAdapter *parent, FrameOptions options, int userTyp
     connect(this, &QWidgetAdapter::geometryUpdated, this, &Frame::layoutInvalidated);
 
     connect(this, &QWidgetAdapter::widgetGeometryChanged, this, [this] {
-        for (auto dw : dockWidgets()) {
-            Q_EMIT static_cast<DockWidgetQuick *>(dw)->frameGeometryChanged(QWidgetAdapter::geometry());
+        if (!(Config::self().flags() & Config::Flag_BatchedGeometryChanges)) {
+            emitFrameGeometryChanged();
+        } else if (!m_frameGeometryChangePending) {
+            // Moving and resizing notify separately, and a relayout can resize us more than once
+            m_frameGeometryChangePending = true;
+            QTimer::singleShot(0, this, &FrameQuick::emitFrameGeometryChanged);
         }
     });
 
-    QQmlComponent component(Config::self().qmlEngine(),
-                            Config::self().frameworkWidgetFactory()->frameFilename());
+    FrameworkWidgetFactory *factory = Config::self().frameworkWidgetFactory();
+    QQmlEngine *engine = Config::self().qmlEngine();
+    QQmlComponent *component = factory->qmlComponent(engine, factory->frameFilename());
+    if (!component)
+        return;
 
-    m_visualItem = static_cast<QQuickItem *>(component.create());
+    if (factory->asynchronousFrameCreation() && engine->incubationController()) {
+        // Dock widgets added meanwhile are parented to the frame, until the QML calls setStackLayout()
+        m_incubator.reset(new VisualItemIncubator(this));
+        component->create(*m_incubator);
+        return;
+    }
 
-    if (!m_visualItem) {
-        qWarning() << Q_FUNC_INFO << "Failed to create item" << component.errorString();
+    auto visualItem = qobject_cast<QQuickItem *>(component->create());
+    if (!visualItem) {
+        qWarning() << Q_FUNC_INFO << "Failed to create item" << component->errorString();
         return;
     }
 
-    m_visualItem->setProperty("frameCpp", QVariant::fromValue(this));
-    m_visualItem->setParentItem(this);
-    m_visualItem->setParent(this);
+    setVisualItem(visualItem);
 }
 
 FrameQuick::~FrameQuick()
 {
+    // Aborts the incubation, if it's still running
+    m_incubator.reset();
+
     {
         const DockWidgetBase::List docks = dockWidgets();
 
         // The QML item must be deleted with deleteLater(), has we might be currently with its mouse
         // handler in the stack. QML doesn't support it being deleted in that case.
         // So unparent it and deleteLater().
-        m_visualItem->setParent(nullptr);
-        m_visualItem->deleteLater();
+        if (m_visualItem) {
+            m_visualItem->setParent(nullptr);
+            m_visualItem->deleteLater();
+        }
 
         qDeleteAll(docks);
     }
 }
 
+void FrameQuick::setVisualItem(QQuickItem *visualItem)
+{
+    m_visualItem = visualItem;
+    m_visualItem->setProperty("frameCpp", QVariant::fromValue(this));
+    m_visualItem->setParentItem(this);
+    m_visualItem->setParent(this);
+}
+
+void FrameQuick::onVisualItemIncubated(QQuickItem *visualItem)
+{
+    if (!visualItem) {
+        qWarning() << Q_FUNC_INFO << "Frame's root QML object isn't a QQuickItem";
+        return;
+    }
+
+    setVisualItem(visualItem);
+
+    // The title bar and tab bar exist now, so the min-size grew. And the tab bar starts at index 0.
+    setProperty("kddockwidgets_min_size", minimumSize());
+    Q_EMIT layoutInvalidated();
+    Q_EMIT currentDockWidgetChanged(currentDockWidget());
+    Q_EMIT visualItemChanged();
+}
+
+void FrameQuick::emitFrameGeometryChanged()
+{
+    m_frameGeometryChangePending = false;
+
+    const QRect geometry = QWidgetAdapter::geometry();
+    for (auto dw : dockWidgets())
+        Q_EMIT static_cast<DockWidgetQuick *>(dw)->frameGeometryChanged(geometry);
+}
+
 void FrameQuick::updateConstriants()
 {
     onDockWidgetCountChanged();
@@ -117,7 +193,8 @@ void FrameQuick::insertDockWidget_impl(DockWidgetBase *dw, int index)
 {
     QPointer<Frame> oldFrame = dw->d->frame();
     if (m_tabWidget->insertDockWidget(index, dw, {}, {})) {
-        dw->setParent(m_stackLayout);
+        // m_stackLayout is only null while our visual item is being incubated, see setStackLayout()
+        dw->setParent(m_stackLayout ? m_stackLayout : this);
 
         QMetaObject::Connection conn = connect(dw, &DockWidgetBase::parentChanged, this, [dw, this] {
             if (dw->parent() != m_stackLayout)
@@ -171,6 +248,13 @@ void FrameQuick::setStackLayout(QQuickItem *stackLayout)
     }
 
     m_stackLayout = stackLayout;
+
+    // Dock widgets inserted while our visual item was still being incubated
+    const DockWidgetBase::List docks = dockWidgets();
+    for (DockWidgetBase *dw : docks) {
+        if (dw->parent() == this)
+            dw->setParent(m_stackLayout);
+    }
 }
 
 QSize FrameQuick::minimumSize() const
@@ -201,5 +285,5 @@ QQuickItem *FrameQuick::visualItem() const
 
 int FrameQuick::nonContentsHeight() const
 {
-    return m_visualItem->property("nonContentsHeight").toInt();
+    return m_visualItem ? m_visualItem->property("nonContentsHeight").toInt() : 0;
 }
@@ -17,6 +17,8 @@
 #include "DockWidgetBase.h"
 #include "TabWidgetQuick_p.h"
 
+#include <memory>
+
 class QQuickItem;
 
 namespace KDDockWidgets {
@@ -49,6 +51,8 @@ public:
     TabWidget *tabWidget() const;
 
     /// @brief Returns the QQuickItem which represents this frame on the screen
+    /// nullptr while it's still being created asynchronously.
+    /// @sa FrameworkWidgetFactory::setAsynchronousFrameCreation()
     QQuickItem *visualItem() const;
 
 protected:
@@ -70,12 +74,21 @@ protected:
 Q_SIGNALS:
     void tabTitlesChanged();
 
+    /// @brief Emitted when an asynchronously created visual item is ready
+    void visualItemChanged();
+
 public Q_SLOTS:
     void updateConstriants();
 
 private:
+    class VisualItemIncubator;
+    void setVisualItem(QQuickItem *);
+    void onVisualItemIncubated(QQuickItem *);
+    void emitFrameGeometryChanged();
     QQuickItem *m_stackLayout = nullptr;
     QQuickItem *m_visualItem = nullptr;
+    std::unique_ptr<VisualItemIncubator> m_incubator;
+    bool m_frameGeometryChangePending = false;
     QHash<DockWidgetBase *, QMetaObject::Connection> m_connections; // To make it easy to disconnect from lambdas
 };
 
@@ -20,12 +20,16 @@
 
 #include "QWidgetAdapter.h"
 #include "MainWindowBase.h"
+#include "Config.h"
+#include "FrameworkWidgetFactory.h"
 
 #include "../DockRegistry_p.h"
 #include "../Utils_p.h"
 #include "../FloatingWindow_p.h"
 #include "../multisplitter/Item_p.h"
 
+#include <QDir>
+#include <QMetaProperty>
 #include <QResizeEvent>
 #include <QMouseEvent>
 #include <QQmlComponent>
@@ -45,12 +49,15 @@ namespace KDDockWidgets {
  * @brief Event filter which redirects mouse events from one QObject to another.
  * Needed for QtQuick to redirect the events from MouseArea to our KDDW classes which derive from Draggable.
  * For QtWidgets it's not needed, as the Draggables are QWidgets themselves.
+ *
+ * The source's "enabled" and "cursorPosition" properties are cached and only re-read when they
+ * notify a change, as the filter runs for every mouse move during drags and resizes.
  */
 class MouseEventRedirector : public QObject
 {
     Q_OBJECT
 public:
-    explicit MouseEventRedirector(QObject *eventSource, QObject *eventTarget)
+    explicit MouseEventRedirector(QObject *eventSource, QWidgetAdapter *eventTarget)
         : QObject(eventTarget)
         , m_eventSource(eventSource)
         , m_eventTarget(eventTarget)
@@ -65,6 +72,8 @@ public:
         }
 
         s_mouseEventRedirectors.insert(eventSource, this);
+
+        trackSourceProperties();
     }
 
     static MouseEventRedirector *redirectorForSource(QObject *eventSource)
@@ -74,29 +83,73 @@ public:
 
     ~MouseEventRedirector() override;
 
-    bool eventFilter(QObject *source, QEvent *ev) override
+    bool eventFilter(QObject *, QEvent *ev) override
     {
         QMouseEvent *me = mouseEvent(ev);
         if (!me)
             return false;
 
+        if (m_pollSourceProperties)
+            updateSourceProperties();
+
         // MouseArea.enable is different from Item.enabled. The former still lets the events
-        // go through event loops. So query MouseArea.enable here and bail out if false.
-        const QVariant v = source->property("enabled");
-        if (v.isValid() && !v.toBool())
+        // go through event loops. So bail out if MouseArea.enabled is false.
+        if (!m_sourceEnabled)
             return false;
 
         // Finally send the event
-        m_eventTarget->setProperty("cursorPosition", m_eventSource->property("cursorPosition"));
+        m_eventTarget->m_redirectedCursorPosition = m_sourceCursorPosition;
         qApp->sendEvent(m_eventTarget, me);
-        m_eventTarget->setProperty("cursorPosition", CursorPosition_Undefined);
+        m_eventTarget->m_redirectedCursorPosition = CursorPosition_Undefined;
 
         return false;
     }
 
     QObject *const m_eventSource;
-    QObject *const m_eventTarget;
+    QWidgetAdapter *const m_eventTarget;
     static QHash<QObject *, MouseEventRedirector *> s_mouseEventRedirectors;
+
+private Q_SLOTS:
+    void updateSourceProperties()
+    {
+        m_sourceEnabled = !m_enabledProperty.isValid() || m_enabledProperty.read(m_eventSource).toBool();
+        m_sourceCursorPosition = m_cursorPositionProperty.isValid()
+            ? CursorPosition(m_cursorPositionProperty.read(m_eventSource).toInt())
+            : CursorPosition_Undefined;
+    }
+
+private:
+    void trackSourceProperties()
+    {
+        const QMetaObject *mo = m_eventSource->metaObject();
+        const QMetaMethod updateSlot = staticMetaObject.method(staticMetaObject.indexOfSlot("updateSourceProperties()"));
+
+        auto track = [this, mo, updateSlot](const char *name) {
+            const int index = mo->indexOfProperty(name);
+            if (index == -1)
+                return QMetaProperty();
+
+            const QMetaProperty property = mo->property(index);
+            if (property.hasNotifySignal()) {
+                connect(m_eventSource, property.notifySignal(), this, updateSlot);
+            } else {
+                // Can't know when it changes, so read it for every event
+                m_pollSourceProperties = true;
+            }
+
+            return property;
+        };
+
+        m_enabledProperty = track("enabled");
+        m_cursorPositionProperty = track("cursorPosition");
+        updateSourceProperties();
+    }
+
+    QMetaProperty m_enabledProperty;
+    QMetaProperty m_cursorPositionProperty;
+    CursorPosition m_sourceCursorPosition = CursorPosition_Undefined;
+    bool m_sourceEnabled = true;
+    bool m_pollSourceProperties = false;
 };
 
 QHash<QObject *, MouseEventRedirector *> MouseEventRedirector::s_mouseEventRedirectors = {};
@@ -686,10 +739,12 @@ Qt::WindowFlags QWidgetAdapter::windowFlags() const
 /** static */
 QQuickItem *QWidgetAdapter::createItem(QQmlEngine *engine, const QString &filename)
 {
-    QQmlComponent component(engine, filename);
-    QObject *obj = component.create();
+    // Same as QQmlComponent's QString constructor
+    const QUrl url = QDir::isAbsolutePath(filename) ? QUrl::fromLocalFile(filename) : QUrl(filename);
+    QQmlComponent *component = Config::self().frameworkWidgetFactory()->qmlComponent(engine, url);
+    QObject *obj = component ? component->create() : nullptr;
     if (!obj) {
-        qWarning() << Q_FUNC_INFO << component.errorString();
+        qWarning() << Q_FUNC_INFO << (component ? component->errorString() : filename);
         return nullptr;
     }
 
@@ -831,6 +886,11 @@ void QWidgetAdapter::redirectMouseEvents(QObject *source)
     new MouseEventRedirector(source, this);
 }
 
+CursorPosition QWidgetAdapter::redirectedCursorPosition() const
+{
+    return m_redirectedCursorPosition;
+}
+
 void QWidgetAdapter::setIsWrapper()
 {
     m_isWrapper = true;
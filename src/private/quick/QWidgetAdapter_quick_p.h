@@ -22,6 +22,7 @@
 #define KDDOCKWIDGETS_QWIDGETADAPTERQUICK_P_H
 
 #include "kddockwidgets/docks_export.h"
+#include "kddockwidgets/KDDockWidgets.h"
 #include "kddockwidgets/Qt5Qt6Compat_p.h"
 
 #include <QQuickItem>
@@ -194,6 +195,11 @@ public:
     Q_INVOKABLE void showNormal();
     Q_INVOKABLE void redirectMouseEvents(QObject *from);
 
+    /// @brief Returns the cursor position of the MouseArea whose event is being redirected to us
+    /// Only valid while the redirected event is being delivered, CursorPosition_Undefined otherwise.
+    /// @sa redirectMouseEvents()
+    CursorPosition redirectedCursorPosition() const;
+
     QScreen *screen() const;
     QQuickView *quickView() const;
     QWindow *windowHandle() const;
@@ -269,7 +275,8 @@ private:
     bool m_mouseTrackingEnabled = false;
     bool m_isWrapper = false;
     bool m_inSetParent = false;
-    MouseEventRedirector *m_mouseEventRedirector = nullptr;
+    friend class MouseEventRedirector;
+    CursorPosition m_redirectedCursorPosition = CursorPosition_Undefined;
     QRect m_normalGeometry;
 };
 
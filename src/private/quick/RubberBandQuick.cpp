@@ -10,16 +10,63 @@
 */
 
 #include "RubberBandQuick.h"
-#include "Config.h"
+
+#include <QQuickWindow>
+#include <QSGRectangleNode>
 
 using namespace KDDockWidgets;
 
+namespace {
+
+enum RubberBandNode {
+    RubberBandNode_Fill = 0,
+    RubberBandNode_TopBorder,
+    RubberBandNode_BottomBorder,
+    RubberBandNode_LeftBorder,
+    RubberBandNode_RightBorder,
+    RubberBandNode_Count
+};
+
+const qreal s_borderWidth = 1;
+
+}
+
 RubberBandQuick::RubberBandQuick(QQuickItem *parent)
     : QWidgetAdapter(parent)
 {
     setVisible(false);
     setZ(1000);
-    QQuickItem *visualItem = createItem(Config::self().qmlEngine(), QStringLiteral("qrc:/kddockwidgets/private/quick/qml/RubberBand.qml"));
-    visualItem->setParent(this);
-    visualItem->setParentItem(this);
+    setFlag(QQuickItem::ItemHasContents);
+
+    connect(this, &QQuickItem::widthChanged, this, &QQuickItem::update);
+    connect(this, &QQuickItem::heightChanged, this, &QQuickItem::update);
+}
+
+QSGNode *RubberBandQuick::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    // A translucent fill plus 4 opaque border strips, so the border isn't blended with the fill
+    QSGNode *root = oldNode;
+    if (!root) {
+        root = new QSGNode();
+        for (int i = 0; i < RubberBandNode_Count; ++i) {
+            QSGRectangleNode *node = window()->createRectangleNode();
+            node->setColor(i == RubberBandNode_Fill ? QColor(0x5c, 0xa1, 0xc5, 0x55) : QColor(0x5c, 0xa1, 0xc5));
+            root->appendChildNode(node);
+        }
+    }
+
+    const QRectF rect = boundingRect();
+    const QRectF rects[RubberBandNode_Count] = {
+        rect.adjusted(s_borderWidth, s_borderWidth, -s_borderWidth, -s_borderWidth),
+        QRectF(rect.left(), rect.top(), rect.width(), s_borderWidth),
+        QRectF(rect.left(), rect.bottom() - s_borderWidth, rect.width(), s_borderWidth),
+        QRectF(rect.left(), rect.top() + s_borderWidth, s_borderWidth, rect.height() - 2 * s_borderWidth),
+        QRectF(rect.right() - s_borderWidth, rect.top() + s_borderWidth, s_borderWidth, rect.height() - 2 * s_borderWidth)
+    };
+
+    int i = 0;
+    for (QSGNode *child = root->firstChild(); child; child = child->nextSibling(), ++i)
+        static_cast<QSGRectangleNode *>(child)->setRect(rects[i].isValid() ? rects[i] : QRectF());
+
+    return root;
 }
@@ -16,11 +16,19 @@
 
 namespace KDDockWidgets {
 
+/**
+ * @brief The rubber band which shows where a dock widget would be dropped
+ *
+ * Painted directly with scene-graph nodes, only their rects change while it's moved and resized.
+ */
 class RubberBandQuick : public QWidgetAdapter
 {
     Q_OBJECT
 public:
     explicit RubberBandQuick(QQuickItem *parent = nullptr);
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *, UpdatePaintNodeData *) override;
 };
 
 }
@@ -1,25 +0,0 @@
-/*
-  This file is part of KDDockWidgets.
-
-  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
-  Author: Sérgio Martins <sergio.martins@kdab.com>
-
-  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
-
-  Contact KDAB at <info@kdab.com> for commercial licensing options.
-*/
-
-import QtQuick 2.9
-
-Rectangle {
-    id: root
-    color: "#555ca1c5"
-
-    radius: 1
-    border {
-        color: "#5ca1c5"
-        width: 1
-    }
-
-    anchors.fill: parent
-}
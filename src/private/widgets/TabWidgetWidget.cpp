@@ -22,6 +22,7 @@
 #include "../Frame_p.h"
 #include "../TitleBar_p.h"
 #include "../DockRegistry_p.h"
+#include "../IconCache_p.h"
 
 #include <QMouseEvent>
 #include <QTabBar>
@@ -136,7 +137,7 @@ void TabWidgetWidget::setCurrentDockWidget(int index)
 bool TabWidgetWidget::insertDockWidget(int index, DockWidgetBase *dw,
                                        const QIcon &icon, const QString &title)
 {
-    insertTab(index, dw, icon, title);
+    insertTab(index, dw, cachedIcon(icon), title);
     return true;
 }
 
@@ -152,7 +153,7 @@ void TabWidgetWidget::renameTab(int index, const QString &text)
 
 void TabWidgetWidget::changeTabIcon(int index, const QIcon &icon)
 {
-    setTabIcon(index, icon);
+    setTabIcon(index, cachedIcon(icon));
 }
 
 DockWidgetBase *TabWidgetWidget::dockwidgetAt(int index) const
@@ -208,6 +209,13 @@ void TabWidgetWidget::updateMargins()
     m_cornerWidgetLayout->setSpacing(int(2 * factor));
 }
 
+QIcon TabWidgetWidget::cachedIcon(const QIcon &icon) const
+{
+    // All tabs showing the same icon share the same pixmaps, and QStyle's cache also hits, as it's keyed by QIcon::cacheKey()
+    // The pixmaps are per size and DPR, so there's nothing to update when moving to another screen
+    return IconCache::self()->icon(icon);
+}
+
 void TabWidgetWidget::showContextMenu(QPoint pos)
 {
     if (!(Config::self().flags() & Config::Flag_AllowSwitchingTabsViaMenu))
@@ -71,6 +71,7 @@ protected:
 
 private:
     void updateMargins();
+    QIcon cachedIcon(const QIcon &) const;
     void setupTabBarButtons();
     Q_DISABLE_COPY(TabWidgetWidget)
     TabBar *const m_tabBar;
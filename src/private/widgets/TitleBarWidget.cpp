@@ -17,6 +17,7 @@
 #include "../WindowBeingDragged_p.h"
 #include "../Utils_p.h"
 #include "../DockRegistry_p.h"
+#include "../IconCache_p.h"
 
 #include "FrameworkWidgetFactory.h"
 
@@ -156,12 +157,7 @@ void TitleBarWidget::init()
     });
 
     connect(this, &TitleBar::iconChanged, this, [this] {
-        if (icon().isNull()) {
-            m_dockWidgetIcon->setPixmap(QPixmap());
-        } else {
-            const QPixmap pix = icon().pixmap(QSize(28, 28));
-            m_dockWidgetIcon->setPixmap(pix);
-        }
+        updateIconPixmap();
         update();
     });
 
@@ -174,8 +170,10 @@ void TitleBarWidget::init()
     m_floatButton->setToolTip(floatButtonToolTip());
 
     connect(DockRegistry::self(), &DockRegistry::windowChangedScreen, this, [this](QWindow *w) {
-        if (w == window()->windowHandle())
+        if (w == window()->windowHandle()) {
             updateMargins();
+            updateIconPixmap();
+        }
     });
 }
 
@@ -186,6 +184,12 @@ void TitleBarWidget::updateMargins()
     m_layout->setSpacing(int(2 * factor));
 }
 
+void TitleBarWidget::updateIconPixmap()
+{
+    // Shared, as usually many title bars show the same icon
+    m_dockWidgetIcon->setPixmap(IconCache::self()->pixmap(icon(), QSize(28, 28), devicePixelRatioF()));
+}
+
 QSize TitleBarWidget::sizeHint() const
 {
     // Pass an opt so it scales against the logical dpi of the correct screen (since Qt 5.14) even if the HDPI Qt::AA_ attributes are off.
@@ -64,6 +64,7 @@ protected:
     void init();
     int buttonAreaWidth() const;
     void updateMargins();
+    void updateIconPixmap();
     QRect iconRect() const;
 
     QHBoxLayout *const m_layout;
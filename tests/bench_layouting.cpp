@@ -0,0 +1,390 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+// Replays the same layouting trace against a Widget_null host, which measures the engine alone,
+// and against the host of the frontend we were built for (QtWidgets or QtQuick).
+// The difference between both rows is what the frontend costs. Time spent applying geometries
+// to the guests is reported separately.
+//
+// Usage: bench_layouting [-iterations N] [-seed N] [-ops N]
+
+// clazy:excludeall=missing-qobject-macro,non-pod-global-static
+
+#include "Config.h"
+#include "kddockwidgets/QWidgetAdapter.h"
+#include "private/multisplitter/Item_p.h"
+#include "private/multisplitter/Separator_p.h"
+#include "private/multisplitter/Widget_null.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QtTest/QtTest>
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+#include <QApplication>
+#else
+#include <QGuiApplication>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#endif
+
+#include <memory>
+
+using namespace Layouting;
+using namespace KDDockWidgets;
+
+enum class Host {
+    Null,
+    Frontend
+};
+
+struct GeometryStats
+{
+    int calls = 0;
+    qint64 nsecs = 0;
+};
+
+static GeometryStats s_geometryStats;
+
+// Each trace operation picks its target by index, modulo whatever exists when it's replayed.
+// The engine is frontend agnostic, so the layout evolves identically on every host.
+struct Operation
+{
+    enum Type {
+        Insert,
+        Remove,
+        MoveSeparator,
+        ResizeRoot
+    };
+
+    Type type = Insert;
+    int target = 0;
+    Location location = Location_OnLeft;
+    int amount = 0;
+    QSize size;
+};
+
+typedef QVector<Operation> Trace;
+
+class NullWidget : public Widget_null
+{
+    Q_OBJECT
+public:
+    using Widget_null::Widget_null;
+
+    void setGeometry(QRect rect) override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        Widget_null::setGeometry(rect);
+        s_geometryStats.nsecs += timer.nsecsElapsed();
+        s_geometryStats.calls++;
+    }
+};
+
+class FrontendWidget : public LayoutGuestWidget
+{
+    Q_OBJECT
+public:
+    explicit FrontendWidget(QWidgetOrQuick *parent = nullptr)
+        : LayoutGuestWidget(parent)
+    {
+    }
+
+    void setGeometry(QRect rect) override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        LayoutGuestWidgetBase::setGeometry(rect);
+        s_geometryStats.nsecs += timer.nsecsElapsed();
+        s_geometryStats.calls++;
+    }
+
+Q_SIGNALS:
+    void layoutInvalidated();
+};
+
+static const int s_maxItems = 10;
+static const QSize s_initialRootSize(1600, 1200);
+
+class BenchLayouting : public QObject
+{
+    Q_OBJECT
+public:
+    int m_seed = 2023;
+    int m_numOps = 1000;
+
+private Q_SLOTS:
+    void initTestCase();
+    void bench_trace_data();
+    void bench_trace();
+
+private:
+    static Trace createTrace(int seed, int numOps);
+    Widget *createHost(Host) const;
+    Widget *createGuest(Host, QSize minSize) const;
+    QVector<QRect> replay(Host, const Trace &) const;
+
+    QVector<QRect> m_nullGeometries;
+#ifdef KDDOCKWIDGETS_QTQUICK
+    QQmlEngine *m_qmlEngine = nullptr;
+    QQuickItem *m_quickRootItem = nullptr;
+#endif
+};
+
+void BenchLayouting::initTestCase()
+{
+    // Config installs the frontend's separator factory. Widget_null hosts always get a SeparatorNull
+    KDDockWidgets::Config::self();
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+    // Separators are QML items, they need to find an engine in their parent hierarchy
+    m_qmlEngine = new QQmlEngine(this);
+    QQmlComponent component(m_qmlEngine);
+    component.setData("import QtQuick 2.9\nItem {}", QUrl());
+    m_quickRootItem = qobject_cast<QQuickItem *>(component.create());
+    QVERIFY(m_quickRootItem);
+    m_quickRootItem->setParent(this);
+#endif
+}
+
+void BenchLayouting::bench_trace_data()
+{
+    QTest::addColumn<int>("hostType");
+
+    // null goes first, the frontend's layout is compared against it
+    QTest::newRow("null") << int(Host::Null);
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    QTest::newRow("qtwidgets") << int(Host::Frontend);
+#else
+    QTest::newRow("qtquick") << int(Host::Frontend);
+#endif
+}
+
+void BenchLayouting::bench_trace()
+{
+    QFETCH(int, hostType);
+    const auto host = Host(hostType);
+
+    const Trace trace = createTrace(m_seed, m_numOps);
+
+    // Warm up, and check we're comparing the same layouts
+    const QVector<QRect> geometries = replay(host, trace);
+    if (host == Host::Null)
+        m_nullGeometries = geometries;
+    else if (!m_nullGeometries.isEmpty())
+        QCOMPARE(geometries, m_nullGeometries);
+
+    s_geometryStats = {};
+    qint64 totalNSecs = 0;
+    int numReplays = 0;
+
+    QBENCHMARK {
+        QElapsedTimer timer;
+        timer.start();
+        replay(host, trace);
+        totalNSecs += timer.nsecsElapsed();
+        numReplays++;
+    }
+
+    const double totalMs = totalNSecs / 1000000.0 / numReplays;
+    const double geometryMs = s_geometryStats.nsecs / 1000000.0 / numReplays;
+    qInfo().noquote() << QStringLiteral("%1: %2 ops in %3 ms; guest geometry application: %4 ms (%5%) in %6 calls; engine and rest: %7 ms")
+                             .arg(QString::fromLatin1(QTest::currentDataTag()))
+                             .arg(trace.size())
+                             .arg(totalMs, 0, 'f', 3)
+                             .arg(geometryMs, 0, 'f', 3)
+                             .arg(totalMs > 0 ? 100.0 * geometryMs / totalMs : 0.0, 0, 'f', 1)
+                             .arg(s_geometryStats.calls / numReplays)
+                             .arg(totalMs - geometryMs, 0, 'f', 3);
+}
+
+Trace BenchLayouting::createTrace(int seed, int numOps)
+{
+    QRandomGenerator rng(quint32(seed));
+
+    Trace trace;
+    trace.reserve(numOps);
+    for (int i = 0; i < numOps; ++i) {
+        Operation op;
+        const int dice = rng.bounded(100);
+        if (dice < 40) {
+            op.type = Operation::Insert;
+            op.location = Location(rng.bounded(int(Location_OnLeft), int(Location_OnBottom) + 1));
+            op.size = QSize(rng.bounded(80, 150), rng.bounded(90, 150));
+        } else if (dice < 60) {
+            op.type = Operation::Remove;
+        } else if (dice < 90) {
+            op.type = Operation::MoveSeparator;
+            op.amount = rng.bounded(-200, 200);
+        } else {
+            op.type = Operation::ResizeRoot;
+            op.size = QSize(rng.bounded(800, 2000), rng.bounded(600, 1500));
+        }
+
+        op.target = rng.bounded(1000);
+        trace.push_back(op);
+    }
+
+    return trace;
+}
+
+Widget *BenchLayouting::createHost(Host host) const
+{
+    Widget *widget = nullptr;
+    if (host == Host::Null) {
+        widget = new NullWidget();
+    } else {
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+        auto frontendWidget = new FrontendWidget();
+        frontendWidget->QWidget::show();
+#else
+        auto frontendWidget = new FrontendWidget(m_quickRootItem);
+#endif
+        widget = frontendWidget;
+    }
+
+    widget->setSize(s_initialRootSize.width(), s_initialRootSize.height());
+    return widget;
+}
+
+Widget *BenchLayouting::createGuest(Host host, QSize minSize) const
+{
+    if (host == Host::Null) {
+        auto guest = new NullWidget();
+        guest->setMinSize(minSize);
+        return guest;
+    }
+
+    auto guest = new FrontendWidget();
+    guest->setMinimumSize(minSize);
+    return guest;
+}
+
+QVector<QRect> BenchLayouting::replay(Host host, const Trace &trace) const
+{
+    Widget *hostWidget = createHost(host);
+    auto root = std::unique_ptr<ItemBoxContainer>(new ItemBoxContainer(hostWidget));
+    root->setSize(s_initialRootSize);
+
+    Item::List items;
+    for (const Operation &op : trace) {
+        Operation::Type type = op.type;
+        if (type == Operation::Insert && items.size() >= s_maxItems)
+            type = Operation::Remove;
+
+        switch (type) {
+        case Operation::Insert: {
+            auto item = new Item(hostWidget);
+            item->setGeometry(QRect(0, 0, 200, 200));
+            item->setGuestWidget(createGuest(host, op.size));
+            if (items.isEmpty()) {
+                root->insertItem(item, op.location);
+            } else {
+                ItemBoxContainer::insertItemRelativeTo(item, items.at(op.target % items.size()), op.location);
+            }
+            items.push_back(item);
+            break;
+        }
+        case Operation::Remove: {
+            if (items.isEmpty())
+                break;
+
+            Item *item = items.takeAt(op.target % items.size());
+            Widget *guest = item->guestWidget();
+            root->removeItem(item);
+            delete guest->asQObject();
+            break;
+        }
+        case Operation::MoveSeparator: {
+            const QVector<Separator *> separators = root->separators_recursive();
+            if (separators.isEmpty())
+                break;
+
+            Separator *separator = separators.at(op.target % separators.size());
+            ItemBoxContainer *container = separator->parentContainer();
+            const int min = container->minPosForSeparator_global(separator);
+            const int max = container->maxPosForSeparator_global(separator);
+            const int pos = separator->position();
+            if (min > max)
+                break;
+
+            const int delta = qBound(min, pos + op.amount, max) - pos;
+            if (delta != 0)
+                container->requestSeparatorMove(separator, delta);
+            break;
+        }
+        case Operation::ResizeRoot: {
+            const QSize size = op.size.expandedTo(root->minSize());
+            hostWidget->setSize(size.width(), size.height());
+            root->setSize(size);
+            break;
+        }
+        }
+    }
+
+    QVector<QRect> geometries;
+    geometries.reserve(items.size());
+    for (Item *item : qAsConst(items))
+        geometries.push_back(item->mapToRoot(item->rect()));
+
+    root.reset();
+    delete hostWidget->asQObject();
+
+    return geometries;
+}
+
+int main(int argc, char *argv[])
+{
+    bool qpaPassed = false;
+    int seed = -1;
+    int numOps = -1;
+
+    // Our own arguments, the rest is for QTest
+    QVector<char *> args;
+    for (int i = 0; i < argc; ++i) {
+        if (qstrcmp(argv[i], "-platform") == 0) {
+            qpaPassed = true;
+        } else if (qstrcmp(argv[i], "-seed") == 0 && i + 1 < argc) {
+            seed = QByteArray(argv[++i]).toInt();
+            continue;
+        } else if (qstrcmp(argv[i], "-ops") == 0 && i + 1 < argc) {
+            numOps = QByteArray(argv[++i]).toInt();
+            continue;
+        }
+
+        args.push_back(argv[i]);
+    }
+
+    if (!qpaPassed) {
+        // Use offscreen by default as it's less annoying, doesn't create visible windows
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    int qtArgc = args.size();
+    args.push_back(nullptr);
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    QApplication app(qtArgc, args.data());
+#else
+    QGuiApplication app(qtArgc, args.data());
+#endif
+
+    BenchLayouting bench;
+    if (seed >= 0)
+        bench.m_seed = seed;
+    if (numOps > 0)
+        bench.m_numOps = numOps;
+
+    return QTest::qExec(&bench, qtArgc, args.data());
+}
+
+#include "bench_layouting.moc"
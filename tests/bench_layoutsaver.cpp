@@ -0,0 +1,374 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+// Measures saving and restoring synthetic layouts of several sizes and shapes: LayoutSaver::serializeLayout(),
+// LayoutSaver::Layout::fromJson(), the restore itself and how many bytes the layout takes.
+// Each step runs several times and the fastest run is kept, see LayoutLinter::statsForJson().
+//
+// Layout sizes are compared against bench_layoutsaver_baselines.json, which is committed. They don't depend
+// on the machine, but they do on the frontend and on the Qt major version (number formatting, screen info),
+// so the file has one set of sizes per frontend and Qt version. A row fails if its size grew by more than
+// the threshold, and is skipped if its frontend and Qt version weren't recorded yet.
+//
+// Timings depend on the machine, so their baselines live in the build directory instead and a row fails
+// if any timing regressed by more than the threshold. CI records them on its runner with -update-baselines,
+// from the target branch, and keeps that file (or passes it with -timing-baselines) for the runs which
+// test changes. Without timing baselines only the sizes are compared.
+//
+// -update-baselines writes both files.
+//
+// Usage: bench_layoutsaver [-iterations N] [-threshold percent] [-baselines file] [-timing-baselines file]
+//                          [-update-baselines]
+
+// clazy:excludeall=missing-qobject-macro,non-pod-global-static
+
+#include "utils.h"
+#include "LayoutSaver.h"
+#include "private/LayoutLinter_p.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QtTest/QtTest>
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+#include <QQmlEngine>
+#include <QQuickStyle>
+#endif
+
+#include <cmath>
+#include <limits>
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::Tests;
+
+namespace {
+
+enum class Shape {
+    Grid, ///< Frames in columns, all in the main window
+    Nested, ///< Each frame nested next to the previous one, alternating orientation
+    Floating ///< Each frame in its own floating window
+};
+
+// Below this, timings are too short for a relative threshold to mean anything
+const double s_minRegressionMs = 0.5;
+
+}
+
+class BenchLayoutSaver : public QObject
+{
+    Q_OBJECT
+public:
+    int m_iterations = 5;
+    double m_thresholdPercent = 25;
+    QString m_baselinesFile = QStringLiteral(KDDW_LAYOUTSAVER_BASELINES);
+    QString m_timingBaselinesFile = QStringLiteral(KDDW_LAYOUTSAVER_TIMING_BASELINES);
+    bool m_updateBaselines = false;
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void bench_saveRestore_data();
+    void bench_saveRestore();
+
+private:
+    static std::unique_ptr<MainWindowBase> createLayout(const QString &name, Shape, int numDockWidgets,
+                                                        int tabsPerFrame, int numClosed);
+    QStringList regressions(const QString &row, const QVariantMap &timings) const;
+    static QVariantMap readBaselines(const QString &filename);
+    static void writeBaselines(const QString &filename, const QVariantMap &baselines);
+
+    static QString sizeBaselinesKey();
+
+    QVariantMap m_baselines; ///< frontend and Qt version -> row -> bytes
+    QVariantMap m_timingBaselines; ///< row -> timings
+};
+
+void BenchLayoutSaver::initTestCase()
+{
+    qApp->setOrganizationName("KDAB");
+    qApp->setApplicationName("dockwidgets-layoutsaver-bench");
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+    QQuickStyle::setStyle("Material"); // so we don't load KDE plugins
+    KDDockWidgets::Config::self().setQmlEngine(new QQmlEngine(this));
+#endif
+
+    // Also read when updating, so updating only some rows keeps the others
+    m_baselines = readBaselines(m_baselinesFile);
+    m_timingBaselines = readBaselines(m_timingBaselinesFile);
+    if (m_timingBaselines.isEmpty() && !m_updateBaselines)
+        qInfo().noquote() << QStringLiteral("No timing baselines in %1, only sizes will be compared. Record them with -update-baselines").arg(m_timingBaselinesFile);
+}
+
+void BenchLayoutSaver::cleanupTestCase()
+{
+    if (m_updateBaselines) {
+        writeBaselines(m_baselinesFile, m_baselines);
+        writeBaselines(m_timingBaselinesFile, m_timingBaselines);
+    }
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+    delete KDDockWidgets::Config::self().qmlEngine();
+#endif
+}
+
+void BenchLayoutSaver::bench_saveRestore_data()
+{
+    QTest::addColumn<int>("shape");
+    QTest::addColumn<int>("numDockWidgets");
+    QTest::addColumn<int>("tabsPerFrame");
+    QTest::addColumn<int>("numClosed");
+
+    QTest::newRow("docks-10") << int(Shape::Grid) << 10 << 1 << 0;
+    QTest::newRow("docks-100") << int(Shape::Grid) << 100 << 4 << 0;
+    QTest::newRow("docks-1000") << int(Shape::Grid) << 1000 << 8 << 0;
+    QTest::newRow("nested-depth-30") << int(Shape::Nested) << 30 << 1 << 0;
+    QTest::newRow("floating-50") << int(Shape::Floating) << 100 << 2 << 0;
+    QTest::newRow("closed-90-of-100") << int(Shape::Grid) << 100 << 1 << 90;
+}
+
+void BenchLayoutSaver::bench_saveRestore()
+{
+    QFETCH(int, shape);
+    QFETCH(int, numDockWidgets);
+    QFETCH(int, tabsPerFrame);
+    QFETCH(int, numClosed);
+
+    EnsureTopLevelsDeleted e;
+    const QString row = QString::fromLatin1(QTest::currentDataTag());
+    auto m = createLayout(row, Shape(shape), numDockWidgets, tabsPerFrame, numClosed);
+
+    qint64 serializeNSecs = std::numeric_limits<qint64>::max();
+    QByteArray json;
+    for (int i = 0; i < m_iterations; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        LayoutSaver saver;
+        json = saver.serializeLayout();
+        serializeNSecs = qMin(serializeNSecs, timer.nsecsElapsed());
+    }
+
+    // Restores into the windows we just saved, like an application restoring at startup
+    qint64 fromJsonNSecs = std::numeric_limits<qint64>::max();
+    qint64 restoreNSecs = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < m_iterations; ++i) {
+        const LayoutLinter::Stats stats = LayoutLinter::statsForJson(json, row);
+        QVERIFY2(stats.success, qPrintable(stats.errors.join(QLatin1Char('\n'))));
+        QCOMPARE(stats.numPlaceholders, numClosed);
+        fromJsonNSecs = qMin(fromJsonNSecs, stats.parseNSecs);
+        restoreNSecs = qMin(restoreNSecs, stats.restoreNSecs);
+    }
+
+    QVariantMap timings;
+    timings.insert(QStringLiteral("serializeMs"), serializeNSecs / 1000000.0);
+    timings.insert(QStringLiteral("fromJsonMs"), fromJsonNSecs / 1000000.0);
+    timings.insert(QStringLiteral("restoreMs"), restoreNSecs / 1000000.0);
+
+    qInfo().noquote() << QStringLiteral("%1: %2 bytes; serializeLayout: %3 ms; Layout::fromJson: %4 ms; restoreLayout: %5 ms")
+                             .arg(row)
+                             .arg(json.size())
+                             .arg(serializeNSecs / 1000000.0, 0, 'f', 3)
+                             .arg(fromJsonNSecs / 1000000.0, 0, 'f', 3)
+                             .arg(restoreNSecs / 1000000.0, 0, 'f', 3);
+
+    QVariantMap sizes = m_baselines.value(sizeBaselinesKey()).toMap();
+    if (m_updateBaselines) {
+        sizes.insert(row, int(json.size()));
+        m_baselines.insert(sizeBaselinesKey(), sizes);
+        m_timingBaselines.insert(row, timings);
+        return;
+    }
+
+    QStringList regressed = regressions(row, timings);
+    if (sizes.contains(row)) {
+        const int baselineBytes = sizes.value(row).toInt();
+        if (json.size() > baselineBytes * (1.0 + m_thresholdPercent / 100.0))
+            regressed.push_back(QStringLiteral("bytes regressed from %1 to %2").arg(baselineBytes).arg(json.size()));
+    }
+
+    if (!regressed.isEmpty())
+        QFAIL(qPrintable(regressed.join(QStringLiteral("; "))));
+
+    if (!sizes.contains(row))
+        QSKIP(qPrintable(QStringLiteral("No %1 size baseline in %2, record it with -update-baselines").arg(sizeBaselinesKey(), m_baselinesFile)));
+}
+
+std::unique_ptr<MainWindowBase> BenchLayoutSaver::createLayout(const QString &name, Shape shape, int numDockWidgets,
+                                                                int tabsPerFrame, int numClosed)
+{
+    const QString mainWindowName = QStringLiteral("MainWindow-%1").arg(name);
+    auto m = createMainWindow(QSize(1000, 800), MainWindowOption_None, mainWindowName);
+
+    const int numFrames = (numDockWidgets + tabsPerFrame - 1) / tabsPerFrame;
+    const int numColumns = qMax(1, int(std::ceil(std::sqrt(double(numFrames)))));
+
+    QVector<DockWidgetBase *> dockWidgets;
+    QVector<DockWidgetBase *> frameHeads; // the first dock widget of each frame
+    for (int i = 0; i < numDockWidgets; ++i) {
+        auto dw = createDockWidget(QStringLiteral("%1-dock-%2").arg(name).arg(i), new MyWidget2(QSize(50, 50)),
+                                   {}, {}, /*show=*/false);
+        dockWidgets.push_back(dw);
+
+        if (i % tabsPerFrame != 0) {
+            frameHeads.last()->addDockWidgetAsTab(dw);
+            continue;
+        }
+
+        const int frameIndex = frameHeads.size();
+        frameHeads.push_back(dw);
+
+        switch (shape) {
+        case Shape::Grid:
+            if (frameIndex < numColumns) {
+                m->addDockWidget(dw, Location_OnRight);
+            } else {
+                m->addDockWidget(dw, Location_OnBottom, frameHeads.at(frameIndex - numColumns));
+            }
+            break;
+        case Shape::Nested:
+            if (frameIndex == 0) {
+                m->addDockWidget(dw, Location_OnLeft);
+            } else {
+                m->addDockWidget(dw, frameIndex % 2 ? Location_OnRight : Location_OnBottom, frameHeads.at(frameIndex - 1));
+            }
+            break;
+        case Shape::Floating:
+            dw->show();
+            break;
+        }
+    }
+
+    // Closed dock widgets leave a placeholder behind, so they can be restored to where they were
+    for (int i = 0; i < numClosed; ++i)
+        dockWidgets.at(i)->close();
+
+    return m;
+}
+
+QStringList BenchLayoutSaver::regressions(const QString &row, const QVariantMap &timings) const
+{
+    QStringList regressed;
+    const QVariantMap baseline = m_timingBaselines.value(row).toMap();
+    if (baseline.isEmpty())
+        return regressed;
+
+    const double factor = 1.0 + m_thresholdPercent / 100.0;
+    for (auto it = timings.cbegin(), end = timings.cend(); it != end; ++it) {
+        if (!baseline.contains(it.key()))
+            continue;
+
+        const double value = it.value().toDouble();
+        const double baselineValue = baseline.value(it.key()).toDouble();
+        if (value - baselineValue < s_minRegressionMs)
+            continue;
+
+        if (value > baselineValue * factor) {
+            regressed.push_back(QStringLiteral("%1 regressed from %2 to %3")
+                                    .arg(it.key())
+                                    .arg(baselineValue)
+                                    .arg(value));
+        }
+    }
+
+    return regressed;
+}
+
+QString BenchLayoutSaver::sizeBaselinesKey()
+{
+#ifdef KDDOCKWIDGETS_QTQUICK
+    return QStringLiteral("qtquick-qt%1").arg(QT_VERSION_MAJOR);
+#else
+    return QStringLiteral("qtwidgets-qt%1").arg(QT_VERSION_MAJOR);
+#endif
+}
+
+QVariantMap BenchLayoutSaver::readBaselines(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    return QJsonDocument::fromJson(file.readAll()).toVariant().toMap();
+}
+
+void BenchLayoutSaver::writeBaselines(const QString &filename, const QVariantMap &baselines)
+{
+    QFile file(filename);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(QJsonDocument::fromVariant(baselines).toJson());
+        qInfo().noquote() << QStringLiteral("Baselines written to %1").arg(filename);
+    } else {
+        qWarning() << "Couldn't write baselines to" << filename;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    bool qpaPassed = false;
+    int iterations = -1;
+    double threshold = -1;
+    QString baselinesFile;
+    QString timingBaselinesFile;
+    bool updateBaselines = false;
+
+    // Our own arguments, the rest is for QTest
+    QVector<char *> args;
+    for (int i = 0; i < argc; ++i) {
+        if (qstrcmp(argv[i], "-platform") == 0) {
+            qpaPassed = true;
+        } else if (qstrcmp(argv[i], "-iterations") == 0 && i + 1 < argc) {
+            iterations = QByteArray(argv[++i]).toInt();
+            continue;
+        } else if (qstrcmp(argv[i], "-threshold") == 0 && i + 1 < argc) {
+            threshold = QByteArray(argv[++i]).toDouble();
+            continue;
+        } else if (qstrcmp(argv[i], "-baselines") == 0 && i + 1 < argc) {
+            baselinesFile = QString::fromLocal8Bit(argv[++i]);
+            continue;
+        } else if (qstrcmp(argv[i], "-timing-baselines") == 0 && i + 1 < argc) {
+            timingBaselinesFile = QString::fromLocal8Bit(argv[++i]);
+            continue;
+        } else if (qstrcmp(argv[i], "-update-baselines") == 0) {
+            updateBaselines = true;
+            continue;
+        }
+
+        args.push_back(argv[i]);
+    }
+
+    if (!qpaPassed) {
+        // Use offscreen by default as it's less annoying, doesn't create visible windows
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    int qtArgc = args.size();
+    args.push_back(nullptr);
+    QApplication app(qtArgc, args.data());
+    if (shouldSkipTests())
+        return 0;
+
+    BenchLayoutSaver bench;
+    if (iterations > 0)
+        bench.m_iterations = iterations;
+    if (threshold >= 0)
+        bench.m_thresholdPercent = threshold;
+    if (!baselinesFile.isEmpty())
+        bench.m_baselinesFile = baselinesFile;
+    if (!timingBaselinesFile.isEmpty())
+        bench.m_timingBaselinesFile = timingBaselinesFile;
+    bench.m_updateBaselines = updateBaselines;
+
+    return QTest::qExec(&bench, qtArgc, args.data());
+}
+
+#include "bench_layoutsaver.moc"
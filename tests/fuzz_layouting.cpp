@@ -0,0 +1,623 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+// Fuzzes the layouting engine alone, without any widget. Each input is a byte stream decoded into
+// engine operations (insert, remove, restore, separator moves, resizes, size constraint changes and
+// serialization round-trips) on an ItemBoxContainer hosted by a Widget_null. After every operation
+// the layout is verified with checkSanity() and with the properties any layout must have:
+// min sizes are honoured, items and separators don't overlap and, together, they cover the root.
+//
+// Any warning is a failure too. On failure the operation and the layout are printed and we abort.
+//
+// By default inputs are random and generated for a given amount of time. Failing inputs are saved
+// as fuzz_layouting-<hash>.bin and can be replayed by passing them as arguments. If the engine itself
+// crashes, the input is saved as fuzz_layouting-crash.bin instead.
+// Built with -DKDDockWidgets_LIBFUZZER=ON there's no main() and libFuzzer drives the inputs instead.
+//
+// Usage: fuzz_layouting [-seconds N] [-seed N] [file...]
+
+// clazy:excludeall=non-pod-global-static
+
+#include "private/multisplitter/Item_p.h"
+#include "private/multisplitter/MultiSplitterConfig.h"
+#include "private/multisplitter/Separator_p.h"
+#include "private/multisplitter/Widget_null.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRandomGenerator>
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+using namespace Layouting;
+using namespace KDDockWidgets;
+
+namespace {
+
+enum Operation {
+    Operation_Insert,
+    Operation_InsertRelativeTo,
+    Operation_Remove,
+    Operation_Restore,
+    Operation_MoveSeparator,
+    Operation_SetSize,
+    Operation_ChangeConstraints,
+    Operation_RoundTrip,
+    Operation_Count
+};
+
+const char *operationName(int op)
+{
+    switch (op) {
+    case Operation_Insert:
+        return "Insert";
+    case Operation_InsertRelativeTo:
+        return "InsertRelativeTo";
+    case Operation_Remove:
+        return "Remove";
+    case Operation_Restore:
+        return "Restore";
+    case Operation_MoveSeparator:
+        return "MoveSeparator";
+    case Operation_SetSize:
+        return "SetSize";
+    case Operation_ChangeConstraints:
+        return "ChangeConstraints";
+    case Operation_RoundTrip:
+        return "RoundTrip";
+    }
+
+    return "?";
+}
+
+const int s_maxLeaves = 24;
+const QSize s_initialRootSize(1000, 800);
+
+/// Decodes the input. Once it runs out, everything reads as 0 and atEnd() is true
+class InputReader
+{
+public:
+    InputReader(const uchar *data, int size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    bool atEnd() const
+    {
+        return m_pos >= m_size;
+    }
+
+    int byte()
+    {
+        return atEnd() ? 0 : m_data[m_pos++];
+    }
+
+    ///@brief Returns a value in [min, max]
+    int bounded(int min, int max)
+    {
+        const int value = (byte() << 8) | byte();
+        return min + value % (max - min + 1);
+    }
+
+private:
+    const uchar *const m_data;
+    const int m_size;
+    int m_pos = 0;
+};
+
+/// Owns the root and its host. Guests are children of the host, so they're deleted after the items
+struct FuzzLayout
+{
+    FuzzLayout()
+        : host(new Widget_null())
+        , root(new ItemBoxContainer(host))
+    {
+    }
+
+    ~FuzzLayout()
+    {
+        root.reset();
+        delete host;
+    }
+
+    Widget_null *const host;
+    std::unique_ptr<ItemBoxContainer> root;
+    Q_DISABLE_COPY(FuzzLayout)
+};
+
+QByteArray s_currentInput;
+QStringList s_warnings;
+bool s_saveFailingInputs = false;
+volatile std::sig_atomic_t s_failingInputSaved = false;
+const char s_crashInputFilename[] = "fuzz_layouting-crash.bin";
+
+void messageHandler(QtMsgType type, const QMessageLogContext &, const QString &message)
+{
+    // The engine is verbose at debug level, only warnings tell something is wrong
+    if (type == QtDebugMsg || type == QtInfoMsg)
+        return;
+
+    s_warnings.push_back(message);
+    if (type == QtFatalMsg) {
+        std::cerr << qPrintable(message) << "\n";
+        std::abort();
+    }
+}
+
+Item::List leaves(ItemBoxContainer *root)
+{
+    Item::List result;
+    const Item::List items = root->items_recursive();
+    for (Item *item : items) {
+        if (!item->isContainer())
+            result.push_back(item);
+    }
+
+    return result;
+}
+
+Item::List filtered(const Item::List &items, bool visible)
+{
+    Item::List result;
+    for (Item *item : items) {
+        if (item->isVisible() == visible)
+            result.push_back(item);
+    }
+
+    return result;
+}
+
+Widget_null *createGuest(InputReader &input, Widget_null *host)
+{
+    auto guest = new Widget_null(host);
+    guest->setMinSize(QSize(input.bounded(20, 300), input.bounded(20, 300)));
+    if (input.byte() % 4 == 0)
+        guest->setMaxSizeHint(guest->minSize() + QSize(input.bounded(0, 400), input.bounded(0, 400)));
+    return guest;
+}
+
+Location location(InputReader &input)
+{
+    return Location(Location_OnLeft + input.byte() % 4);
+}
+
+/// Returns why the layout is wrong, or an empty string if it's fine
+QString verify(ItemBoxContainer *root)
+{
+    if (!root->checkSanity())
+        return QStringLiteral("checkSanity() failed");
+
+    const QRect rootRect = root->rect();
+    QVector<QRect> rects;
+    qint64 area = 0;
+
+    const Item::List visibleLeaves = filtered(leaves(root), /*visible=*/true);
+    for (Item *item : visibleLeaves) {
+        const QSize size = item->size();
+        const QSize minSize = item->minSize();
+        if (size.width() < minSize.width() || size.height() < minSize.height())
+            return QStringLiteral("%1 is smaller than its min size %2x%3").arg(item->displayName()).arg(minSize.width()).arg(minSize.height());
+
+        const QRect rect = item->mapToRoot(item->rect());
+        if (!rootRect.contains(rect))
+            return QStringLiteral("%1 is outside of the root").arg(item->displayName());
+
+        rects.push_back(rect);
+        area += qint64(rect.width()) * rect.height();
+    }
+
+    const QVector<Separator *> separators = root->separators_recursive();
+    for (Separator *separator : separators) {
+        const QRect rect = separator->geometry();
+        if (!rootRect.contains(rect))
+            return QStringLiteral("A separator is outside of the root");
+
+        rects.push_back(rect);
+        area += qint64(rect.width()) * rect.height();
+    }
+
+    for (int i = 0; i < rects.size(); ++i) {
+        for (int j = i + 1; j < rects.size(); ++j) {
+            if (rects.at(i).intersects(rects.at(j)))
+                return QStringLiteral("Overlapping items or separators");
+        }
+    }
+
+    // Without overlaps, matching areas means there are no gaps either
+    if (!visibleLeaves.isEmpty() && area != qint64(rootRect.width()) * rootRect.height())
+        return QStringLiteral("Items and separators don't cover the root");
+
+    return {};
+}
+
+/// Serializes the layout and restores it on a new host, with new guests. Returns the new layout
+/// if the restored items have the same geometries, or nullptr after filling @p error
+FuzzLayout *roundTrip(FuzzLayout *layout, QString &error)
+{
+    const QVariantMap map = layout->root->toVariantMap();
+
+    auto newLayout = new FuzzLayout();
+    const QSize hostSize = layout->host->geometry().size();
+    newLayout->host->setSize(hostSize.width(), hostSize.height());
+
+    QHash<QString, QRect> expectedGeometries;
+    QHash<QString, Widget *> guests;
+    int numPlaceholders = 0;
+    const Item::List oldLeaves = leaves(layout->root.get());
+    for (Item *item : oldLeaves) {
+        Widget *oldGuest = item->guestWidget();
+        if (!oldGuest) {
+            numPlaceholders++;
+            continue;
+        }
+
+        auto guest = new Widget_null(newLayout->host);
+        guest->setMinSize(oldGuest->minSize());
+        guest->setMaxSizeHint(oldGuest->maxSizeHint());
+        guests.insert(oldGuest->id(), guest);
+        expectedGeometries.insert(guest->id(), item->mapToRoot(item->rect()));
+    }
+
+    newLayout->root->fillFromVariantMap(map, guests);
+
+    int numRestoredPlaceholders = 0;
+    const Item::List newLeaves = leaves(newLayout->root.get());
+    for (Item *item : newLeaves) {
+        item->ref(); // references aren't serialized, the application takes them again when restoring
+        Widget *guest = item->guestWidget();
+        if (!guest) {
+            numRestoredPlaceholders++;
+        } else if (item->mapToRoot(item->rect()) != expectedGeometries.value(guest->id())) {
+            error = QStringLiteral("%1 was restored with a different geometry").arg(item->displayName());
+        }
+    }
+
+    if (newLayout->root->size() != layout->root->size())
+        error = QStringLiteral("The root was restored with a different size");
+    else if (newLeaves.size() - numRestoredPlaceholders != expectedGeometries.size())
+        error = QStringLiteral("Restored %1 items instead of %2").arg(newLeaves.size() - numRestoredPlaceholders).arg(expectedGeometries.size());
+    else if (numRestoredPlaceholders != numPlaceholders)
+        error = QStringLiteral("Restored %1 placeholders instead of %2").arg(numRestoredPlaceholders).arg(numPlaceholders);
+
+    if (!error.isEmpty()) {
+        delete newLayout;
+        return nullptr;
+    }
+
+    return newLayout;
+}
+
+/// Returns false if there was nothing to apply the operation to
+bool runOperation(int op, InputReader &input, std::unique_ptr<FuzzLayout> &layout, QString &error)
+{
+    ItemBoxContainer *root = layout->root.get();
+    const Item::List allLeaves = leaves(root);
+
+    switch (op) {
+    case Operation_Insert:
+    case Operation_InsertRelativeTo: {
+        if (allLeaves.size() >= s_maxLeaves)
+            return false;
+
+        const Location loc = location(input);
+        const bool startHidden = input.byte() % 8 == 0;
+
+        Item *relativeTo = nullptr;
+        if (op == Operation_InsertRelativeTo) {
+            const Item::List visibleLeaves = filtered(allLeaves, /*visible=*/true);
+            if (visibleLeaves.isEmpty())
+                return false;
+            relativeTo = visibleLeaves.at(input.byte() % visibleLeaves.size());
+        }
+
+        // Like MultiSplitter, hidden items are only placeholders, without a guest.
+        // And like Position, something holds a reference, so the item survives its guest.
+        auto item = new Item(layout->host);
+        item->ref();
+        item->setGeometry(QRect(0, 0, 200, 200));
+        if (!startHidden)
+            item->setGuestWidget(createGuest(input, layout->host));
+
+        const InitialOption option = startHidden ? InitialOption(InitialVisibilityOption::StartHidden)
+                                                 : InitialOption();
+        if (relativeTo) {
+            ItemBoxContainer::insertItemRelativeTo(item, relativeTo, loc, option);
+        } else {
+            root->insertItem(item, loc, option);
+        }
+        return true;
+    }
+    case Operation_Remove: {
+        if (allLeaves.isEmpty())
+            return false;
+
+        Item *item = allLeaves.at(input.byte() % allLeaves.size());
+        Widget *guest = item->guestWidget();
+        switch (guest ? input.byte() % 3 : 0) {
+        case 0:
+            root->removeItem(item, /*hardRemove=*/true);
+            break;
+        case 1:
+            // Like a Frame being deleted, the referenced item turns into a placeholder
+            break;
+        case 2:
+            // Like a Frame being made floating, the item turns into a placeholder before its guest goes away
+            item->turnIntoPlaceholder();
+            break;
+        }
+
+        if (guest)
+            delete guest->asQObject();
+        return true;
+    }
+    case Operation_Restore: {
+        const Item::List placeholders = filtered(allLeaves, /*visible=*/false);
+        if (placeholders.isEmpty())
+            return false;
+
+        Item *item = placeholders.at(input.byte() % placeholders.size());
+        item->restore(createGuest(input, layout->host));
+        return true;
+    }
+    case Operation_MoveSeparator: {
+        const QVector<Separator *> separators = root->separators_recursive();
+        if (separators.isEmpty())
+            return false;
+
+        Separator *separator = separators.at(input.byte() % separators.size());
+        ItemBoxContainer *container = separator->parentContainer();
+        const int min = container->minPosForSeparator_global(separator);
+        const int max = container->maxPosForSeparator_global(separator);
+        const int pos = separator->position();
+        const int amount = input.bounded(-300, 300);
+        if (min > max)
+            return false;
+
+        const int delta = qBound(min, pos + amount, max) - pos;
+        if (delta != 0)
+            container->requestSeparatorMove(separator, delta);
+        return true;
+    }
+    case Operation_SetSize: {
+        const QSize size = QSize(input.bounded(100, 2500), input.bounded(100, 2000)).expandedTo(root->minSize());
+        const auto strategy = ChildrenResizeStrategy(input.byte() % 3);
+        layout->host->setSize(size.width(), size.height());
+        root->setSize_recursive(size, strategy);
+        return true;
+    }
+    case Operation_ChangeConstraints: {
+        const Item::List visibleLeaves = filtered(allLeaves, /*visible=*/true);
+        if (visibleLeaves.isEmpty())
+            return false;
+
+        Item *item = visibleLeaves.at(input.byte() % visibleLeaves.size());
+        auto guest = static_cast<Widget_null *>(item->guestWidget());
+        const QSize minSize(input.bounded(20, 300), input.bounded(20, 300));
+        guest->setMinSize(minSize);
+        guest->setMaxSizeHint(input.byte() % 2 == 0 ? minSize + QSize(input.bounded(0, 400), input.bounded(0, 400))
+                                                    : Item::hardcodedMaximumSize);
+        return true;
+    }
+    case Operation_RoundTrip: {
+        FuzzLayout *newLayout = roundTrip(layout.get(), error);
+        if (!newLayout)
+            return true;
+
+        layout.reset(newLayout);
+        return true;
+    }
+    }
+
+    return false;
+}
+
+void saveFailingInput()
+{
+    const QByteArray hash = QCryptographicHash::hash(s_currentInput, QCryptographicHash::Sha1).toHex().left(12);
+    const QString filename = QStringLiteral("fuzz_layouting-%1.bin").arg(QString::fromLatin1(hash));
+    QFile file(filename);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(s_currentInput);
+        std::cerr << "Input saved to " << qPrintable(filename) << "\n";
+    }
+}
+
+[[noreturn]] void fail(int opIndex, int op, const QString &error, FuzzLayout *layout)
+{
+    qInstallMessageHandler(nullptr);
+
+    // Saved first, dumping the layout runs engine code which might crash too
+    if (s_saveFailingInputs) {
+        saveFailingInput();
+        s_failingInputSaved = true;
+    }
+
+    std::cerr << "Operation #" << opIndex << " (" << operationName(op) << ") failed: "
+              << qPrintable(error) << "\n";
+    for (const QString &warning : qAsConst(s_warnings))
+        std::cerr << "    " << qPrintable(warning) << "\n";
+
+    layout->root->dumpLayout();
+
+    std::abort();
+}
+
+#ifdef Q_OS_UNIX
+/// Saves the input when the engine itself crashes, before fail() could run.
+/// Only async-signal-safe calls, so the name isn't the input's hash.
+void crashHandler(int sig)
+{
+    if (!s_failingInputSaved) {
+        const int fd = ::open(s_crashInputFilename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd != -1) {
+            ssize_t ignored = ::write(fd, s_currentInput.constData(), size_t(s_currentInput.size()));
+            ::close(fd);
+            static const char message[] = "Crashed, input saved to fuzz_layouting-crash.bin\n";
+            ignored = ::write(STDERR_FILENO, message, sizeof(message) - 1);
+            Q_UNUSED(ignored);
+        }
+    }
+
+    // SA_RESETHAND restored the default action
+    std::raise(sig);
+}
+
+void installCrashHandler()
+{
+    struct sigaction action = {};
+    action.sa_handler = crashHandler;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+
+    for (int sig : { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL })
+        sigaction(sig, &action, nullptr);
+}
+#endif
+
+/// Runs a whole input, on a new layout. Returns the number of operations which were applied
+int runInput(const uchar *data, int size)
+{
+    InputReader input(data, size);
+    auto layout = std::unique_ptr<FuzzLayout>(new FuzzLayout());
+    layout->host->setSize(s_initialRootSize.width(), s_initialRootSize.height());
+    layout->root->setSize(s_initialRootSize);
+
+    s_warnings.clear();
+    int numOperations = 0;
+    int opIndex = 0;
+    while (!input.atEnd()) {
+        const int op = input.byte() % Operation_Count;
+        QString error;
+        if (!runOperation(op, input, layout, error))
+            continue;
+
+        numOperations++;
+        if (error.isEmpty())
+            error = verify(layout->root.get());
+        if (error.isEmpty() && !s_warnings.isEmpty())
+            error = QStringLiteral("Warnings were emitted");
+
+        if (!error.isEmpty())
+            fail(opIndex, op, error, layout.get());
+
+        opIndex++;
+    }
+
+    return numOperations;
+}
+
+void initialize()
+{
+    qInstallMessageHandler(messageHandler);
+
+    // checkSanity() is called after each operation, no need for the ones scheduled on a timer
+    Layouting::Config::self().setSanityCheckLevel(Layouting::Config::SanityCheckLevel::Off);
+}
+
+}
+
+#ifdef KDDW_LIBFUZZER
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv)
+{
+    static QCoreApplication app(*argc, *argv);
+    initialize();
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    runInput(data, int(qMin(size, size_t(1 << 16))));
+    return 0;
+}
+
+#else
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int seconds = 60;
+    quint32 seed = QRandomGenerator::global()->generate();
+    QStringList files;
+
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        const QString &arg = args.at(i);
+        if (arg == QLatin1String("-seconds") && i + 1 < args.size()) {
+            seconds = args.at(++i).toInt();
+        } else if (arg == QLatin1String("-seed") && i + 1 < args.size()) {
+            seed = args.at(++i).toUInt();
+        } else if (arg.startsWith(QLatin1Char('-'))) {
+            std::cerr << "Usage: fuzz_layouting [-seconds N] [-seed N] [file...]\n";
+            return 1;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    initialize();
+
+    if (!files.isEmpty()) {
+        for (const QString &filename : qAsConst(files)) {
+            QFile file(filename);
+            if (!file.open(QIODevice::ReadOnly)) {
+                std::cerr << "Couldn't open " << qPrintable(filename) << "\n";
+                return 1;
+            }
+
+            s_currentInput = file.readAll();
+            const int numOperations = runInput(reinterpret_cast<const uchar *>(s_currentInput.constData()), s_currentInput.size());
+            std::cout << qPrintable(filename) << ": " << numOperations << " operations OK\n";
+        }
+
+        return 0;
+    }
+
+    std::cout << "Seed: " << seed << "\n";
+    s_saveFailingInputs = true;
+#ifdef Q_OS_UNIX
+    installCrashHandler();
+#endif
+    QRandomGenerator rng(seed);
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 numInputs = 0;
+    qint64 numOperations = 0;
+    while (timer.elapsed() < seconds * 1000) {
+        const int numWords = rng.bounded(4, 1024);
+        s_currentInput.resize(numWords * int(sizeof(quint32)));
+        rng.fillRange(reinterpret_cast<quint32 *>(s_currentInput.data()), numWords);
+        numOperations += runInput(reinterpret_cast<const uchar *>(s_currentInput.constData()), s_currentInput.size());
+        numInputs++;
+    }
+
+    const double elapsedSecs = timer.elapsed() / 1000.0;
+    std::cout << numInputs << " inputs, " << numOperations << " operations in " << elapsedSecs << "s ("
+              << qint64(numOperations / elapsedSecs * 60) << " operations/minute)\n";
+
+    return 0;
+}
+
+#endif
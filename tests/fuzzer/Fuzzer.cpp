@@ -13,6 +13,7 @@
 // clazy:excludeall=ctor-missing-parent-argument,missing-qobject-macro,range-loop,missing-typeinfo,detaching-member,function-args-by-ref,non-pod-global-static,reserve-candidates,qstring-allocations
 
 #include "Fuzzer.h"
+#include "Config.h"
 #include "DockRegistry_p.h"
 #include "DockWidget.h"
 #include "MainWindow.h"
@@ -23,6 +24,8 @@
 #include <QString>
 #include <QTest>
 
+#include <cstdlib>
+
 using namespace KDDockWidgets;
 using namespace KDDockWidgets::Testing;
 using namespace KDDockWidgets::Testing::Operations;
@@ -70,6 +73,19 @@ void Fuzzer::runTest(const Test &test)
     m_lastSavedLayout.clear();
     m_currentTest = test;
 
+    if (!m_journalFile.isEmpty()) {
+        m_journal.close();
+        m_journal.setFileName(m_journalFile);
+        if (m_journal.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            QVariantMap header;
+            header[QStringLiteral("initialLayout")] = test.initialLayout.toVariantMap();
+            m_journal.write(QJsonDocument::fromVariant(header).toJson(QJsonDocument::Compact) + '\n');
+            m_journal.flush();
+        } else {
+            qWarning() << Q_FUNC_INFO << "Couldn't open" << m_journalFile;
+        }
+    }
+
     if (!DockRegistry::self()->isEmpty())
         qFatal("There's dock widgets and the start runTest");
 
@@ -94,8 +110,10 @@ void Fuzzer::runTest(const Test &test)
         }
 #endif
         op->execute();
-        if (op->hasParams())
+        if (op->hasParams()) {
+            m_numOperationsRun++;
             qDebug() << "Ran" << op->description() << index;
+        }
         QTest::qWait(m_operationDelayMS);
         DockRegistry::self()->checkSanityAll();
     }
@@ -125,13 +143,16 @@ Fuzzer::Fuzzer(bool dumpJsonOnFailure, Options options, QObject *parent)
     , m_dumpJsonOnFailure(dumpJsonOnFailure)
     , m_options(options)
 {
+    // The side-bar operations need it. Has to be set before any main window is created.
+    Config::self().setFlags(Config::self().flags() | Config::Flag_AutoHideSupport);
+
     Testing::installFatalMessageHandler();
     Testing::setWarningObserver(this);
 }
 
 Fuzzer::Layout Fuzzer::generateRandomLayout()
 {
-    // for now we only support 1 main window
+    // A regular main window, which getRandomMainWindow() returns, and sometimes a MDI one
     Fuzzer::Layout layout;
     Fuzzer::MainWindowDescriptor mainWindow;
 
@@ -143,6 +164,14 @@ Fuzzer::Layout Fuzzer::generateRandomLayout()
     mainWindow.mainWindowOption = MainWindowOption_None; // TODO: Maybe test other options
     layout.mainWindows << mainWindow;
 
+    if (getRandomBool(30)) {
+        Fuzzer::MainWindowDescriptor mdiMainWindow;
+        mdiMainWindow.name = QStringLiteral("MDIMainWindow-%1").arg(count);
+        mdiMainWindow.geometry = randomGeometry();
+        mdiMainWindow.mainWindowOption = MainWindowOption_MDI;
+        layout.mainWindows << mdiMainWindow;
+    }
+
     std::uniform_int_distribution<> numDocksDistrib(1, 10); // TODO: Increase
     const int numDockWidgets = numDocksDistrib(m_randomEngine);
     for (int i = 0; i < numDockWidgets; ++i) {
@@ -197,6 +226,12 @@ bool Fuzzer::getRandomBool(int truePercentage)
     return distrib(m_randomEngine) < truePercentage;
 }
 
+int Fuzzer::getRandomInt(int min, int max)
+{
+    std::uniform_int_distribution<> distrib(min, max);
+    return distrib(m_randomEngine);
+}
+
 Testing::AddDockWidgetParams Fuzzer::getRandomAddDockWidgetParams()
 {
     AddDockWidgetParams params;
@@ -238,6 +273,20 @@ MainWindowBase *Fuzzer::getRandomMainWindow()
     return windows.first();
 }
 
+MainWindowBase *Fuzzer::getRandomMDIMainWindow()
+{
+    MainWindowBase::List candidates;
+    for (MainWindowBase *mw : DockRegistry::self()->mainwindows()) {
+        if (mw->isMDI())
+            candidates << mw;
+    }
+
+    if (candidates.isEmpty())
+        return nullptr;
+
+    return candidates.at(getRandomInt(0, candidates.size() - 1));
+}
+
 DockWidgetBase *Fuzzer::getRandomDockWidget(const DockWidgetBase::List &excluding)
 {
     auto docks = DockRegistry::self()->dockwidgets();
@@ -373,6 +422,9 @@ void Fuzzer::onFatal()
     if (!m_currentJsonFile.isEmpty()) {
         qDebug() << "failed json: " << m_currentJsonFile;
     }
+
+    if (m_options & Option_AbortOnFatal)
+        std::abort();
 }
 
 void Fuzzer::setDelayBetweenOperations(int delay)
@@ -390,6 +442,49 @@ void Fuzzer::setLastSavedLayout(const QByteArray &serialized)
     m_lastSavedLayout = serialized;
 }
 
+void Fuzzer::setJournalFile(const QString &filename)
+{
+    m_journalFile = filename;
+    if (filename.isEmpty())
+        m_journal.close();
+}
+
+void Fuzzer::operationAboutToExecute(const Operations::OperationBase *operation)
+{
+    if (!m_journal.isOpen())
+        return;
+
+    const QVariantMap operationVariant = operation->toVariantMap();
+    if (operationVariant.isEmpty())
+        return;
+
+    // Flushed, so it's in the file even if executing it crashes
+    m_journal.write(QJsonDocument::fromVariant(operationVariant).toJson(QJsonDocument::Compact) + '\n');
+    m_journal.flush();
+}
+
+QVariantMap Fuzzer::journalToVariantMap(const QByteArray &journal)
+{
+    const QList<QByteArray> lines = journal.split('\n');
+    QVariantMap map = QJsonDocument::fromJson(lines.value(0)).toVariant().toMap();
+
+    QVariantList operations;
+    for (int i = 1; i < lines.size(); ++i) {
+        // The last line might be partial if the worker crashed while writing it
+        const QVariantMap operation = QJsonDocument::fromJson(lines.at(i)).toVariant().toMap();
+        if (!operation.isEmpty())
+            operations << operation;
+    }
+
+    map[QStringLiteral("operations")] = operations;
+    return map;
+}
+
+qint64 Fuzzer::numOperationsRun() const
+{
+    return m_numOperationsRun;
+}
+
 void Fuzzer::Test::dumpToJsonFile(const QString &filename) const
 {
     const QVariantMap map = toVariantMap();
@@ -19,6 +19,7 @@
 #include "MainWindowBase.h"
 #include "Operations.h"
 
+#include <QFile>
 #include <QJsonDocument>
 #include <QVector>
 
@@ -62,7 +63,8 @@ public:
     enum Option {
         Option_None = 0,
         Option_NoQuit = 1, ///< Don't quit when the tests finish. So we can debug in gammaray
-        Option_SkipLast = 2 ///< Don't execute the last test. Useful when the last one is the failing one and we want to inspect the state prior to crash
+        Option_SkipLast = 2, ///< Don't execute the last test. Useful when the last one is the failing one and we want to inspect the state prior to crash
+        Option_AbortOnFatal = 4 ///< Abort on the first fatal warning, so a crash handler records the stack that emitted it. Used by the throughput mode's workers
     };
     Q_DECLARE_FLAGS(Options, Option)
 
@@ -238,9 +240,13 @@ public:
 
     bool getRandomBool(int truePercentage = 50);
 
+    ///@brief Returns a random int between @p min and @p max, both inclusive
+    int getRandomInt(int min, int max);
+
     Testing::AddDockWidgetParams getRandomAddDockWidgetParams();
 
     KDDockWidgets::MainWindowBase *getRandomMainWindow();
+    KDDockWidgets::MainWindowBase *getRandomMDIMainWindow();
     KDDockWidgets::DockWidgetBase *getRandomDockWidget(const DockWidgetBase::List &excluding = {});
     KDDockWidgets::DockWidgetBase *getRandomRelativeTo(MainWindowBase *mainWindow,
                                                        DockWidgetBase *excluding);
@@ -266,11 +272,29 @@ public:
     QByteArray lastSavedLayout() const;
     void setLastSavedLayout(const QByteArray &serialized);
 
+    ///@brief Journals each test to @p filename: its initial layout when it starts, then each operation
+    /// right before it executes. So there's a testcase to reproduce even crashes that don't go through
+    /// onFatal(). Operations are appended, one JSON line each, see journalToVariantMap().
+    void setJournalFile(const QString &filename);
+
+    ///@brief Called by operations once their params are known, right before executing them
+    /// Operations get their params lazily, so only now can they be journaled.
+    void operationAboutToExecute(const Operations::OperationBase *operation);
+
+    ///@brief Rebuilds the test written by setJournalFile(), in Test::toVariantMap()'s format
+    static QVariantMap journalToVariantMap(const QByteArray &journal);
+
+    ///@brief Returns how many operations were executed so far, over all tests
+    qint64 numOperationsRun() const;
+
 private:
     std::random_device m_randomDevice;
     std::mt19937 m_randomEngine;
     Fuzzer::Test m_currentTest;
     QString m_currentJsonFile;
+    QString m_journalFile;
+    QFile m_journal;
+    qint64 m_numOperationsRun = 0;
     const bool m_dumpJsonOnFailure;
     int m_operationDelayMS = 50;
     const Options m_options;
@@ -17,10 +17,21 @@
 #include "DockRegistry_p.h"
 #include "DockWidgetBase.h"
 #include "DockWidgetBase_p.h"
+#include "DragController_p.h"
+#include "DropAreaWithCentralFrame_p.h"
+#include "DropIndicatorOverlayInterface_p.h"
 #include "FloatingWindow_p.h"
 #include "Frame_p.h"
 #include "Fuzzer.h"
-
+#include "MDILayoutWidget_p.h"
+#include "MultiSplitter_p.h"
+#include "SideBar_p.h"
+#include "TitleBar_p.h"
+#include "multisplitter/Item_p.h"
+#include "multisplitter/Separator_p.h"
+
+#include <QCursor>
+#include <QPointer>
 #include <QTest>
 
 using namespace KDDockWidgets;
@@ -32,6 +43,72 @@ static QString operationTypeStr(OperationType optype)
     return QMetaEnum::fromType<OperationType>().valueToKey(optype);
 }
 
+static QVariantMap pointToVariantMap(QPoint pt)
+{
+    QVariantMap map;
+    map["x"] = pt.x();
+    map["y"] = pt.y();
+    return map;
+}
+
+static QPoint pointFromVariantMap(const QVariantMap &map)
+{
+    return { map["x"].toInt(), map["y"].toInt() };
+}
+
+/// Returns the layout the dock widget is in, if it's docked in a main window or floating
+static MultiSplitter *multiSplitterFor(DockWidgetBase *dw)
+{
+    if (FloatingWindow *fw = dw->floatingWindow())
+        return fw->multiSplitter();
+
+    if (MainWindowBase *mw = dw->mainWindow())
+        return mw->multiSplitter(); // nullptr if it's MDI
+
+    return nullptr;
+}
+
+/// Returns the main window whose side-bar has the dock widget
+static MainWindowBase *sideBarMainWindowFor(DockWidgetBase *dw)
+{
+    SideBar *sb = DockRegistry::self()->sideBarForDockWidget(dw);
+    return sb ? sb->mainWindow() : nullptr;
+}
+
+/**
+ * Drives DragController's state machine as the mouse would, without synthesizing events.
+ * Moves are handled synchronously, so there's no event loop running in the middle of a drag.
+ * QCursor is kept in sync, as DragController looks at it to find the drop area.
+ */
+class DragSimulator
+{
+public:
+    /// Returns false if the press didn't start a drag, in which case nothing else is to be done
+    bool press(TitleBar *titleBar)
+    {
+        const QPoint localPos(10, titleBar->height() / 2);
+        const QPoint globalPos = titleBar->mapToGlobal(localPos);
+        QCursor::setPos(globalPos);
+        m_dragController->activeState()->handleMouseButtonPress(titleBar, globalPos, localPos);
+
+        return !m_dragController->isIdle();
+    }
+
+    void move(QPoint globalPos)
+    {
+        QCursor::setPos(globalPos);
+        m_dragController->activeState()->handleMouseMove(globalPos);
+    }
+
+    void release(QPoint globalPos)
+    {
+        QCursor::setPos(globalPos);
+        m_dragController->activeState()->handleMouseButtonRelease(globalPos);
+    }
+
+    DragController *const m_dragController = DragController::instance();
+};
+
 OperationBase::OperationBase(KDDockWidgets::Testing::Operations::OperationType type, Fuzzer *fuzzer)
     : m_operationType(type)
     , m_fuzzer(fuzzer)
@@ -49,6 +126,7 @@ void OperationBase::execute()
 
     if (hasParams()) { // Check again, as generateRandomParams() is not guaranteed
         updateDescription();
+        m_fuzzer->operationAboutToExecute(this);
         execute_impl();
 
         if (m_sleepMS > 0)
@@ -127,6 +205,30 @@ OperationBase::Ptr OperationBase::newOperation(Fuzzer *fuzzer, OperationType typ
     case OperationType_RestoreLayout:
         ptr = OperationBase::Ptr(new RestoreLayout(fuzzer));
         break;
+    case OperationType_MoveSeparator:
+        ptr = OperationBase::Ptr(new MoveSeparator(fuzzer));
+        break;
+    case OperationType_FloatViaDrag:
+        ptr = OperationBase::Ptr(new FloatViaDrag(fuzzer));
+        break;
+    case OperationType_DockViaDrag:
+        ptr = OperationBase::Ptr(new DockViaDrag(fuzzer));
+        break;
+    case OperationType_MoveToSideBar:
+        ptr = OperationBase::Ptr(new MoveToSideBar(fuzzer));
+        break;
+    case OperationType_ToggleOverlayOnSideBar:
+        ptr = OperationBase::Ptr(new ToggleOverlayOnSideBar(fuzzer));
+        break;
+    case OperationType_RestoreFromSideBar:
+        ptr = OperationBase::Ptr(new RestoreFromSideBar(fuzzer));
+        break;
+    case OperationType_AddDockWidgetToMDI:
+        ptr = OperationBase::Ptr(new AddDockWidgetToMDI(fuzzer));
+        break;
+    case OperationType_MoveMDI:
+        ptr = OperationBase::Ptr(new MoveMDI(fuzzer));
+        break;
     }
 
     return ptr;
@@ -481,3 +583,536 @@ QVariantMap RestoreLayout::paramsToVariantMap() const
 void RestoreLayout::fillParamsFromVariantMap(const QVariantMap &)
 {
 }
+
+MoveSeparator::MoveSeparator(Fuzzer *fuzzer)
+    : OperationBase(OperationType_MoveSeparator, fuzzer)
+{
+}
+
+void MoveSeparator::generateRandomParams()
+{
+    DockWidgetBase *dw = m_fuzzer->getRandomDockWidget();
+    if (!dw || !dw->isVisible())
+        return;
+
+    MultiSplitter *layout = multiSplitterFor(dw);
+    if (!layout)
+        return;
+
+    const int numSeparators = layout->rootItem()->separators_recursive().size();
+    if (numSeparators == 0)
+        return;
+
+    m_dockWidgetName = dw->uniqueName();
+    m_separatorIndex = m_fuzzer->getRandomInt(0, numSeparators - 1);
+    m_delta = m_fuzzer->getRandomInt(-300, 300);
+}
+
+bool MoveSeparator::hasParams() const
+{
+    return !m_dockWidgetName.isEmpty() && m_separatorIndex >= 0;
+}
+
+void MoveSeparator::updateDescription()
+{
+    m_description = QStringLiteral("MoveSeparator #%1 next to %2 by %3").arg(m_separatorIndex).arg(dockStr(m_dockWidgetName)).arg(m_delta);
+}
+
+void MoveSeparator::execute_impl()
+{
+    DockWidgetBase *dw = dockByName(m_dockWidgetName);
+    MultiSplitter *layout = dw ? multiSplitterFor(dw) : nullptr;
+    if (!layout) {
+        qDebug() << "Skipping, dock widget isn't in a layout anymore";
+        return;
+    }
+
+    const QVector<Layouting::Separator *> separators = layout->rootItem()->separators_recursive();
+    if (m_separatorIndex >= separators.size()) {
+        qDebug() << "Skipping, separator doesn't exist anymore";
+        return;
+    }
+
+    // Clamp like Separator::onMouseMove() does
+    Layouting::Separator *separator = separators.at(m_separatorIndex);
+    Layouting::ItemBoxContainer *container = separator->parentContainer();
+    const int min = container->minPosForSeparator_global(separator);
+    const int max = container->maxPosForSeparator_global(separator);
+    if (min > max)
+        return;
+
+    const int pos = separator->position();
+    const int delta = qBound(min, pos + m_delta, max) - pos;
+    if (delta != 0)
+        container->requestSeparatorMove(separator, delta);
+}
+
+QVariantMap MoveSeparator::paramsToVariantMap() const
+{
+    QVariantMap map;
+    if (hasParams()) {
+        map["dockWidgetName"] = m_dockWidgetName;
+        map["separatorIndex"] = m_separatorIndex;
+        map["delta"] = m_delta;
+    }
+    return map;
+}
+
+void MoveSeparator::fillParamsFromVariantMap(const QVariantMap &map)
+{
+    m_dockWidgetName = map["dockWidgetName"].toString();
+    m_separatorIndex = map.value("separatorIndex", -1).toInt();
+    m_delta = map["delta"].toInt();
+}
+
+FloatViaDrag::FloatViaDrag(Fuzzer *fuzzer)
+    : OperationBase(OperationType_FloatViaDrag, fuzzer)
+{
+}
+
+void FloatViaDrag::generateRandomParams()
+{
+    DockWidgetBase *dw = m_fuzzer->getRandomDockWidget();
+    if (!dw || !dw->isVisible() || dw->isFloating() || dw->isOverlayed())
+        return;
+
+    Frame *frame = dw->d->frame();
+    if (!frame || !frame->isInMainWindow() || frame->isMDI()) // MDI is covered by MoveMDI
+        return;
+
+    m_dockWidgetName = dw->uniqueName();
+    m_globalDest = QPoint(m_fuzzer->getRandomInt(0, 1500), m_fuzzer->getRandomInt(0, 1000));
+}
+
+bool FloatViaDrag::hasParams() const
+{
+    return !m_dockWidgetName.isEmpty();
+}
+
+void FloatViaDrag::updateDescription()
+{
+    m_description = QStringLiteral("FloatViaDrag %1 to %2,%3").arg(dockStr(m_dockWidgetName)).arg(m_globalDest.x()).arg(m_globalDest.y());
+}
+
+void FloatViaDrag::execute_impl()
+{
+    DockWidgetBase *dw = dockByName(m_dockWidgetName);
+    Frame *frame = dw->d->frame();
+    TitleBar *titleBar = frame ? frame->titleBar() : nullptr;
+    if (!titleBar || !titleBar->isVisible()) {
+        qDebug() << "Skipping, no title bar to drag";
+        return;
+    }
+
+    DragSimulator drag;
+    if (!drag.press(titleBar))
+        return;
+
+    // The first move only gets us out of the pre-drag state
+    drag.move(m_globalDest);
+    drag.move(m_globalDest);
+    drag.release(m_globalDest);
+}
+
+QVariantMap FloatViaDrag::paramsToVariantMap() const
+{
+    QVariantMap map;
+    if (hasParams()) {
+        map["dockWidgetName"] = m_dockWidgetName;
+        map["globalDest"] = pointToVariantMap(m_globalDest);
+    }
+    return map;
+}
+
+void FloatViaDrag::fillParamsFromVariantMap(const QVariantMap &map)
+{
+    m_dockWidgetName = map["dockWidgetName"].toString();
+    m_globalDest = pointFromVariantMap(map["globalDest"].toMap());
+}
+
+DockViaDrag::DockViaDrag(Fuzzer *fuzzer)
+    : OperationBase(OperationType_DockViaDrag, fuzzer)
+{
+}
+
+void DockViaDrag::generateRandomParams()
+{
+    DockWidgetBase *dw = m_fuzzer->getRandomDockWidget();
+    if (!dw || !dw->isVisible() || !dw->floatingWindow())
+        return;
+
+    MainWindowBase *mw = m_fuzzer->getRandomMainWindow();
+    if (!mw)
+        return;
+
+    static const DropLocation dropLocations[] = {
+        DropLocation_Left, DropLocation_Top, DropLocation_Right, DropLocation_Bottom, DropLocation_Center,
+        DropLocation_OutterLeft, DropLocation_OutterTop, DropLocation_OutterRight, DropLocation_OutterBottom
+    };
+
+    m_dockWidgetName = dw->uniqueName();
+    m_mainWindowName = mw->uniqueName();
+    m_dropLocation = dropLocations[m_fuzzer->getRandomInt(0, int(sizeof(dropLocations) / sizeof(dropLocations[0])) - 1)];
+
+    if (m_fuzzer->getRandomBool()) {
+        if (DockWidgetBase *relativeTo = m_fuzzer->getRandomRelativeTo(mw, dw))
+            m_relativeToName = relativeTo->uniqueName();
+    }
+}
+
+bool DockViaDrag::hasParams() const
+{
+    return !m_dockWidgetName.isEmpty() && !m_mainWindowName.isEmpty();
+}
+
+void DockViaDrag::updateDescription()
+{
+    const QString location = QString::fromLatin1(QMetaEnum::fromType<DropLocation>().valueToKey(m_dropLocation));
+    if (m_relativeToName.isEmpty())
+        m_description = QStringLiteral("DockViaDrag %1 to %2 of %3").arg(dockStr(m_dockWidgetName), location, m_mainWindowName);
+    else
+        m_description = QStringLiteral("DockViaDrag %1 to %2 of %3, relative to %4").arg(dockStr(m_dockWidgetName), location, m_mainWindowName, dockStr(m_relativeToName));
+}
+
+void DockViaDrag::execute_impl()
+{
+    DockWidgetBase *dw = dockByName(m_dockWidgetName);
+    MainWindowBase *mw = mainWindowByName(m_mainWindowName);
+    QPointer<FloatingWindow> fw = dw->floatingWindow();
+    if (!fw || !mw) {
+        qDebug() << "Skipping, not floating anymore";
+        return;
+    }
+
+    TitleBar *titleBar = fw->titleBar();
+    if (!titleBar || !titleBar->isVisible()) {
+        qDebug() << "Skipping, no title bar to drag";
+        return;
+    }
+
+    // Hovering the frame shows the inner indicators for it, otherwise they're for the central frame
+    QWidget *hovered = mw->dropArea();
+    if (DockWidgetBase *relativeTo = dockByName(m_relativeToName)) {
+        if (relativeTo->mainWindow() == mw && relativeTo->d->frame())
+            hovered = relativeTo->d->frame();
+    }
+    const QPoint hoverPos = hovered->mapToGlobal(hovered->rect().center());
+
+    DragSimulator drag;
+    if (!drag.press(titleBar))
+        return;
+
+    drag.move(hoverPos);
+    drag.move(hoverPos);
+
+    QPoint dropPos = hoverPos;
+    if (drag.m_dragController->isDragging()) {
+        if (DropArea *dropArea = drag.m_dragController->dropAreaUnderCursor())
+            dropPos = dropArea->dropIndicatorOverlay()->posForIndicator(m_dropLocation);
+        drag.move(dropPos);
+    }
+
+    drag.release(dropPos);
+
+    if (fw && fw->beingDeleted())
+        Testing::waitForDeleted(fw);
+}
+
+QVariantMap DockViaDrag::paramsToVariantMap() const
+{
+    QVariantMap map;
+    if (hasParams()) {
+        map["dockWidgetName"] = m_dockWidgetName;
+        map["mainWindowName"] = m_mainWindowName;
+        if (!m_relativeToName.isEmpty())
+            map["relativeToName"] = m_relativeToName;
+        map["dropLocation"] = m_dropLocation;
+    }
+    return map;
+}
+
+void DockViaDrag::fillParamsFromVariantMap(const QVariantMap &map)
+{
+    m_dockWidgetName = map["dockWidgetName"].toString();
+    m_mainWindowName = map["mainWindowName"].toString();
+    m_relativeToName = map["relativeToName"].toString();
+    m_dropLocation = DropLocation(map["dropLocation"].toInt());
+}
+
+MoveToSideBar::MoveToSideBar(Fuzzer *fuzzer)
+    : OperationBase(OperationType_MoveToSideBar, fuzzer)
+{
+}
+
+void MoveToSideBar::generateRandomParams()
+{
+    DockWidgetBase *dw = m_fuzzer->getRandomDockWidget();
+    if (!dw || !dw->isVisible() || dw->isInSideBar())
+        return;
+
+    MainWindowBase *mw = dw->mainWindow();
+    if (!mw || mw->isMDI())
+        return;
+
+    m_dockWidgetName = dw->uniqueName();
+    m_location = SideBarLocation(m_fuzzer->getRandomInt(int(SideBarLocation::North), int(SideBarLocation::South)));
+}
+
+bool MoveToSideBar::hasParams() const
+{
+    return !m_dockWidgetName.isEmpty() && m_location != SideBarLocation::None;
+}
+
+void MoveToSideBar::updateDescription()
+{
+    m_description = QStringLiteral("MoveToSideBar %1 to side-bar %2").arg(dockStr(m_dockWidgetName)).arg(int(m_location));
+}
+
+void MoveToSideBar::execute_impl()
+{
+    DockWidgetBase *dw = dockByName(m_dockWidgetName);
+    MainWindowBase *mw = dw->mainWindow();
+    if (!mw || mw->isMDI() || dw->isInSideBar()) {
+        qDebug() << "Skipping, not docked in a main window anymore";
+        return;
+    }
+
+    mw->moveToSideBar(dw, m_location);
+}
+
+QVariantMap MoveToSideBar::paramsToVariantMap() const
+{
+    QVariantMap map;
+    if (hasParams()) {
+        map["dockWidgetName"] = m_dockWidgetName;
+        map["location"] = int(m_location);
+    }
+    return map;
+}
+
+void MoveToSideBar::fillParamsFromVariantMap(const QVariantMap &map)
+{
+    m_dockWidgetName = map["dockWidgetName"].toString();
+    m_location = SideBarLocation(map["location"].toInt());
+}
+
+ToggleOverlayOnSideBar::ToggleOverlayOnSideBar(Fuzzer *fuzzer)
+    : OperationBase(OperationType_ToggleOverlayOnSideBar, fuzzer)
+{
+}
+
+void ToggleOverlayOnSideBar::generateRandomParams()
+{
+    if (DockWidgetBase *dw = m_fuzzer->getRandomDockWidget())
+        if (dw->isInSideBar())
+            m_dockWidgetName = dw->uniqueName();
+}
+
+bool ToggleOverlayOnSideBar::hasParams() const
+{
+    return !m_dockWidgetName.isEmpty();
+}
+
+void ToggleOverlayOnSideBar::updateDescription()
+{
+    m_description = QStringLiteral("ToggleOverlayOnSideBar %1").arg(dockStr(m_dockWidgetName));
+}
+
+void ToggleOverlayOnSideBar::execute_impl()
+{
+    DockWidgetBase *dw = dockByName(m_dockWidgetName);
+    MainWindowBase *mw = sideBarMainWindowFor(dw);
+    if (!mw) {
+        qDebug() << "Skipping, not in a side-bar anymore";
+        return;
+    }
+
+    mw->toggleOverlayOnSideBar(dw);
+}
+
+QVariantMap ToggleOverlayOnSideBar::paramsToVariantMap() const
+{
+    QVariantMap map;
+    if (!m_dockWidgetName.isEmpty())
+        map["dockWidgetName"] = m_dockWidgetName;
+    return map;
+}
+
+void ToggleOverlayOnSideBar::fillParamsFromVariantMap(const QVariantMap &map)
+{
+    m_dockWidgetName = map["dockWidgetName"].toString();
+}
+
+RestoreFromSideBar::RestoreFromSideBar(Fuzzer *fuzzer)
+    : OperationBase(OperationType_RestoreFromSideBar, fuzzer)
+{
+}
+
+void RestoreFromSideBar::generateRandomParams()
+{
+    if (DockWidgetBase *dw = m_fuzzer->getRandomDockWidget())
+        if (dw->isInSideBar())
+            m_dockWidgetName = dw->uniqueName();
+}
+
+bool RestoreFromSideBar::hasParams() const
+{
+    return !m_dockWidgetName.isEmpty();
+}
+
+void RestoreFromSideBar::updateDescription()
+{
+    m_description = QStringLiteral("RestoreFromSideBar %1").arg(dockStr(m_dockWidgetName));
+}
+
+void RestoreFromSideBar::execute_impl()
+{
+    DockWidgetBase *dw = dockByName(m_dockWidgetName);
+    MainWindowBase *mw = sideBarMainWindowFor(dw);
+    if (!mw) {
+        qDebug() << "Skipping, not in a side-bar anymore";
+        return;
+    }
+
+    mw->restoreFromSideBar(dw);
+}
+
+QVariantMap RestoreFromSideBar::paramsToVariantMap() const
+{
+    QVariantMap map;
+    if (!m_dockWidgetName.isEmpty())
+        map["dockWidgetName"] = m_dockWidgetName;
+    return map;
+}
+
+void RestoreFromSideBar::fillParamsFromVariantMap(const QVariantMap &map)
+{
+    m_dockWidgetName = map["dockWidgetName"].toString();
+}
+
+AddDockWidgetToMDI::AddDockWidgetToMDI(Fuzzer *fuzzer)
+    : OperationBase(OperationType_AddDockWidgetToMDI, fuzzer)
+{
+}
+
+void AddDockWidgetToMDI::generateRandomParams()
+{
+    MainWindowBase *mw = m_fuzzer->getRandomMDIMainWindow();
+    if (!mw)
+        return;
+
+    DockWidgetBase *dw = m_fuzzer->getRandomDockWidget();
+    if (!dw || dw->mainWindow() == mw || dw->isInSideBar())
+        return;
+
+    m_dockWidgetName = dw->uniqueName();
+    m_mainWindowName = mw->uniqueName();
+    m_localPos = m_fuzzer->getRandomPos();
+}
+
+bool AddDockWidgetToMDI::hasParams() const
+{
+    return !m_dockWidgetName.isEmpty() && !m_mainWindowName.isEmpty();
+}
+
+void AddDockWidgetToMDI::updateDescription()
+{
+    m_description = QStringLiteral("AddDockWidgetToMDI %1 to %2 at %3,%4").arg(dockStr(m_dockWidgetName), m_mainWindowName).arg(m_localPos.x()).arg(m_localPos.y());
+}
+
+void AddDockWidgetToMDI::execute_impl()
+{
+    DockWidgetBase *dw = dockByName(m_dockWidgetName);
+    MainWindowBase *mw = mainWindowByName(m_mainWindowName);
+
+    auto fw = dw->floatingWindow();
+    mw->mdiLayoutWidget()->addDockWidget(dw, m_localPos);
+    if (fw && fw->beingDeleted())
+        Testing::waitForDeleted(fw);
+}
+
+QVariantMap AddDockWidgetToMDI::paramsToVariantMap() const
+{
+    QVariantMap map;
+    if (hasParams()) {
+        map["dockWidgetName"] = m_dockWidgetName;
+        map["mainWindowName"] = m_mainWindowName;
+        map["localPos"] = pointToVariantMap(m_localPos);
+    }
+    return map;
+}
+
+void AddDockWidgetToMDI::fillParamsFromVariantMap(const QVariantMap &map)
+{
+    m_dockWidgetName = map["dockWidgetName"].toString();
+    m_mainWindowName = map["mainWindowName"].toString();
+    m_localPos = pointFromVariantMap(map["localPos"].toMap());
+}
+
+MoveMDI::MoveMDI(Fuzzer *fuzzer)
+    : OperationBase(OperationType_MoveMDI, fuzzer)
+{
+}
+
+void MoveMDI::generateRandomParams()
+{
+    DockWidgetBase *dw = m_fuzzer->getRandomDockWidget();
+    if (!dw || !dw->isVisible())
+        return;
+
+    Frame *frame = dw->d->frame();
+    if (!frame || !frame->mdiLayoutWidget())
+        return;
+
+    // Going past the edges is allowed, so popping out of the MDI area is also exercised
+    m_dockWidgetName = dw->uniqueName();
+    m_localPos = QPoint(m_fuzzer->getRandomInt(-400, 1200), m_fuzzer->getRandomInt(-400, 1200));
+}
+
+bool MoveMDI::hasParams() const
+{
+    return !m_dockWidgetName.isEmpty();
+}
+
+void MoveMDI::updateDescription()
+{
+    m_description = QStringLiteral("MoveMDI %1 to %2,%3").arg(dockStr(m_dockWidgetName)).arg(m_localPos.x()).arg(m_localPos.y());
+}
+
+void MoveMDI::execute_impl()
+{
+    DockWidgetBase *dw = dockByName(m_dockWidgetName);
+    Frame *frame = dw->d->frame();
+    MDILayoutWidget *layout = frame ? frame->mdiLayoutWidget() : nullptr;
+    TitleBar *titleBar = frame ? frame->titleBar() : nullptr;
+    if (!layout || !titleBar || !titleBar->isVisible()) {
+        qDebug() << "Skipping, not in a MDI layout anymore";
+        return;
+    }
+
+    const QPoint globalDest = layout->mapToGlobal(m_localPos);
+
+    DragSimulator drag;
+    if (!drag.press(titleBar))
+        return;
+
+    drag.move(globalDest);
+    drag.move(globalDest);
+    drag.release(globalDest);
+}
+
+QVariantMap MoveMDI::paramsToVariantMap() const
+{
+    QVariantMap map;
+    if (hasParams()) {
+        map["dockWidgetName"] = m_dockWidgetName;
+        map["localPos"] = pointToVariantMap(m_localPos);
+    }
+    return map;
+}
+
+void MoveMDI::fillParamsFromVariantMap(const QVariantMap &map)
+{
+    m_dockWidgetName = map["dockWidgetName"].toString();
+    m_localPos = pointFromVariantMap(map["localPos"].toMap());
+}
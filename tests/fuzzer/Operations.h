@@ -19,6 +19,7 @@
 #include "../Testing.h"
 
 #include <QObject>
+#include <QPoint>
 #include <QVector>
 #include <QMetaEnum>
 
@@ -44,6 +45,14 @@ enum OperationType {
     OperationType_AddDockWidgetAsTab, ///< DockWidget::addDockWidgetAsTab()
     OperationType_SaveLayout, ///< LayoutSaver::saveLayout()
     OperationType_RestoreLayout, ///< LayoutSaver::restoreLayout()
+    OperationType_MoveSeparator, ///< ItemBoxContainer::requestSeparatorMove(), what dragging a separator does
+    OperationType_FloatViaDrag, ///< Dragging a docked dock widget's title bar away, via DragController
+    OperationType_DockViaDrag, ///< Dragging a floating window onto a drop indicator, via DragController
+    OperationType_MoveToSideBar, ///< MainWindow::moveToSideBar()
+    OperationType_ToggleOverlayOnSideBar, ///< MainWindow::toggleOverlayOnSideBar()
+    OperationType_RestoreFromSideBar, ///< MainWindow::restoreFromSideBar()
+    OperationType_AddDockWidgetToMDI, ///< MDILayoutWidget::addDockWidget()
+    OperationType_MoveMDI, ///< Dragging a MDI dock widget's title bar, via DragController
     OperationType_Count /// Keep at end
 };
 Q_ENUM_NS(OperationType)
@@ -210,6 +219,160 @@ protected:
     void fillParamsFromVariantMap(const QVariantMap &) override;
 };
 
+class MoveSeparator : public OperationBase
+{
+    Q_DISABLE_COPY(MoveSeparator)
+public:
+    explicit MoveSeparator(Fuzzer *);
+
+protected:
+    void generateRandomParams() override;
+    bool hasParams() const override;
+    void updateDescription() override;
+    void execute_impl() override;
+    QVariantMap paramsToVariantMap() const override;
+    void fillParamsFromVariantMap(const QVariantMap &) override;
+
+private:
+    QString m_dockWidgetName; // Whose layout the separator belongs to
+    int m_separatorIndex = -1;
+    int m_delta = 0;
+};
+
+class FloatViaDrag : public OperationBase
+{
+    Q_DISABLE_COPY(FloatViaDrag)
+public:
+    explicit FloatViaDrag(Fuzzer *);
+
+protected:
+    void generateRandomParams() override;
+    bool hasParams() const override;
+    void updateDescription() override;
+    void execute_impl() override;
+    QVariantMap paramsToVariantMap() const override;
+    void fillParamsFromVariantMap(const QVariantMap &) override;
+
+private:
+    QString m_dockWidgetName;
+    QPoint m_globalDest;
+};
+
+class DockViaDrag : public OperationBase
+{
+    Q_DISABLE_COPY(DockViaDrag)
+public:
+    explicit DockViaDrag(Fuzzer *);
+
+protected:
+    void generateRandomParams() override;
+    bool hasParams() const override;
+    void updateDescription() override;
+    void execute_impl() override;
+    QVariantMap paramsToVariantMap() const override;
+    void fillParamsFromVariantMap(const QVariantMap &) override;
+
+private:
+    QString m_dockWidgetName;
+    QString m_mainWindowName;
+    QString m_relativeToName; // Optional. When set we hover its frame, so the inner indicators apply to it
+    DropLocation m_dropLocation = DropLocation_None;
+};
+
+class MoveToSideBar : public OperationBase
+{
+    Q_DISABLE_COPY(MoveToSideBar)
+public:
+    explicit MoveToSideBar(Fuzzer *);
+
+protected:
+    void generateRandomParams() override;
+    bool hasParams() const override;
+    void updateDescription() override;
+    void execute_impl() override;
+    QVariantMap paramsToVariantMap() const override;
+    void fillParamsFromVariantMap(const QVariantMap &) override;
+
+private:
+    QString m_dockWidgetName;
+    SideBarLocation m_location = SideBarLocation::None;
+};
+
+class ToggleOverlayOnSideBar : public OperationBase
+{
+    Q_DISABLE_COPY(ToggleOverlayOnSideBar)
+public:
+    explicit ToggleOverlayOnSideBar(Fuzzer *);
+
+protected:
+    void generateRandomParams() override;
+    bool hasParams() const override;
+    void updateDescription() override;
+    void execute_impl() override;
+    QVariantMap paramsToVariantMap() const override;
+    void fillParamsFromVariantMap(const QVariantMap &) override;
+
+private:
+    QString m_dockWidgetName;
+};
+
+class RestoreFromSideBar : public OperationBase
+{
+    Q_DISABLE_COPY(RestoreFromSideBar)
+public:
+    explicit RestoreFromSideBar(Fuzzer *);
+
+protected:
+    void generateRandomParams() override;
+    bool hasParams() const override;
+    void updateDescription() override;
+    void execute_impl() override;
+    QVariantMap paramsToVariantMap() const override;
+    void fillParamsFromVariantMap(const QVariantMap &) override;
+
+private:
+    QString m_dockWidgetName;
+};
+
+class AddDockWidgetToMDI : public OperationBase
+{
+    Q_DISABLE_COPY(AddDockWidgetToMDI)
+public:
+    explicit AddDockWidgetToMDI(Fuzzer *);
+
+protected:
+    void generateRandomParams() override;
+    bool hasParams() const override;
+    void updateDescription() override;
+    void execute_impl() override;
+    QVariantMap paramsToVariantMap() const override;
+    void fillParamsFromVariantMap(const QVariantMap &) override;
+
+private:
+    QString m_dockWidgetName;
+    QString m_mainWindowName;
+    QPoint m_localPos;
+};
+
+class MoveMDI : public OperationBase
+{
+    Q_DISABLE_COPY(MoveMDI)
+public:
+    explicit MoveMDI(Fuzzer *);
+
+protected:
+    void generateRandomParams() override;
+    bool hasParams() const override;
+    void updateDescription() override;
+    void execute_impl() override;
+    QVariantMap paramsToVariantMap() const override;
+    void fillParamsFromVariantMap(const QVariantMap &) override;
+
+private:
+    QString m_dockWidgetName;
+    QPoint m_localPos; // Where to drag the title bar to, in the MDI layout's coordinates
+};
+
 }
 }
 }
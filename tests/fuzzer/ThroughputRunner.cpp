@@ -0,0 +1,357 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+// We don't care about performance related checks in the tests
+// clazy:excludeall=ctor-missing-parent-argument,missing-qobject-macro,range-loop,missing-typeinfo,detaching-member,function-args-by-ref,non-pod-global-static,reserve-candidates,qstring-allocations
+
+#include "ThroughputRunner.h"
+#include "Fuzzer.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QRegularExpression>
+#include <QTimer>
+
+#include <cstdlib>
+#include <iostream>
+
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#include <execinfo.h>
+#include <signal.h>
+#include <unistd.h>
+#define KDDW_FUZZER_HAS_BACKTRACE
+#endif
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::Testing;
+
+static const char s_stackBegin[] = "KDDW_FUZZER_STACK_BEGIN\n";
+static const char s_stackEnd[] = "KDDW_FUZZER_STACK_END\n";
+static const char s_opsPrefix[] = "KDDW_FUZZER_OPS ";
+
+// How many frames identify a crash. Deeper frames are mostly the event loop
+static const int s_numSignatureFrames = 8;
+
+// abort() and Qt's message handling are on the stack of every assert and warning, they would
+// make all of them look alike
+static const char *const s_ignoredFunctions[] = { "raise", "abort", "gsignal", "killpg" };
+static const char *const s_ignoredSymbolParts[] = {
+    "qt_message", "QMessageLogger", "qt_assert", "qFatal", "onFatal", "fatalWarningsMessageHandler"
+};
+
+static bool isIgnoredFrame(const QString &frame)
+{
+    // "module(symbol+0x1c)", or "module(+0x1c)" for symbols which aren't exported
+    const int open = frame.indexOf(QLatin1Char('('));
+    const int plus = frame.indexOf(QLatin1Char('+'), open);
+    if (open == -1 || plus == -1)
+        return false;
+
+    const QString symbol = frame.mid(open + 1, plus - open - 1);
+    for (const char *function : s_ignoredFunctions) {
+        if (symbol == QLatin1String(function))
+            return true;
+    }
+
+    for (const char *part : s_ignoredSymbolParts) {
+        if (symbol.contains(QLatin1String(part)))
+            return true;
+    }
+
+    return false;
+}
+
+#ifdef KDDW_FUZZER_HAS_BACKTRACE
+static void crashHandler(int sig)
+{
+    // Only async-signal-safe calls from here on. backtrace() is, once libgcc is loaded
+    void *frames[64];
+    const int numFrames = backtrace(frames, 64);
+
+    ssize_t ignored = write(STDERR_FILENO, s_stackBegin, sizeof(s_stackBegin) - 1);
+    backtrace_symbols_fd(frames, numFrames, STDERR_FILENO);
+    ignored = write(STDERR_FILENO, s_stackEnd, sizeof(s_stackEnd) - 1);
+    Q_UNUSED(ignored);
+
+    // SA_RESETHAND restored the default action, so the runner sees the real signal
+    raise(sig);
+}
+#endif
+
+void ThroughputRunner::installCrashHandler()
+{
+#ifdef KDDW_FUZZER_HAS_BACKTRACE
+    // The first call loads libgcc, which isn't safe to do from a signal handler
+    void *dummy[1];
+    backtrace(dummy, 1);
+
+    struct sigaction action = {};
+    action.sa_handler = crashHandler;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+
+    for (int sig : { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL })
+        sigaction(sig, &action, nullptr);
+#endif
+}
+
+void ThroughputRunner::reportTestFinished(qint64 numOperations)
+{
+    std::cout << s_opsPrefix << numOperations << std::endl;
+}
+
+ThroughputRunner::ThroughputRunner(const Options &options, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_workDir(QDir(options.crashDir).filePath(QStringLiteral("workers")))
+{
+}
+
+ThroughputRunner::~ThroughputRunner() = default;
+
+int ThroughputRunner::exec()
+{
+    if (!QDir().mkpath(m_workDir)) {
+        std::cerr << "Couldn't create " << m_workDir.toStdString() << "\n";
+        return -1;
+    }
+
+    std::cerr << "Running " << m_options.numJobs << " workers";
+    if (m_options.durationSecs > 0)
+        std::cerr << " for " << m_options.durationSecs << "s";
+    std::cerr << ", crashes go to " << QDir(m_options.crashDir).absolutePath().toStdString() << "\n";
+
+    m_elapsed.start();
+    m_workers.reserve(m_options.numJobs);
+    for (int slot = 0; slot < m_options.numJobs; ++slot) {
+        auto worker = new QProcess(this);
+        connect(worker, &QProcess::readyReadStandardOutput, this, [this, slot] {
+            onWorkerOutput(slot);
+        });
+        connect(worker, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+                [this, slot](int exitCode, QProcess::ExitStatus status) {
+                    onWorkerFinished(slot, exitCode, status);
+                });
+        connect(worker, &QProcess::errorOccurred, this, [this, worker](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+                std::cerr << "Failed to start worker: " << worker->errorString().toStdString() << "\n";
+                m_failedToStart = true;
+                stop();
+            }
+        });
+        m_workers.push_back(worker);
+        startWorker(slot);
+    }
+
+    QTimer progressTimer;
+    connect(&progressTimer, &QTimer::timeout, this, &ThroughputRunner::printProgress);
+    progressTimer.start(10000);
+
+    if (m_options.durationSecs > 0)
+        QTimer::singleShot(m_options.durationSecs * 1000, this, &ThroughputRunner::stop);
+
+    QEventLoop loop;
+    m_loop = &loop;
+    if (!m_stopping)
+        loop.exec();
+    m_loop = nullptr;
+
+    printProgress();
+    writeSummary();
+
+    for (const QString &id : qAsConst(m_crashOrder)) {
+        const Crash &crash = m_crashes.value(id);
+        std::cout << "crash " << id.toStdString() << " x" << crash.count << " in "
+                  << crash.topFrame.toStdString() << ": " << crash.testcase.toStdString() << "\n";
+    }
+
+    if (m_failedToStart)
+        return -1;
+
+    if (m_numTests == 0 && m_crashes.isEmpty()) {
+        std::cerr << "No test finished, nothing was fuzzed\n";
+        return -1;
+    }
+
+    return m_crashes.size();
+}
+
+QString ThroughputRunner::currentTestFile(int slot) const
+{
+    return QDir(m_workDir).filePath(QStringLiteral("current-%1.journal").arg(slot));
+}
+
+void ThroughputRunner::startWorker(int slot)
+{
+    if (m_stopping)
+        return;
+
+    QProcess *worker = m_workers.at(slot);
+
+    // Headless, whatever the runner itself was started with
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert(QStringLiteral("QT_QPA_PLATFORM"), QStringLiteral("offscreen"));
+    worker->setProcessEnvironment(env);
+
+    QFile::remove(currentTestFile(slot));
+    worker->start(QCoreApplication::applicationFilePath(), { QStringLiteral("--worker"), currentTestFile(slot) });
+}
+
+void ThroughputRunner::onWorkerOutput(int slot)
+{
+    QProcess *worker = m_workers.at(slot);
+    while (worker->canReadLine()) {
+        const QByteArray line = worker->readLine().trimmed();
+        if (line.startsWith(s_opsPrefix)) {
+            m_numOperations += line.mid(int(sizeof(s_opsPrefix)) - 1).toLongLong();
+            m_numTests++;
+        }
+    }
+}
+
+void ThroughputRunner::onWorkerFinished(int slot, int exitCode, QProcess::ExitStatus status)
+{
+    if (m_stopping)
+        return; // Killed by us
+
+    onWorkerOutput(slot);
+    QProcess *worker = m_workers.at(slot);
+    const QByteArray stderrOutput = worker->readAllStandardError();
+
+    if (status == QProcess::CrashExit || exitCode != 0) {
+        m_numCrashes++;
+
+        const QStringList signature = stackSignature(stderrOutput);
+        const QString id = QString::fromLatin1(QCryptographicHash::hash(signature.join(QLatin1Char('\n')).toUtf8(),
+                                                                        QCryptographicHash::Sha1)
+                                                   .toHex()
+                                                   .left(12));
+
+        Crash &crash = m_crashes[id];
+        crash.count++;
+        if (crash.count == 1) {
+            crash.id = id;
+            crash.topFrame = signature.value(0);
+            crash.testcase = QDir(m_options.crashDir).filePath(QStringLiteral("crash-%1.json").arg(id));
+            m_crashOrder.push_back(id);
+
+            // A previous run might have found it already, keep that one
+            QFile journal(currentTestFile(slot));
+            QFile testcase(crash.testcase);
+            if (!testcase.exists() && journal.open(QIODevice::ReadOnly) && testcase.open(QIODevice::WriteOnly)) {
+                const QVariantMap test = Fuzzer::journalToVariantMap(journal.readAll());
+                testcase.write(QJsonDocument::fromVariant(test).toJson());
+            }
+
+            QFile log(QDir(m_options.crashDir).filePath(QStringLiteral("crash-%1.txt").arg(id)));
+            if (log.open(QIODevice::WriteOnly | QIODevice::Truncate))
+                log.write(stderrOutput.right(64 * 1024));
+
+            std::cerr << "New crash " << id.toStdString() << " in " << crash.topFrame.toStdString() << "\n";
+        }
+    }
+
+    startWorker(slot);
+}
+
+void ThroughputRunner::stop()
+{
+    if (m_stopping)
+        return;
+
+    m_stopping = true;
+    for (QProcess *worker : qAsConst(m_workers)) {
+        if (worker->state() != QProcess::NotRunning) {
+            worker->kill();
+            worker->waitForFinished();
+        }
+    }
+
+    if (m_loop)
+        m_loop->quit();
+}
+
+void ThroughputRunner::printProgress() const
+{
+    const double secs = m_elapsed.elapsed() / 1000.0;
+    std::cerr << "[" << int(secs) << "s] " << m_numTests << " tests, " << m_numOperations
+              << " operations, " << (secs > 0 ? m_numOperations / secs : 0.0) << " ops/sec, "
+              << m_crashes.size() << " distinct crashes (" << m_numCrashes << " total)\n";
+}
+
+void ThroughputRunner::writeSummary() const
+{
+    const double secs = m_elapsed.elapsed() / 1000.0;
+
+    QVariantList crashesV;
+    for (const QString &id : m_crashOrder) {
+        const Crash &crash = m_crashes.value(id);
+        QVariantMap crashV;
+        crashV[QStringLiteral("id")] = crash.id;
+        crashV[QStringLiteral("count")] = crash.count;
+        crashV[QStringLiteral("topFrame")] = crash.topFrame;
+        crashV[QStringLiteral("testcase")] = crash.testcase;
+        crashesV.push_back(crashV);
+    }
+
+    QVariantMap summary;
+    summary[QStringLiteral("jobs")] = m_options.numJobs;
+    summary[QStringLiteral("secs")] = secs;
+    summary[QStringLiteral("tests")] = m_numTests;
+    summary[QStringLiteral("operations")] = m_numOperations;
+    summary[QStringLiteral("operationsPerSec")] = secs > 0 ? m_numOperations / secs : 0.0;
+    summary[QStringLiteral("totalCrashes")] = m_numCrashes;
+    summary[QStringLiteral("crashes")] = crashesV;
+
+    QFile file(QDir(m_options.crashDir).filePath(QStringLiteral("summary.json")));
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        file.write(QJsonDocument::fromVariant(summary).toJson());
+}
+
+QStringList ThroughputRunner::stackSignature(const QByteArray &stderrOutput)
+{
+    const int begin = stderrOutput.lastIndexOf(s_stackBegin);
+    const int end = begin == -1 ? -1 : stderrOutput.indexOf(s_stackEnd, begin);
+    if (end == -1) {
+        // No backtrace available. The last thing printed is usually the warning or assert
+        const QList<QByteArray> lines = stderrOutput.trimmed().split('\n');
+        return { QStringLiteral("no stack: ") + QString::fromUtf8(lines.last()) };
+    }
+
+    const int framesStart = begin + int(sizeof(s_stackBegin)) - 1;
+    QList<QByteArray> lines = stderrOutput.mid(framesStart, end - framesStart).split('\n');
+
+    // The first two frames are crashHandler() and the signal trampoline
+    lines = lines.mid(2);
+
+    // "/path/to/libkddockwidgets.so.1.7(_ZN...+0x1c) [0x7f...]". The absolute address changes
+    // between runs, and the path between build directories, keep the rest
+    static const QRegularExpression absoluteAddress(QStringLiteral("\\s*\\[0x[0-9a-fA-F]+\\]$"));
+
+    QStringList frames;
+    for (const QByteArray &line : lines) {
+        QString frame = QString::fromUtf8(line).trimmed();
+        if (frame.isEmpty() || isIgnoredFrame(frame))
+            continue;
+
+        frame.remove(absoluteAddress);
+        frames.push_back(QFileInfo(frame).fileName());
+        if (frames.size() == s_numSignatureFrames)
+            break;
+    }
+
+    return frames;
+}
@@ -0,0 +1,103 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+// We don't care about performance related checks in the tests
+// clazy:excludeall=ctor-missing-parent-argument,missing-qobject-macro,range-loop,missing-typeinfo,detaching-member,function-args-by-ref,non-pod-global-static,reserve-candidates,qstring-allocations
+
+#ifndef KDDOCKWIDGETS_FUZZER_THROUGHPUTRUNNER_H
+#define KDDOCKWIDGETS_FUZZER_THROUGHPUTRUNNER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QVector>
+
+class QEventLoop;
+
+namespace KDDockWidgets {
+namespace Testing {
+
+/**
+ * @brief Runs fuzz tests in parallel worker processes, for a given amount of time
+ *
+ * Workers are this same executable, started with --worker. Each one runs a few random tests back
+ * to back, without any delay between operations, and then exits, so state doesn't accumulate.
+ * They report after each test how many operations they ran, which gives the operations/sec.
+ *
+ * A worker crashing, asserting or hitting a warning leaves its current test behind, along with the
+ * stack printed by installCrashHandler(). Crashes are deduplicated by that stack, so a bug that is
+ * hit a hundred times results in a single testcase in the crash directory.
+ */
+class ThroughputRunner : public QObject
+{
+public:
+    struct Options
+    {
+        int numJobs = 1;
+        int durationSecs = 60; ///< 0 runs until interrupted
+        QString crashDir;
+    };
+
+    explicit ThroughputRunner(const Options &, QObject *parent = nullptr);
+    ~ThroughputRunner() override;
+
+    ///@brief Runs the workers until the duration elapses. Returns the number of distinct crashes
+    /// or -1 if nothing could be fuzzed: the crash directory couldn't be created, a worker
+    /// couldn't be started or no test finished.
+    int exec();
+
+    ///@brief Installs handlers for fatal signals which print the stack, for the runner to parse
+    /// Only implemented with glibc. Elsewhere crashes are still caught, but not told apart.
+    static void installCrashHandler();
+
+    ///@brief Called by workers after each test, with the number of operations the test ran
+    static void reportTestFinished(qint64 numOperations);
+
+private:
+    struct Crash
+    {
+        QString id;
+        QString topFrame;
+        QString testcase;
+        int count = 0;
+    };
+
+    void startWorker(int slot);
+    void onWorkerOutput(int slot);
+    void onWorkerFinished(int slot, int exitCode, QProcess::ExitStatus);
+    void stop();
+    void printProgress() const;
+    void writeSummary() const;
+    QString currentTestFile(int slot) const;
+
+    /// Returns the frames identifying a crash, from the worker's stderr
+    static QStringList stackSignature(const QByteArray &stderrOutput);
+
+    const Options m_options;
+    QString m_workDir;
+    QVector<QProcess *> m_workers;
+    QHash<QString, Crash> m_crashes;
+    QStringList m_crashOrder;
+    QElapsedTimer m_elapsed;
+    QEventLoop *m_loop = nullptr;
+    qint64 m_numOperations = 0;
+    int m_numTests = 0;
+    int m_numCrashes = 0;
+    bool m_stopping = false;
+    bool m_failedToStart = false;
+};
+
+}
+}
+
+#endif
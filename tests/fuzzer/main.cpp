@@ -13,19 +13,26 @@
 // clazy:excludeall=ctor-missing-parent-argument,missing-qobject-macro,range-loop,missing-typeinfo,detaching-member,function-args-by-ref,non-pod-global-static,reserve-candidates,qstring-allocations
 
 #include "Fuzzer.h"
+#include "ThroughputRunner.h"
 #include "DockRegistry_p.h"
 #include "../utils.h"
 
 #include <QCommandLineParser>
 #include <QApplication>
+#include <QLoggingCategory>
+#include <QThread>
 #include <QTimer>
 #include <QDebug>
 #include <QFile>
+#include <QJsonDocument>
 #include <iostream>
 
 using namespace KDDockWidgets;
 using namespace KDDockWidgets::Testing;
 
+// Workers exit after this many tests, so state leaking from one test to the next doesn't pile up
+static const int s_testsPerWorker = 10;
+
 int main(int argc, char **argv)
 {
     if (!qpaPassedAsArgument(argc, argv)) {
@@ -54,9 +61,115 @@ int main(int argc, char **argv)
     QCommandLineOption noQuitOption("n", QCoreApplication::translate("main", "Don't quit at the end, keep event loop running for debugging"));
     parser.addOption(noQuitOption);
 
+    QCommandLineOption jobsOption(QStringList { "j", "jobs" },
+                                  QCoreApplication::translate("main", "Throughput mode. Runs random tests in <n> parallel headless processes (0 for one per core), deduplicates crashes by stack and reports operations/sec"), "n");
+    parser.addOption(jobsOption);
+
+    QCommandLineOption durationOption("duration", QCoreApplication::translate("main", "How long the throughput mode runs for, in seconds. 0 runs until interrupted. Defaults to 60"), "secs", "60");
+    parser.addOption(durationOption);
+
+    QCommandLineOption crashDirOption("crash-dir", QCoreApplication::translate("main", "Where the throughput mode saves one testcase per distinct crash. Defaults to fuzzer_crashes"), "dir", "fuzzer_crashes");
+    parser.addOption(crashDirOption);
+
+    // Internal, how ThroughputRunner starts its workers
+    QCommandLineOption workerOption("worker", QCoreApplication::translate("main", "Runs as a throughput mode worker, journaling each operation of the current test to <file>"), "file");
+    workerOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(workerOption);
+
+    // Internal, used by ctest: runs the json test like a worker would, then replays what was dumped
+    QCommandLineOption checkWorkerFileOption("check-worker-file", QCoreApplication::translate("main", "Runs the json test journaling it to <file> like a worker, then checks the journal can be replayed"), "file");
+    checkWorkerFileOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(checkWorkerFileOption);
+
     parser.addHelpOption();
     parser.process(app);
 
+    if (parser.isSet(jobsOption)) {
+        ThroughputRunner::Options runnerOptions;
+        runnerOptions.numJobs = parser.value(jobsOption).toInt();
+        if (runnerOptions.numJobs <= 0)
+            runnerOptions.numJobs = QThread::idealThreadCount();
+        runnerOptions.durationSecs = parser.value(durationOption).toInt();
+        runnerOptions.crashDir = parser.value(crashDirOption);
+
+        // 1 if nothing was fuzzed, 2 if something crashed
+        ThroughputRunner runner(runnerOptions);
+        const int numCrashes = runner.exec();
+        if (numCrashes < 0)
+            return 1;
+        return numCrashes == 0 ? 0 : 2;
+    }
+
+    if (parser.isSet(workerOption)) {
+        // Nobody reads the per-operation debug output, and it costs throughput
+        QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+        ThroughputRunner::installCrashHandler();
+
+        // No need to dump on failure, the current test is always journaled to the worker file
+        Fuzzer fuzzer(/*dumpJsonOnFailure=*/false, Fuzzer::Option_AbortOnFatal);
+        fuzzer.setDelayBetweenOperations(0);
+        fuzzer.setJournalFile(parser.value(workerOption));
+
+        QTimer::singleShot(0, &fuzzer, [&app, &fuzzer] {
+            for (int i = 0; i < s_testsPerWorker; ++i) {
+                const qint64 numOperationsBefore = fuzzer.numOperationsRun();
+                fuzzer.fuzz({ 1, 10, true });
+                ThroughputRunner::reportTestFinished(fuzzer.numOperationsRun() - numOperationsBefore);
+            }
+            app.quit();
+        });
+
+        app.setQuitOnLastWindowClosed(false);
+        return app.exec();
+    }
+
+    if (parser.isSet(checkWorkerFileOption)) {
+        const QStringList inputs = parser.positionalArguments();
+        if (inputs.size() != 1) {
+            std::cerr << "--check-worker-file needs exactly one json test\n";
+            return 1;
+        }
+
+        const QString workerFile = parser.value(checkWorkerFileOption);
+        Fuzzer fuzzer(/*dumpJsonOnFailure=*/false, Fuzzer::Option_None);
+        fuzzer.setDelayBetweenOperations(0);
+
+        int result = 1;
+        QTimer::singleShot(0, &fuzzer, [&app, &fuzzer, &result, &inputs, &workerFile] {
+            fuzzer.setJournalFile(workerFile);
+            fuzzer.fuzz(inputs.first());
+            fuzzer.setJournalFile({});
+
+            // The journal must hold every operation that ran, not just the initial layout
+            QFile file(workerFile);
+            const QVariantMap dumped = file.open(QIODevice::ReadOnly) ? Fuzzer::journalToVariantMap(file.readAll())
+                                                                      : QVariantMap();
+            file.close();
+            const int numDumped = dumped.value(QStringLiteral("operations")).toList().size();
+            if (numDumped == 0 || numDumped != fuzzer.numOperationsRun()) {
+                std::cerr << "Worker file has " << numDumped << " operations, but "
+                          << fuzzer.numOperationsRun() << " ran\n";
+            } else {
+                // Replayed like the runner saves crash testcases
+                const QString testcaseFile = workerFile + QStringLiteral(".json");
+                QFile testcase(testcaseFile);
+                if (testcase.open(QIODevice::WriteOnly | QIODevice::Truncate))
+                    testcase.write(QJsonDocument::fromVariant(dumped).toJson());
+                testcase.close();
+                fuzzer.fuzz(testcaseFile);
+                result = fuzzer.numOperationsRun() == 2 * numDumped ? 0 : 1;
+                if (result != 0)
+                    std::cerr << "Replaying the worker file didn't run all of its operations\n";
+            }
+
+            app.quit();
+        });
+
+        app.setQuitOnLastWindowClosed(false);
+        app.exec();
+        return result;
+    }
+
     const bool slowDown = parser.isSet(slowDownOption);
     const bool forceDumpJson = parser.isSet(forceDumpJsonOption);
 
@@ -18,7 +18,12 @@
 #include "DockWidgetBase_p.h"
 #include "DropAreaWithCentralFrame_p.h"
 #include "Frame_p.h"
+#include "FloatingWindowPool_p.h"
+#include "IconCache_p.h"
+#include "FrameworkWidgetFactory.h"
 #include "KDDockWidgets.h"
+#include "LayoutLinter_p.h"
+#include "LayoutPresetCache.h"
 #include "LayoutSaver.h"
 #include "LayoutSaver_p.h"
 #include "MDILayoutWidget_p.h"
@@ -33,7 +38,20 @@
 #include "multisplitter/Item_p.h"
 #include "private/MultiSplitter_p.h"
 
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+#include "multisplitter/Separator_qwidget.h"
+#include "multisplitter/SeparatorOverlay_qwidget.h"
+#include "WidgetResizeHandler_p.h"
+
+#include <QRubberBand>
+#else
+#include "quick/FrameQuick_p.h"
+
+#include <QQmlComponent>
+#endif
+
 #include <QAction>
+#include <QThreadPool>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -978,6 +996,266 @@ void TestDocks::tst_complex()
     qDeleteAll(docks);
     qDeleteAll(DockRegistry::self()->frames());
 }
+
+void TestDocks::tst_separatorOverlay()
+{
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_SeparatorOverlay);
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    auto dock3 = createDockWidget("dock3", new QPushButton("three"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnBottom, dock2);
+
+    MultiSplitter *layout = m->multiSplitter();
+    QVERIFY(layout->checkSanity());
+
+    // No widget per separator, just one layer
+    QVERIFY(m->findChildren<Layouting::SeparatorWidget *>().isEmpty());
+    const auto overlays = layout->findChildren<Layouting::SeparatorOverlay *>(QString(), Qt::FindDirectChildrenOnly);
+    QCOMPARE(overlays.size(), 1);
+    Layouting::SeparatorOverlay *overlay = overlays.constFirst();
+    QCOMPARE(overlay->geometry(), layout->rect());
+
+    // Hit-testing finds nested separators too
+    const Separator::List separators = layout->rootItem()->separators_recursive();
+    QCOMPARE(separators.size(), 2);
+    for (Separator *separator : separators) {
+        QVERIFY(!separator->asWidget());
+        QCOMPARE(overlay->separatorAt(separator->geometry().center()), separator);
+    }
+    QVERIFY(!overlay->separatorAt(dock1->dptr()->frame()->geometry().center()));
+
+    // Used by checkSanity() when it fails, mustn't need separator widgets
+    layout->rootItem()->dumpLayout();
+
+    // Double-click still distributes the space equally
+    Separator *separator = layout->rootItem()->separators().constFirst();
+    layout->rootItem()->requestSeparatorMove(separator, -150);
+    Frame *frame1 = dock1->dptr()->frame();
+    Frame *frame2 = dock2->dptr()->frame();
+    QVERIFY(qAbs(frame1->width() - frame2->width()) > 100);
+
+    const QPoint globalPos = overlay->mapToGlobal(separator->geometry().center());
+    doubleClickOn(globalPos, overlay);
+    releaseOn(globalPos, overlay);
+    QVERIFY(!Separator::isResizing());
+    QVERIFY(qAbs(frame1->width() - frame2->width()) <= 1);
+    QCOMPARE(overlay->separatorAt(separator->geometry().center()), separator);
+
+    // Follows resizes of the layout
+    m->resize(QSize(1000, 600));
+    QVERIFY(Testing::waitForResize(m.get()));
+    QCOMPARE(overlay->geometry(), layout->rect());
+    QVERIFY(layout->checkSanity());
+}
+
+void TestDocks::tst_lazyResizeMDI()
+{
+    // Tests that with Flag_LazyResize MDI frames only get their new size when the mouse is released
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_LazyResize);
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_MDI);
+    auto layoutWidget = qobject_cast<MDILayoutWidget *>(m->layoutWidget());
+    auto dock0 = createDockWidget("dock0", new MyWidget2(QSize(200, 200)));
+    layoutWidget->addDockWidget(dock0, QPoint(10, 10), {});
+
+    Frame *frame = dock0->dptr()->frame();
+    WidgetResizeHandler *handler = frame->resizeHandler();
+    QVERIFY(handler);
+    QVERIFY(handler->usesLazyResize());
+
+    const QSize initialSize = frame->QWidgetAdapter::size();
+    const QPoint pressPos = frame->QWidgetAdapter::mapToGlobal(QPoint(initialSize.width() - WidgetResizeHandler::widgetResizeHandlerMargin(),
+                                                                      initialSize.height() / 2));
+    pressOn(pressPos, frame);
+    QVERIFY(handler->isResizing());
+
+    const QPoint dest = pressPos + QPoint(100, 0);
+    QMouseEvent moveEv(QEvent::MouseMove, frame->QWidgetAdapter::mapFromGlobal(dest), m->mapFromGlobal(dest), dest,
+                       Qt::NoButton, Qt::LeftButton, Qt::NoModifier);
+    qApp->sendEvent(frame, &moveEv);
+
+    // Only the outline moved
+    QCOMPARE(frame->QWidgetAdapter::size(), initialSize);
+    auto rubberBand = layoutWidget->findChild<QRubberBand *>();
+    QVERIFY(rubberBand);
+    QVERIFY(rubberBand->isVisible());
+    QVERIFY(rubberBand->width() > initialSize.width() + 90);
+
+    releaseOn(dest, frame);
+    QVERIFY(!handler->isResizing());
+    QVERIFY(!rubberBand->isVisible());
+    QVERIFY(frame->QWidgetAdapter::width() > initialSize.width() + 90);
+    QCOMPARE(frame->QWidgetAdapter::height(), initialSize.height());
+
+    // The layout item was updated too
+    QCOMPARE(layoutWidget->itemForFrame(frame)->geometry(), frame->QWidgetAdapter::geometry());
+}
+
+void TestDocks::tst_iconCache()
+{
+    EnsureTopLevelsDeleted e;
+    IconCache *cache = IconCache::self();
+    cache->clear();
+    cache->resetStats();
+
+    QPixmap source(64, 64);
+    source.fill(Qt::red);
+    const QIcon icon(source);
+
+    // Null icons aren't cached nor counted
+    QVERIFY(cache->pixmap(QIcon(), QSize(16, 16), 1.0).isNull());
+    QCOMPARE(cache->stats().misses, 0);
+
+    // Rasterized at device pixels, but with the logical size
+    const QPixmap pix = cache->pixmap(icon, QSize(16, 16), 2.0);
+    QCOMPARE(pix.size(), QSize(32, 32));
+    QCOMPARE(pix.devicePixelRatio(), 2.0);
+    QCOMPARE(cache->stats().misses, 1);
+    QCOMPARE(cache->stats().hits, 0);
+
+    QCOMPARE(cache->pixmap(icon, QSize(16, 16), 2.0).cacheKey(), pix.cacheKey());
+    QCOMPARE(cache->stats().hits, 1);
+
+    // Another DPR is another entry
+    QCOMPARE(cache->pixmap(icon, QSize(16, 16), 1.0).size(), QSize(16, 16));
+    QCOMPARE(cache->stats().misses, 2);
+    QCOMPARE(cache->count(), 2);
+
+    // Each mode and state is another entry
+    QPixmap disabledSource(64, 64);
+    disabledSource.fill(Qt::gray);
+    QIcon twoModes(source);
+    twoModes.addPixmap(disabledSource, QIcon::Disabled);
+    const QImage disabledPix = cache->pixmap(twoModes, QSize(16, 16), 1.0, QIcon::Disabled).toImage();
+    QCOMPARE(disabledPix.pixelColor(8, 8), QColor(Qt::gray));
+    QCOMPARE(cache->pixmap(twoModes, QSize(16, 16), 1.0).toImage().pixelColor(8, 8), QColor(Qt::red));
+    QCOMPARE(cache->stats().misses, 4);
+
+    // The same QIcon is shared, and it keeps the modes of the original
+    const QIcon cachedIcon = cache->icon(twoModes);
+    QCOMPARE(cachedIcon.cacheKey(), cache->icon(twoModes).cacheKey());
+    QCOMPARE(cachedIcon.pixmap(QSize(16, 16), QIcon::Disabled).toImage().pixelColor(8, 8), QColor(Qt::gray));
+    QCOMPARE(cachedIcon.pixmap(QSize(16, 16), QIcon::Normal).toImage().pixelColor(8, 8), QColor(Qt::red));
+
+    // Title bars and tabs showing the same icon don't rasterize it again
+    cache->clear();
+    cache->resetStats();
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    auto dock3 = createDockWidget("dock3", new QPushButton("three"));
+    dock1->setIcon(icon);
+    dock2->setIcon(icon);
+    dock3->setIcon(icon);
+    dock1->addDockWidgetAsTab(dock2);
+
+    const int misses = cache->stats().misses;
+    QVERIFY(misses > 0);
+    QVERIFY(cache->stats().hits > 0);
+    QVERIFY(misses <= cache->count());
+
+    cache->clear();
+    cache->resetStats();
+}
+
+void TestDocks::tst_resizeHandlerDispatcher()
+{
+    // Tests that MDI frames share a single event filter, which only calls the resize handler under the cursor
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(1000, 600), MainWindowOption_MDI);
+    auto layoutWidget = qobject_cast<MDILayoutWidget *>(m->layoutWidget());
+    auto dock0 = createDockWidget("dock0", new MyWidget2(QSize(200, 200)));
+    auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(200, 200)));
+    layoutWidget->addDockWidget(dock0, QPoint(10, 10), {});
+    layoutWidget->addDockWidget(dock1, QPoint(500, 10), {});
+
+    Frame *frame0 = dock0->dptr()->frame();
+    Frame *frame1 = dock1->dptr()->frame();
+    WidgetResizeHandler *handler0 = frame0->resizeHandler();
+    WidgetResizeHandler *handler1 = frame1->resizeHandler();
+
+    auto dispatcher = WidgetResizeHandlerDispatcher::dispatcherForHost(layoutWidget);
+    QVERIFY(dispatcher);
+    QCOMPARE(handler0->dispatcher(), dispatcher);
+    QCOMPARE(handler1->dispatcher(), dispatcher);
+    QCOMPARE(dispatcher->handlerCount(), 2);
+
+    // The resize margin extends beyond the frame
+    const int margin = WidgetResizeHandler::widgetResizeHandlerMargin();
+    const QRect geo0 = frame0->QWidgetAdapter::geometry();
+    const QRect geo1 = frame1->QWidgetAdapter::geometry();
+    QCOMPARE(dispatcher->handlerAt(QPoint(geo0.right() + margin, geo0.center().y())), handler0);
+    QCOMPARE(dispatcher->handlerAt(QPoint(geo1.left() - margin, geo1.center().y())), handler1);
+    QVERIFY(!dispatcher->handlerAt(QPoint(geo0.right() + margin + 1, geo0.center().y())));
+
+    // The edge map follows the frames
+    layoutWidget->moveDockWidget(dock0, QPoint(100, 300));
+    const QRect movedGeo0 = frame0->QWidgetAdapter::geometry();
+    QVERIFY(movedGeo0 != geo0);
+    QVERIFY(!dispatcher->handlerAt(geo0.topLeft()));
+    QCOMPARE(dispatcher->handlerAt(movedGeo0.topLeft()), handler0);
+
+    // Pressing just outside the frame, over the layout, resizes it
+    const QPoint pressPos = layoutWidget->mapToGlobal(QPoint(geo1.right() + 1, geo1.center().y()));
+    pressOn(pressPos, layoutWidget);
+    QVERIFY(handler1->isResizing());
+    QVERIFY(!handler0->isResizing());
+    releaseOn(pressPos, layoutWidget);
+    QVERIFY(!handler1->isResizing());
+
+    // Handlers unregister when their frame goes away
+    delete dock1;
+    QVERIFY(Testing::waitForDeleted(handler1));
+    QCOMPARE(dispatcher->handlerCount(), 1);
+    QVERIFY(!dispatcher->handlerAt(QPoint(geo1.left() - margin, geo1.center().y())));
+}
+
+void TestDocks::tst_mdiZOrder()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(1000, 600), MainWindowOption_MDI);
+    auto layoutWidget = qobject_cast<MDILayoutWidget *>(m->layoutWidget());
+    auto dock0 = createDockWidget("dock0", new MyWidget2(QSize(300, 300)));
+    auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(300, 300)));
+    auto dock2 = createDockWidget("dock2", new MyWidget2(QSize(300, 300)));
+    layoutWidget->addDockWidget(dock0, QPoint(10, 10), {});
+    layoutWidget->addDockWidget(dock1, QPoint(50, 50), {});
+    layoutWidget->addDockWidget(dock2, QPoint(600, 10), {});
+
+    Frame *frame0 = dock0->dptr()->frame();
+    Frame *frame1 = dock1->dptr()->frame();
+    const QPoint overlap(100, 100);
+    QCOMPARE(layoutWidget->frameAt(overlap), frame1);
+    QCOMPARE(layoutWidget->framesIntersecting(QRect(0, 0, 400, 400)), (QVector<Frame *> { frame0, frame1 }));
+
+    // Clicking a frame raises both the widget and its layout item
+    const QPoint pressPos = frame0->mapToGlobal(QPoint(20, 150));
+    pressOn(pressPos, frame0);
+    releaseOn(pressPos, frame0);
+    QCOMPARE(layoutWidget->frameAt(overlap), frame0);
+    QVERIFY(layoutWidget->children().indexOf(frame0) > layoutWidget->children().indexOf(frame1));
+
+    dock0->setMDIZ(-1);
+    QCOMPARE(layoutWidget->dockWidgetZ(frame0), -1);
+    QCOMPARE(layoutWidget->frameAt(overlap), frame1);
+    QVERIFY(layoutWidget->children().indexOf(frame0) < layoutWidget->children().indexOf(frame1));
+
+    dock0->raise();
+    QCOMPARE(layoutWidget->dockWidgetZ(frame0), 0);
+    QCOMPARE(layoutWidget->frameAt(overlap), frame0);
+    QVERIFY(layoutWidget->checkSanity());
+
+    // The z is saved with the layout
+    dock1->setMDIZ(3);
+    LayoutSaver saver;
+    const QByteArray saved = saver.serializeLayout();
+    QVERIFY(saved.contains("\"z\": 3"));
+}
 #else
 void TestDocks::tst_hoverShowsDropIndicators()
 {
@@ -1008,6 +1286,199 @@ void TestDocks::tst_hoverShowsDropIndicators()
 
     QCOMPARE(dock0->dptr()->frame()->dockWidgetCount(), 2);
 }
+
+void TestDocks::tst_qmlComponentCache()
+{
+    EnsureTopLevelsDeleted e;
+    FrameworkWidgetFactory *factory = Config::self().frameworkWidgetFactory();
+    QQmlEngine *engine = Config::self().qmlEngine();
+
+    QQmlComponent *component = factory->qmlComponent(engine, factory->frameFilename());
+    QVERIFY(component);
+    QVERIFY(component->isReady());
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(400, 400)), {}, {}, /*show=*/false);
+    auto dock2 = createDockWidget("dock2", new MyWidget2(QSize(400, 400)), {}, {}, /*show=*/false);
+
+    // Frames are created from the cached component
+    const int hits = factory->qmlComponentCacheStats().hits;
+    m->addDockWidget(dock1, Location_OnLeft);
+    QVERIFY(factory->qmlComponentCacheStats().hits > hits);
+    QCOMPARE(factory->qmlComponent(engine, factory->frameFilename()), component);
+
+    // Asynchronous creation, the QQuickView installed an incubation controller
+    QVERIFY(engine->incubationController());
+    factory->setAsynchronousFrameCreation(true);
+    m->addDockWidget(dock2, Location_OnRight);
+    factory->setAsynchronousFrameCreation(false);
+
+    auto frame2 = qobject_cast<FrameQuick *>(dock2->dptr()->frame());
+    QVERIFY(frame2);
+    QVERIFY(!frame2->visualItem());
+    QVERIFY(dock2->parent() == frame2);
+
+    QVERIFY(QTest::qWaitFor([frame2] { return frame2->visualItem() != nullptr; }));
+    QVERIFY(dock2->parent() != frame2);
+    QCOMPARE(frame2->dockWidgets(), DockWidgetBase::List { dock2 });
+    QVERIFY(m->layoutWidget()->checkSanity());
+}
+
+void TestDocks::tst_mouseEventRedirector()
+{
+    class Target : public QWidgetAdapter
+    {
+    public:
+        bool event(QEvent *ev) override
+        {
+            if (ev->type() == QEvent::MouseButtonPress) {
+                numPresses++;
+                lastCursorPosition = redirectedCursorPosition();
+            }
+            return QWidgetAdapter::event(ev);
+        }
+
+        int numPresses = 0;
+        CursorPosition lastCursorPosition = CursorPosition_Undefined;
+    };
+
+    QQmlComponent component(Config::self().qmlEngine());
+    component.setData("import QtQuick 2.9\nMouseArea { property int cursorPosition: 0 }", QUrl());
+    std::unique_ptr<QObject> source(component.create());
+    QVERIFY(source);
+
+    Target target;
+    target.redirectMouseEvents(source.get());
+
+    auto press = [&source] {
+        QMouseEvent ev(QEvent::MouseButtonPress, QPointF(1, 1), Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+        QCoreApplication::sendEvent(source.get(), &ev);
+    };
+
+    press();
+    QCOMPARE(target.numPresses, 1);
+    QCOMPARE(target.lastCursorPosition, CursorPosition_Undefined);
+
+    // The cached properties follow the QML ones
+    source->setProperty("cursorPosition", int(CursorPosition_Left));
+    press();
+    QCOMPARE(target.numPresses, 2);
+    QCOMPARE(target.lastCursorPosition, CursorPosition_Left);
+    QCOMPARE(target.redirectedCursorPosition(), CursorPosition_Undefined);
+
+    source->setProperty("enabled", false);
+    press();
+    QCOMPARE(target.numPresses, 2);
+}
+
+void TestDocks::tst_indicatorsItem()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(400, 400)));
+    m->addDockWidget(dock1, Location_OnLeft);
+    auto dock2 = createDockWidget("dock2", new MyWidget2(QSize(400, 400)));
+
+    DropArea *dropArea = m->dropArea();
+    DropIndicatorOverlayInterface *indicators = dropArea->dropIndicatorOverlay();
+    auto draggable = draggableFor(dock2->floatingWindow());
+
+    // Drag over the main window, without releasing, so the indicators are shown
+    const QPoint center = dropArea->window()->mapToGlobal(dropArea->window()->rect().center());
+    drag(draggable, KDDockWidgets::mapToGlobal(draggable, QPoint(10, 10)), center, ButtonAction_Press);
+    QCOMPARE(indicators->hoveredFrame(), dock1->dptr()->frame());
+
+    // Hit-testing matches the painted positions
+    for (DropLocation loc : { DropLocation_Left, DropLocation_Right, DropLocation_Top, DropLocation_Center }) {
+        QCOMPARE(indicators->hover(indicators->posForIndicator(loc)), loc);
+        QCOMPARE(indicators->currentDropLocation(), loc);
+    }
+
+    drag(draggable, QPoint(), indicators->posForIndicator(DropLocation_Right), ButtonAction_Release);
+    QVERIFY(!dock2->isFloating());
+    QCOMPARE(dock2->dptr()->frame()->dockWidgets(), DockWidgetBase::List { dock2 });
+}
+
+void TestDocks::tst_batchedGeometryChanges()
+{
+    // Counts how often QML bindings on the layout items are re-evaluated while resizing the main window.
+    // Without Flag_BatchedGeometryChanges bindings follow x, y, width and height, each notified separately.
+    // With it they follow the geometry, which is notified once per layout pass.
+    const int numResizes = 20;
+
+    auto countEvaluations = [numResizes](bool batched) {
+        EnsureTopLevelsDeleted e;
+        if (batched)
+            Config::self().setFlags(Config::self().flags() | Config::Flag_BatchedGeometryChanges);
+
+        auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+        m->addDockWidget(createDockWidget("dock1", new MyWidget2(QSize(100, 100))), Location_OnLeft);
+        m->addDockWidget(createDockWidget("dock2", new MyWidget2(QSize(100, 100))), Location_OnRight);
+        m->addDockWidget(createDockWidget("dock3", new MyWidget2(QSize(100, 100))), Location_OnBottom);
+        Item::flushGeometryChanges();
+
+        QQmlComponent component(Config::self().qmlEngine());
+        component.setData(batched ? "import QtQuick 2.9\nQtObject { property QtObject counter; property QtObject item;"
+                                    "property rect geo: item ? counter.count(item.geometry) : Qt.rect(0, 0, 0, 0) }"
+                                  : "import QtQuick 2.9\nQtObject { property QtObject counter; property QtObject item;"
+                                    "property rect geo: item ? counter.count(Qt.rect(item.x, item.y, item.width, item.height)) : Qt.rect(0, 0, 0, 0) }",
+                          QUrl());
+
+        BindingCounter counter;
+        std::vector<std::unique_ptr<QObject>> bindings;
+        const auto frames = m->layoutWidget()->frames();
+        for (Frame *frame : frames) {
+            std::unique_ptr<QObject> binding(component.create());
+            binding->setProperty("counter", QVariant::fromValue<QObject *>(&counter));
+            binding->setProperty("item", QVariant::fromValue<QObject *>(frame->layoutItem()));
+            bindings.push_back(std::move(binding));
+        }
+
+        counter.numEvaluations = 0;
+        for (int i = 1; i <= numResizes; ++i) {
+            m->resize(QSize(800 + i * 10, 500 + i * 5));
+            Item::flushGeometryChanges(); // So we don't depend on how many resizes an event loop pass sees
+        }
+
+        return counter.numEvaluations;
+    };
+
+    const int perAxisEvaluations = countEvaluations(false);
+    const int batchedEvaluations = countEvaluations(true);
+
+    // Each resize changes the width and height of some items, the x or y of others
+    QVERIFY(perAxisEvaluations > 0);
+    QVERIFY(batchedEvaluations > 0);
+    QVERIFY(batchedEvaluations <= 3 * numResizes);
+    QVERIFY(batchedEvaluations < perAxisEvaluations);
+
+    {
+        // Without flushing, it's delivered on the next event loop pass
+        EnsureTopLevelsDeleted e;
+        Config::self().setFlags(Config::self().flags() | Config::Flag_BatchedGeometryChanges);
+        auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+        auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(100, 100)));
+        m->addDockWidget(dock1, Location_OnLeft);
+        Item::flushGeometryChanges();
+        QTest::qWait(0);
+
+        auto dockQuick = static_cast<DockWidgetQuick *>(dock1);
+        Item *item = dock1->dptr()->frame()->layoutItem();
+        QSignalSpy itemSpy(item, &Item::geometryChanged);
+        QSignalSpy widthSpy(item, &Item::widthChanged);
+        QSignalSpy frameSpy(dockQuick, &DockWidgetQuick::frameGeometryChanged);
+
+        m->resize(QSize(850, 550));
+        m->resize(QSize(900, 600));
+        QCOMPARE(itemSpy.count(), 0);
+        QCOMPARE(frameSpy.count(), 0);
+
+        QTRY_COMPARE(itemSpy.count(), 1);
+        QTRY_COMPARE(frameSpy.count(), 1);
+        QCOMPARE(itemSpy.at(0).at(0).toRect(), item->geometry());
+        QCOMPARE(widthSpy.count(), 0);
+    }
+}
 #endif
 
 void TestDocks::tst_28NestedWidgets_data()
@@ -2691,6 +3162,46 @@ void TestDocks::tst_tabTitleChanges()
     delete dw1->window();
 }
 
+void TestDocks::tst_deferredTitleUpdates()
+{
+    // Tests that with Flag_DeferTitleUpdates title changes are only applied on the next event loop pass, once
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_DeferTitleUpdates);
+
+    auto dw1 = new DockWidgetType(QStringLiteral("1"));
+    auto dw2 = new DockWidgetType(QStringLiteral("2"));
+    dw1->addDockWidgetAsTab(dw2);
+
+    Frame *frame = dw1->dptr()->frame();
+    frame->applyPendingUpdates();
+    QVERIFY(!frame->hasPendingUpdates());
+
+    TabBar *tb = frame->tabWidget()->tabBar();
+    TitleBar *titleBar = frame->titleBar();
+    QCOMPARE(frame->currentDockWidget(), dw2);
+    QCOMPARE(titleBar->title(), QStringLiteral("2"));
+
+    for (int i = 0; i < 10; ++i)
+        dw2->setTitle(QStringLiteral("title %1").arg(i));
+
+    // Nothing changed yet
+    QVERIFY(frame->hasPendingUpdates());
+    QCOMPARE(tb->text(1), QStringLiteral("2"));
+    QCOMPARE(titleBar->title(), QStringLiteral("2"));
+
+    QTRY_VERIFY(!frame->hasPendingUpdates());
+    QCOMPARE(tb->text(1), QStringLiteral("title 9"));
+    QCOMPARE(titleBar->title(), QStringLiteral("title 9"));
+
+    // Can be applied on demand too
+    dw2->setTitle(QStringLiteral("other"));
+    frame->applyPendingUpdates();
+    QCOMPARE(tb->text(1), QStringLiteral("other"));
+    QCOMPARE(titleBar->title(), QStringLiteral("other"));
+
+    delete dw1->window();
+}
+
 void TestDocks::tst_dockWidgetGetsFocusWhenDocked()
 {
     EnsureTopLevelsDeleted e;
@@ -2799,6 +3310,54 @@ void TestDocks::tst_isFocused()
     delete dock2->window();
 }
 
+void TestDocks::tst_focusScopeDispatch()
+{
+    // Tests that the FocusScopes are kept up to date, now that only the ones gaining or losing
+    // focus get notified
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget(QStringLiteral("dock1"), new FocusableWidget());
+    auto dock2 = createDockWidget(QStringLiteral("dock2"), new FocusableWidget());
+    auto dock3 = createDockWidget(QStringLiteral("dock3"), new FocusableWidget());
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnRight);
+    m->activateWindow();
+    QVERIFY(QTest::qWaitForWindowActive(m->windowHandle()));
+
+    Frame *frame1 = dock1->dptr()->frame();
+    Frame *frame2 = dock2->dptr()->frame();
+    QPointer<Frame> frame3 = dock3->dptr()->frame();
+
+    dock1->widget()->setFocus(Qt::OtherFocusReason);
+    QVERIFY(dock1->widget()->hasFocus() || Testing::waitForEvent(dock1->widget(), QEvent::FocusIn));
+    QVERIFY(frame1->isFocused());
+    QVERIFY(!frame2->isFocused());
+    QVERIFY(!frame3->isFocused());
+    QVERIFY(frame1->focusedWidget());
+
+    dock3->widget()->setFocus(Qt::OtherFocusReason);
+    QVERIFY(dock3->widget()->hasFocus() || Testing::waitForEvent(dock3->widget(), QEvent::FocusIn));
+    QVERIFY(!frame1->isFocused());
+    QVERIFY(!frame2->isFocused());
+    QVERIFY(frame3->isFocused());
+    QVERIFY(dock3->isFocused());
+
+    // The scope which lost focus still remembers what to focus next time
+    QVERIFY(frame1->focusedWidget());
+
+    // Delete the focused scope, shouldn't leave a dangling entry behind
+    dock3->close();
+    QVERIFY(Testing::waitForDeleted(frame3));
+
+    dock2->widget()->setFocus(Qt::OtherFocusReason);
+    QVERIFY(dock2->widget()->hasFocus() || Testing::waitForEvent(dock2->widget(), QEvent::FocusIn));
+    QVERIFY(!frame1->isFocused());
+    QVERIFY(frame2->isFocused());
+    QVERIFY(dock2->isFocused());
+    QVERIFY(!dock1->isFocused());
+}
+
 void TestDocks::tst_setWidget()
 {
     EnsureTopLevelsDeleted e;
@@ -3040,6 +3599,243 @@ void TestDocks::tst_createFloatingWindow()
     QVERIFY(!window);
 }
 
+void TestDocks::tst_floatingWindowPool()
+{
+    EnsureTopLevelsDeleted e;
+    Config::self().setFloatingWindowPoolSize(2);
+    FloatingWindowPool *pool = FloatingWindowPool::self();
+    pool->resetStats();
+
+    auto m = createMainWindow();
+    QTRY_COMPARE(pool->count(), 2); // pre-warmed
+
+    auto dock1 = createDockWidget("dock1", Qt::green);
+    QPointer<FloatingWindow> fw1 = dock1->floatingWindow();
+    QVERIFY(fw1);
+    QVERIFY(!fw1->isPooled());
+    QCOMPARE(pool->count(), 1);
+    QCOMPARE(pool->stats().hits, 1);
+
+    // Docking empties the floating window, which goes back into the pool instead of being deleted
+    m->addDockWidget(dock1, KDDockWidgets::Location_OnLeft);
+    QVERIFY(fw1);
+    QVERIFY(fw1->isPooled());
+    QVERIFY(fw1->beingDeleted());
+    QVERIFY(!fw1->isVisible());
+    QVERIFY(!DockRegistry::self()->floatingWindows().contains(fw1));
+    QCOMPARE(pool->count(), 2);
+
+    // Floating again reuses a pooled window
+    dock1->setFloating(true);
+    QVERIFY(dock1->floatingWindow());
+    QVERIFY(dock1->floatingWindow()->isVisible());
+    QCOMPARE(pool->count(), 1);
+    QCOMPARE(pool->stats().hits, 2);
+    QCOMPARE(pool->stats().misses, 0);
+    QVERIFY(m->layoutWidget()->checkSanity());
+    QVERIFY(dock1->floatingWindow()->layoutWidget()->checkSanity());
+
+    // Closing leaves a placeholder, so that window can't be recycled
+    auto fw2 = dock1->floatingWindow();
+    dock1->close();
+    QVERIFY(Testing::waitForDeleted(fw2));
+    QCOMPARE(pool->count(), 1);
+    QCOMPARE(pool->stats().rejected, 1);
+
+    Config::self().setFloatingWindowPoolSize(0);
+    QCOMPARE(pool->count(), 0);
+    delete dock1;
+}
+
+void TestDocks::tst_restoreWithFrameRecycling_data()
+{
+    QTest::addColumn<int>("recyclingLimit");
+
+    QTest::newRow("without recycling") << 0;
+    QTest::newRow("with recycling") << 250;
+}
+
+void TestDocks::tst_restoreWithFrameRecycling()
+{
+    // Also a benchmark. Restores the same 200 frame layout, with and without recycling frames.
+    QFETCH(int, recyclingLimit);
+
+    EnsureTopLevelsDeleted e;
+    FrameworkWidgetFactory *factory = Config::self().frameworkWidgetFactory();
+    factory->setFrameRecyclingLimit(recyclingLimit);
+    const auto statsBefore = factory->frameRecyclingStats();
+
+    const int numColumns = 20;
+    const int numRows = 10;
+    auto m = createMainWindow(QSize(3000, 2000), MainWindowOption_None);
+    for (int col = 0; col < numColumns; ++col) {
+        auto top = createDockWidget(QStringLiteral("dock-%1-0").arg(col), Qt::green);
+        m->addDockWidget(top, Location_OnRight);
+        for (int row = 1; row < numRows; ++row) {
+            auto dw = createDockWidget(QStringLiteral("dock-%1-%2").arg(col).arg(row), Qt::green);
+            m->addDockWidget(dw, Location_OnBottom, top);
+        }
+    }
+
+    QCOMPARE(m->layoutWidget()->visibleCount(), numColumns * numRows);
+
+    LayoutSaver saver;
+    const QByteArray saved = saver.serializeLayout();
+
+    // Warm up. Frames emptied by a restore are only deleted, or recycled, once we're back in the event loop
+    QVERIFY(saver.restoreLayout(saved));
+    QCoreApplication::processEvents();
+
+    QBENCHMARK {
+        QVERIFY(saver.restoreLayout(saved));
+        QCoreApplication::processEvents();
+    }
+
+    QVERIFY(m->layoutWidget()->checkSanity());
+    QCOMPARE(m->layoutWidget()->visibleCount(), numColumns * numRows);
+    QCOMPARE(DockRegistry::self()->frames().size(), numColumns * numRows);
+
+    const auto stats = factory->frameRecyclingStats();
+    if (recyclingLimit > 0) {
+        QVERIFY(stats.hits - statsBefore.hits >= numColumns * numRows);
+        QVERIFY(stats.recycled - statsBefore.recycled >= numColumns * numRows);
+    } else {
+        QCOMPARE(stats.hits, statsBefore.hits);
+    }
+
+    factory->setFrameRecyclingLimit(0);
+}
+
+void TestDocks::tst_frameRecyclingSkipsCentralFrame()
+{
+    // A recycled frame must not be handed out as the central frame, which canBeRecycled() refuses to pool
+    EnsureTopLevelsDeleted e;
+    FrameworkWidgetFactory *factory = Config::self().frameworkWidgetFactory();
+    factory->setFrameRecyclingLimit(1);
+
+    QPointer<Frame> recycled = factory->acquireFrame();
+    QVERIFY(factory->recycleFrame(recycled));
+    const auto statsBefore = factory->frameRecyclingStats();
+
+    auto m = createMainWindow(QSize(1000, 1000), MainWindowOption_HasCentralFrame);
+    const auto frames = DockRegistry::self()->frames();
+    QCOMPARE(frames.size(), 1);
+    QVERIFY(frames.first() != recycled);
+    QVERIFY(frames.first()->isCentralFrame());
+    QCOMPARE(factory->frameRecyclingStats().hits, statsBefore.hits);
+
+    factory->setFrameRecyclingLimit(0);
+    QVERIFY(!recycled);
+}
+
+void TestDocks::tst_layoutPresetCache()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    LayoutPresetCache presets;
+    QVERIFY(presets.capture(QStringLiteral("both")));
+
+    dock2->close();
+    QVERIFY(presets.capture(QStringLiteral("single")));
+    QCOMPARE(presets.count(), 2);
+
+    QVERIFY(presets.apply(QStringLiteral("both")));
+    QVERIFY(m->layoutWidget()->checkSanity());
+    QVERIFY(dock1->isVisible());
+    QVERIFY(dock2->isVisible());
+    QCOMPARE(m->layoutWidget()->visibleCount(), 2);
+    QCOMPARE(presets.restoredDockWidgets().size(), 2);
+
+    QVERIFY(presets.apply(QStringLiteral("single")));
+    QVERIFY(m->layoutWidget()->checkSanity());
+    QVERIFY(dock1->isVisible());
+    QVERIFY(!dock2->isVisible());
+    QCOMPARE(m->layoutWidget()->visibleCount(), 1);
+
+    // Round-trips through JSON and is compatible with LayoutSaver
+    const QByteArray json = presets.toJson(QStringLiteral("both"));
+    QVERIFY(!json.isEmpty());
+    QVERIFY(presets.insert(QStringLiteral("fromJson"), json));
+    QVERIFY(presets.apply(QStringLiteral("fromJson")));
+    QVERIFY(dock2->isVisible());
+    LayoutSaver saver;
+    QVERIFY(saver.restoreLayout(presets.toJson(QStringLiteral("single"))));
+    QVERIFY(!dock2->isVisible());
+
+    {
+        SetExpectedWarning sew("Unknown preset");
+        QVERIFY(!presets.apply(QStringLiteral("unknown")));
+    }
+    {
+        SetExpectedWarning sew("Failed to parse json data");
+        QVERIFY(!presets.insert(QStringLiteral("invalid"), QByteArray("{ invalid")));
+        QVERIFY(!presets.contains(QStringLiteral("invalid")));
+    }
+    QVERIFY(presets.remove(QStringLiteral("fromJson")));
+    QCOMPARE(presets.count(), 2);
+
+    delete dock2;
+}
+
+void TestDocks::tst_compactPlaceholders()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto layout = m->layoutWidget();
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    auto dock3 = createDockWidget("dock3", new QPushButton("three"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnBottom);
+
+    QPointer<Frame> frame1 = dock1->dptr()->frame();
+    dock1->close();
+    QVERIFY(Testing::waitForDeleted(frame1));
+    QTest::qWait(10); // So dock2's placeholder is younger
+
+    QPointer<Frame> frame2 = dock2->dptr()->frame();
+    dock2->close();
+    QVERIFY(Testing::waitForDeleted(frame2));
+
+    auto stats = layout->placeholderStats();
+    QCOMPARE(stats.numItems, 3);
+    QCOMPARE(stats.numPlaceholders, 2);
+    QCOMPARE(stats.numPlaceholderRefs, 2);
+    QVERIFY(stats.oldestPlaceholderAge >= 10);
+    QVERIFY(stats.placeholderBytes > 0);
+
+    // Keeps the most recent one
+    QCOMPARE(layout->compactPlaceholders(1), 1);
+    QVERIFY(layout->checkSanity());
+    QCOMPARE(layout->placeholderCount(), 1);
+    QVERIFY(!dock1->dptr()->lastPosition()->isValid());
+    QVERIFY(dock2->dptr()->lastPosition()->isValid());
+    QCOMPARE(layout->placeholderStats().numCompacted, 1);
+
+    // Nothing is old enough
+    QCOMPARE(layout->compactPlaceholders(-1, 60000), 0);
+    QCOMPARE(layout->placeholderCount(), 1);
+
+    // Automatic policy
+    Config::self().setMaxPlaceholdersPerLayout(0);
+    QPointer<Frame> frame3 = dock3->dptr()->frame();
+    dock3->close();
+    QVERIFY(Testing::waitForDeleted(frame3));
+    QTRY_COMPARE(layout->placeholderCount(), 0);
+    QVERIFY(layout->checkSanity());
+    Config::self().setMaxPlaceholdersPerLayout(-1);
+
+    // Without a placeholder it's shown floating
+    dock1->show();
+    QVERIFY(dock1->isFloating());
+}
+
 void TestDocks::tst_addAndReadd()
 {
     EnsureTopLevelsDeleted e;
@@ -5590,6 +6386,37 @@ void TestDocks::tst_sidebarOverlayShowsAutohide()
     delete dw1;
 }
 
+void TestDocks::tst_frameRecyclingSkipsOverlayedFrame()
+{
+    // A recycled frame must not be handed out as the side-bar overlay, which canBeRecycled() refuses to pool
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_AutoHideSupport);
+    FrameworkWidgetFactory *factory = Config::self().frameworkWidgetFactory();
+    factory->setFrameRecyclingLimit(1);
+
+    auto m1 = createMainWindow(QSize(1000, 1000), MainWindowOption_None, "MW1");
+    auto dw1 = new DockWidgetType(QStringLiteral("1"));
+    m1->addDockWidget(dw1, Location_OnBottom);
+    m1->moveToSideBar(dw1);
+
+    // Whatever moveToSideBar() left in the pool, make sure there's a frame to reuse
+    factory->clearRecycledFrames();
+    QPointer<Frame> recycled = factory->acquireFrame();
+    QVERIFY(factory->recycleFrame(recycled));
+    const auto statsBefore = factory->frameRecyclingStats();
+
+    m1->overlayOnSideBar(dw1);
+    QVERIFY(dw1->isOverlayed());
+    Frame *overlayFrame = dw1->dptr()->frame();
+    QVERIFY(overlayFrame != recycled);
+    QVERIFY(overlayFrame->isOverlayed());
+    QCOMPARE(factory->frameRecyclingStats().hits, statsBefore.hits);
+
+    delete dw1;
+    factory->setFrameRecyclingLimit(0);
+    QVERIFY(!recycled);
+}
+
 void TestDocks::tst_sidebarOverlayGetsHiddenOnClick()
 {
     EnsureTopLevelsDeleted e;
@@ -8014,3 +8841,116 @@ void TestDocks::tst_restoreFlagsFromVersion16()
     QVERIFY(floatingWindow);
     QCOMPARE(floatingWindow->floatingWindowFlags(), FloatingWindowFlag::HideTitleBarWhenTabsVisible);
 }
+
+void TestDocks::tst_layoutLinter()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(1000, 800), MainWindowOption_None);
+    auto dock1 = createDockWidget("1", new QPushButton("1"));
+    auto dock2 = createDockWidget("2", new QPushButton("2"));
+    createDockWidget("3", new QPushButton("3"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    LayoutSaver saver;
+    const QByteArray saved = saver.serializeLayout();
+
+    // One main window and one floating window
+    const LayoutLinter::Result result = LayoutLinter::lintJson(saved);
+    QVERIFY(result.success);
+    QVERIFY(result.errors.isEmpty());
+    QCOMPARE(result.numLayouts, 2);
+
+    // Remove a frame from the main window, its item references something that wasn't saved
+    QVariantMap layoutV = QJsonDocument::fromJson(saved).toVariant().toMap();
+    QVariantList mainWindowsV = layoutV.value("mainWindows").toList();
+    QVariantMap mainWindowV = mainWindowsV.first().toMap();
+    QVariantMap multiSplitterV = mainWindowV.value("multiSplitterLayout").toMap();
+    QVariantMap framesV = multiSplitterV.value("frames").toMap();
+    framesV.remove(framesV.firstKey());
+    multiSplitterV.insert("frames", framesV);
+    mainWindowV.insert("multiSplitterLayout", multiSplitterV);
+    mainWindowsV[0] = mainWindowV;
+    layoutV.insert("mainWindows", mainWindowsV);
+
+    const LayoutLinter::Result broken = LayoutLinter::lintJson(QJsonDocument::fromVariant(layoutV).toJson());
+    QVERIFY(!broken.success);
+    QVERIFY(!broken.errors.isEmpty());
+
+    QVERIFY(!LayoutLinter::lintJson("{ \"mainWindows\": ").success);
+
+    // stats() restores into the existing windows
+    QVERIFY(saver.saveToFile(QStringLiteral("layout_tst_layoutLinter.json")));
+    const LayoutLinter::Stats stats = LayoutLinter::stats(QStringLiteral("layout_tst_layoutLinter.json"));
+    QVERIFY(stats.success);
+    QVERIFY(stats.errors.isEmpty());
+    QCOMPARE(stats.numMainWindows, 1);
+    QCOMPARE(stats.numFloatingWindows, 1);
+    QCOMPARE(stats.numFrames, 3);
+    QCOMPARE(stats.numTabs, 3);
+    QCOMPARE(stats.numItems, 3);
+    QCOMPARE(stats.numPlaceholders, 0);
+    QCOMPARE(stats.numSeparators, 1);
+    QCOMPARE(stats.treeDepth, 1);
+    QVERIFY(stats.restoreNSecs >= stats.mainWindowsNSecs + stats.floatingWindowsNSecs);
+}
+
+void TestDocks::tst_layoutLinterConcurrent()
+{
+    // kddockwidgets_linter lints on a QThreadPool, the results must match a serial run
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(1000, 800), MainWindowOption_None);
+    auto dock1 = createDockWidget("1", new QPushButton("1"));
+    auto dock2 = createDockWidget("2", new QPushButton("2"));
+    auto dock3 = createDockWidget("3", new QPushButton("3"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnBottom, dock2);
+
+    LayoutSaver saver;
+    const QByteArray saved = saver.serializeLayout();
+
+    // A frame removed from the main window, so its item references something that wasn't saved
+    QVariantMap layoutV = QJsonDocument::fromJson(saved).toVariant().toMap();
+    QVariantList mainWindowsV = layoutV.value("mainWindows").toList();
+    QVariantMap mainWindowV = mainWindowsV.first().toMap();
+    QVariantMap multiSplitterV = mainWindowV.value("multiSplitterLayout").toMap();
+    QVariantMap framesV = multiSplitterV.value("frames").toMap();
+    framesV.remove(framesV.firstKey());
+    multiSplitterV.insert("frames", framesV);
+    mainWindowV.insert("multiSplitterLayout", multiSplitterV);
+    mainWindowsV[0] = mainWindowV;
+    layoutV.insert("mainWindows", mainWindowsV);
+    const QByteArray broken = QJsonDocument::fromVariant(layoutV).toJson();
+
+    QVector<QByteArray> inputs;
+    for (int i = 0; i < 16; ++i)
+        inputs << saved << broken << QByteArray("{ \"mainWindows\": ");
+
+    QVector<LayoutLinter::Result> serial;
+    for (const QByteArray &input : qAsConst(inputs))
+        serial.push_back(LayoutLinter::lintJson(input));
+
+    QVector<LayoutLinter::Result> parallel(inputs.size());
+    LayoutLinter::Result *out = parallel.data(); // So the workers don't touch the QVector itself
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(4, QThread::idealThreadCount()));
+    for (int i = 0; i < inputs.size(); ++i) {
+        const QByteArray input = inputs.at(i);
+        pool.start([out, i, input] {
+            out[i] = LayoutLinter::lintJson(input);
+        });
+    }
+    pool.waitForDone();
+
+    for (int i = 0; i < inputs.size(); ++i) {
+        QCOMPARE(parallel.at(i).success, serial.at(i).success);
+        QCOMPARE(parallel.at(i).numLayouts, serial.at(i).numLayouts);
+        QCOMPARE(parallel.at(i).errors, serial.at(i).errors);
+    }
+
+    QVERIFY(serial.at(0).success);
+    QVERIFY(!serial.at(1).success);
+    QVERIFY(!serial.at(1).errors.isEmpty());
+    QVERIFY(!serial.at(2).success);
+}
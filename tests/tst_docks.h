@@ -168,9 +168,11 @@ private Q_SLOTS:
     void tst_setFloatingWhenSideBySide();
     void tst_dockWindowWithTwoSideBySideFramesIntoCenter();
     void tst_tabTitleChanges();
+    void tst_deferredTitleUpdates();
     void tst_dockWidgetGetsFocusWhenDocked();
     void tst_setWidget();
     void tst_isFocused();
+    void tst_focusScopeDispatch();
     void tst_floatingLastPosAfterDoubleClose();
     void tst_registry();
     void tst_honourGeometryOfHiddenWindow();
@@ -182,6 +184,12 @@ private Q_SLOTS:
     void tst_preventClose();
     void tst_propagateMinSize();
     void tst_createFloatingWindow();
+    void tst_floatingWindowPool();
+    void tst_restoreWithFrameRecycling();
+    void tst_restoreWithFrameRecycling_data();
+    void tst_frameRecyclingSkipsCentralFrame();
+    void tst_layoutPresetCache();
+    void tst_compactPlaceholders();
     void tst_addAndReadd();
     void tst_fairResizeAfterRemoveWidget();
     void tst_invalidJSON_data();
@@ -249,6 +257,8 @@ private Q_SLOTS:
     void tst_setFloatingWindowFlags();
     void tst_crash326();
     void tst_restoreFlagsFromVersion16();
+    void tst_layoutLinter();
+    void tst_layoutLinterConcurrent();
 
 #ifdef KDDOCKWIDGETS_QTWIDGETS
     // TODO: Port these to QtQuick
@@ -272,12 +282,18 @@ private Q_SLOTS:
     void tst_toggleActionOnSideBar();
     void tst_deleteOnCloseWhenOnSideBar();
     void tst_sidebarOverlayShowsAutohide();
+    void tst_frameRecyclingSkipsOverlayedFrame();
     void tst_sidebarOverlayGetsHiddenOnClick();
     void tst_floatRemovesFromSideBar();
     void tst_overlayedGeometryIsSaved();
     void tst_overlayCrash();
     void tst_restoreWithIncompleteFactory();
     void tst_deleteDockWidget();
+    void tst_separatorOverlay();
+    void tst_lazyResizeMDI();
+    void tst_iconCache();
+    void tst_resizeHandlerDispatcher();
+    void tst_mdiZOrder();
 
     // And fix these
     void tst_floatingWindowDeleted();
@@ -297,5 +313,9 @@ private Q_SLOTS:
     void tst_restoreFloatingMaximizedState();
 #else
     void tst_hoverShowsDropIndicators();
+    void tst_qmlComponentCache();
+    void tst_mouseEventRedirector();
+    void tst_indicatorsItem();
+    void tst_batchedGeometryChanges();
 #endif
 };
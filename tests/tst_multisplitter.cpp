@@ -10,16 +10,24 @@
 */
 
 #include "private/multisplitter/Item_p.h"
+#include "private/multisplitter/ItemFreeContainer_p.h"
 #include "private/multisplitter/Separator_p.h"
 #include "private/multisplitter/Widget_qwidget.h"
 #include "private/multisplitter/MultiSplitterConfig.h"
 #include "private/multisplitter/Separator_qwidget.h"
+#include "private/multisplitter/ResizeThrottler_p.h"
 
 #include <QPainter>
+#include <QRandomGenerator>
 #include <QtTest/QtTest>
 
 #include <memory.h>
 
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#include <malloc.h>
+#define KDDW_HAS_MALLINFO2
+#endif
+
 
 // TODO: namespace
 
@@ -198,6 +206,13 @@ private Q_SLOTS:
     void tst_simplify();
     void tst_adjacentLayoutBorders();
     void tst_numSideBySide_recursive();
+    void tst_incrementalSanityCheck();
+    void tst_resizeThrottler();
+    void tst_itemFootprint();
+    void tst_sizeConstraintsCache();
+    void tst_freeContainerStacking();
+    void tst_freeContainerHitTesting();
+    void tst_batchedGeometryChanges();
 };
 
 class MyHostWidget : public QWidget, public Layouting::Widget_qwidget
@@ -275,6 +290,15 @@ static Item *createItem(QSize minSz = {}, QSize maxSz = {})
     return item;
 }
 
+static Item *addFreeItem(ItemFreeContainer *root, QRect geometry)
+{
+    auto item = new Item(root->hostWidget());
+    item->setGeometry(QRect(QPoint(), geometry.size()));
+    item->setGuestWidget(new MyGuestWidget());
+    root->addDockWidget(item, geometry.topLeft());
+    return item;
+}
+
 static ItemBoxContainer *createRootWithSingleItem()
 {
     auto root = new ItemBoxContainer(new MyHostWidget());
@@ -1928,6 +1952,417 @@ void TestMultiSplitter::tst_numSideBySide_recursive()
     QCOMPARE(root->numSideBySide_recursive(Qt::Horizontal), 2);
 }
 
+void TestMultiSplitter::tst_incrementalSanityCheck()
+{
+    Config &config = Config::self();
+    config.setSanityCheckLevel(Config::SanityCheckLevel::Incremental);
+
+    // Result is [1/3, 2/4], so root plus 2 nested containers
+    auto root = createRoot();
+    auto item1 = createItem();
+    auto item2 = createItem();
+    auto item3 = createItem();
+    auto item4 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    ItemBoxContainer::insertItemRelativeTo(item3, item1, Location_OnBottom);
+    ItemBoxContainer::insertItemRelativeTo(item4, item2, Location_OnBottom);
+    QVERIFY(root->runSanityCheck());
+
+    // Nothing changed, nothing to check
+    config.resetSanityCheckStats();
+    QVERIFY(root->runSanityCheck());
+    QCOMPARE(config.sanityCheckStats().numChecks, 1);
+    QCOMPARE(config.sanityCheckStats().numContainersChecked, 0);
+
+    // Only the left side changed
+    item3->turnIntoPlaceholder();
+    config.resetSanityCheckStats();
+    QVERIFY(root->runSanityCheck());
+    QVERIFY(config.sanityCheckStats().numContainersChecked > 0);
+    QVERIFY(config.sanityCheckStats().numContainersChecked < 3);
+
+    config.setSanityCheckLevel(Config::SanityCheckLevel::Full);
+    config.resetSanityCheckStats();
+    QVERIFY(root->runSanityCheck());
+    QCOMPARE(config.sanityCheckStats().numContainersChecked, 3);
+    QVERIFY(config.sanityCheckStats().lastCheckNSecs >= 0);
+    QCOMPARE(config.sanityCheckStats().totalCheckNSecs, config.sanityCheckStats().lastCheckNSecs);
+
+    config.setSanityCheckLevel(Config::SanityCheckLevel::Off);
+    config.resetSanityCheckStats();
+    QVERIFY(root->runSanityCheck());
+    QCOMPARE(config.sanityCheckStats().numChecks, 0);
+
+    config.setSanityCheckLevel(Config::SanityCheckLevel::Full);
+    QVERIFY(serializeDeserializeTest(root));
+}
+
+void TestMultiSplitter::tst_resizeThrottler()
+{
+    Config &config = Config::self();
+    QCOMPARE(config.liveResizeInterval(), 0);
+    QVERIFY(!ResizeThrottler::isEnabled());
+
+    config.setLiveResizeInterval(50);
+    config.resetLiveResizeStats();
+    QVERIFY(ResizeThrottler::isEnabled());
+
+    auto root = createRoot();
+    auto item1 = createItem();
+    auto item2 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    Separator *separator = root->separators().constFirst();
+    const int initialPos = separator->position();
+
+    QObject context;
+    ResizeThrottler throttler(&context);
+
+    // The first request runs right away
+    throttler.request([&] {
+        root->requestSeparatorMove(separator, 10);
+    });
+    QCOMPARE(separator->position(), initialPos + 10);
+    QVERIFY(!throttler.hasPendingWork());
+
+    // Then they're coalesced until the interval elapses, only the latest one survives
+    for (int i = 1; i <= 5; ++i) {
+        throttler.request([&, i] {
+            root->requestSeparatorMove(separator, initialPos + 10 + i - separator->position());
+        });
+    }
+    QVERIFY(throttler.hasPendingWork());
+    QCOMPARE(separator->position(), initialPos + 10);
+    QTRY_COMPARE(separator->position(), initialPos + 15);
+    QVERIFY(!throttler.hasPendingWork());
+
+    // runPendingWork() too, for readers needing the latest result, but the resize isn't finished
+    throttler.request([&] {
+        root->requestSeparatorMove(separator, 5);
+    });
+    QVERIFY(throttler.hasPendingWork());
+    throttler.runPendingWork();
+    QCOMPARE(separator->position(), initialPos + 20);
+    QVERIFY(!throttler.hasPendingWork());
+
+    // flush() runs what's pending immediately
+    throttler.request([&] {
+        root->requestSeparatorMove(separator, -20);
+    });
+    throttler.flush();
+    QCOMPARE(separator->position(), initialPos);
+    QVERIFY(!throttler.hasPendingWork());
+
+    const Config::LiveResizeStats stats = config.liveResizeStats();
+    QCOMPARE(stats.numRequests, 8);
+    QCOMPARE(stats.numResizes, 1);
+    QVERIFY(stats.numRelayouts >= 2);
+    QVERIFY(stats.numRelayouts < stats.numRequests);
+    QVERIFY(stats.maxRelayoutNSecs <= stats.totalNSecs);
+    QVERIFY(root->checkSanity());
+
+    config.setLiveResizeInterval(0);
+    config.resetLiveResizeStats();
+}
+
+/// Returns how many bytes are allocated on the heap, or -1 if the platform can't tell
+static qint64 heapBytesInUse()
+{
+#ifdef KDDW_HAS_MALLINFO2
+    const struct mallinfo2 info = mallinfo2();
+    return qint64(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+void TestMultiSplitter::tst_itemFootprint()
+{
+    // Items notify their parent directly and only compute their name on demand, so big layouts
+    // don't pay for two connections and a string per item. Also checks what an item costs on the heap.
+    const int numItems = 200;
+
+    // Everything an item allocates: QObjectPrivate, connection lists, SizingInfo's containers and
+    // the guest's event filter list, without the guest itself
+    const qint64 itemHeapBudget = 2048;
+
+    auto root = createRoot();
+
+    QVector<MyGuestWidget *> guests;
+    for (int i = 0; i < numItems; ++i) {
+        guests.push_back(new MyGuestWidget());
+        guests.last()->setObjectName(QString::number(i));
+    }
+
+    Item::List newItems;
+    newItems.reserve(numItems);
+    const qint64 heapBefore = heapBytesInUse();
+    for (MyGuestWidget *guest : qAsConst(guests)) {
+        auto item = new Item(root->hostWidget());
+        item->setGuestWidget(guest);
+        newItems.push_back(item);
+    }
+    const qint64 heapAfter = heapBytesInUse();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (Item *item : qAsConst(newItems))
+        root->insertItem(item, Location_OnRight);
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    const Item::List items = root->items_recursive();
+    QCOMPARE(items.size(), numItems);
+    for (Item *item : items) {
+        QCOMPARE(item->receivers(SIGNAL(minSizeChanged(Layouting::Item *))), 0);
+        QCOMPARE(item->receivers(SIGNAL(visibleChanged(Layouting::Item *, bool))), 0);
+        QVERIFY(item->objectName().isEmpty());
+    }
+
+    QCOMPARE(items.constFirst()->displayName(), QStringLiteral("0"));
+    QCOMPARE(items.constLast()->displayName(), QString::number(numItems - 1));
+
+    // The parent still hears about visibility and min-size changes
+    Item *item = items.at(numItems / 2);
+    item->turnIntoPlaceholder();
+    QCOMPARE(item->displayName(), QStringLiteral("hidden"));
+    QCOMPARE(root->numVisibleChildren(), numItems - 1);
+    QVERIFY(root->checkSanity());
+
+    const QSize oldMinSize = root->minSize();
+    Item *first = items.constFirst();
+    auto guest = static_cast<MyGuestWidget *>(first->guestAsQObject());
+    guest->setMinSize(first->minSize() + QSize(100, 0));
+    QCOMPARE(root->minSize(), oldMinSize + QSize(100, 0));
+    QVERIFY(root->checkSanity());
+
+    if (heapBefore == -1)
+        QSKIP("No heap statistics on this platform");
+
+    const qint64 bytesPerItem = (heapAfter - heapBefore) / numItems;
+    qInfo() << "Each item takes" << bytesPerItem << "heap bytes; insertion took" << elapsed / numItems << "ns per item";
+    QVERIFY2(bytesPerItem <= itemHeapBudget,
+             qPrintable(QStringLiteral("%1 bytes per item, budget is %2").arg(bytesPerItem).arg(itemHeapBudget)));
+}
+
+void TestMultiSplitter::tst_sizeConstraintsCache()
+{
+    // Containers cache their min/max sizes. Tests that they're invalidated and that
+    // root only emits minSizeChanged if it really changed.
+    auto root = createRoot();
+    Item *item1 = createItem();
+    Item *item2 = createItem();
+    Item *item3 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    root->insertItem(item3, Location_OnBottom);
+
+    ItemBoxContainer *container = item1->parentBoxContainer();
+    QVERIFY(container != root.get());
+    QVERIFY(container->isHorizontal());
+    QVERIFY(root->isVertical());
+
+    const int sep = Item::separatorThickness;
+    QCOMPARE(container->minSize(), QSize(200 + sep + 200, 200));
+    QCOMPARE(root->minSize(), QSize(200 + sep + 200, 200 + sep + 200));
+
+    QSignalSpy spy(root.get(), &Item::minSizeChanged);
+    auto guest1 = static_cast<MyGuestWidget *>(item1->guestAsQObject());
+    auto guest2 = static_cast<MyGuestWidget *>(item2->guestAsQObject());
+
+    guest2->setMinSize(QSize(250, 200));
+    QCOMPARE(root->minSize(), QSize(200 + sep + 250, 200 + sep + 200));
+    QCOMPARE(spy.count(), 1);
+
+    guest1->setMinSize(QSize(200, 260));
+    QCOMPARE(container->minSize(), QSize(200 + sep + 250, 260));
+    QCOMPARE(root->minSize(), QSize(200 + sep + 250, 260 + sep + 200));
+    QCOMPARE(spy.count(), 2);
+
+    // item1 is still the tallest, so nothing changes for the containers
+    guest2->setMinSize(QSize(250, 230));
+    QCOMPARE(item2->minSize(), QSize(250, 230));
+    QCOMPARE(container->minSize(), QSize(200 + sep + 250, 260));
+    QCOMPARE(spy.count(), 2);
+
+    // Hiding an item
+    item3->turnIntoPlaceholder();
+    QCOMPARE(root->minSize(), container->minSize());
+    QCOMPARE(spy.count(), 3);
+
+    // Max sizes
+    QCOMPARE(root->maxSizeHint().height(), Item::hardcodedMaximumSize.height());
+    guest1->setMaxSize(QSize(500, 400));
+    QCOMPARE(container->maxSizeHint().height(), 400);
+    QCOMPARE(root->maxSizeHint().height(), 400);
+
+    // checkSanity() also compares the caches against freshly computed values
+    QVERIFY(root->checkSanity());
+}
+
+void TestMultiSplitter::tst_freeContainerStacking()
+{
+    auto hostWidget = new MyHostWidget();
+    std::unique_ptr<ItemFreeContainer> root(new ItemFreeContainer(hostWidget));
+    root->setSize({ 1000, 1000 });
+
+    Item *item1 = addFreeItem(root.get(), QRect(0, 0, 300, 300));
+    Item *item2 = addFreeItem(root.get(), QRect(200, 200, 300, 300));
+    Item *item3 = addFreeItem(root.get(), QRect(600, 600, 300, 300));
+
+    // New items go on top
+    QCOMPARE(root->itemsInStackingOrder(), (Item::List { item1, item2, item3 }));
+    QCOMPARE(root->itemAt(QPoint(250, 250)), item2);
+    QCOMPARE(root->itemAt(QPoint(100, 100)), item1);
+    QVERIFY(!root->itemAt(QPoint(505, 505)));
+    QCOMPARE(root->itemAt(QPoint(505, 505), 10), item2);
+
+    root->raiseItem(item1);
+    QCOMPARE(root->itemAt(QPoint(250, 250)), item1);
+    QVERIFY(!root->itemAbove(item1));
+    QCOMPARE(root->itemAbove(item2), item3);
+    QCOMPARE(root->itemsIntersecting(QRect(0, 0, 600, 600)), (Item::List { item2, item1 }));
+
+    // Explicit z. Raising puts it on top of the highest z
+    root->setItemZ(item2, -1);
+    QCOMPARE(root->itemsInStackingOrder(), (Item::List { item2, item3, item1 }));
+    root->setItemZ(item3, 5);
+    QCOMPARE(root->itemZ(item3), 5);
+    QCOMPARE(root->itemsInStackingOrder().constLast(), item3);
+    QCOMPARE(root->raiseItem(item1), 5);
+    QCOMPARE(root->itemsInStackingOrder(), (Item::List { item2, item3, item1 }));
+
+    // The index follows geometry changes
+    item3->setGeometry(QRect(0, 600, 300, 300));
+    QCOMPARE(root->itemAt(QPoint(100, 700)), item3);
+    QVERIFY(!root->itemAt(QPoint(700, 700)));
+
+    // Placeholders keep their z but aren't hit
+    item3->turnIntoPlaceholder();
+    QVERIFY(!root->itemAt(QPoint(100, 700)));
+    QCOMPARE(root->itemsInStackingOrder().size(), 3);
+    QVERIFY(root->checkSanity());
+
+    // The z is serialized, and the stacking order survives a restore
+    std::unique_ptr<ItemFreeContainer> restored(new ItemFreeContainer(nullptr));
+    restored->fillFromVariantMap(root->toVariantMap(), {});
+    const Item::List stacked = root->itemsInStackingOrder();
+    const Item::List restoredStacked = restored->itemsInStackingOrder();
+    QCOMPARE(restoredStacked.size(), stacked.size());
+    for (int i = 0; i < stacked.size(); ++i) {
+        QCOMPARE(restoredStacked.at(i)->geometry(), stacked.at(i)->geometry());
+        QCOMPARE(restored->itemZ(restoredStacked.at(i)), root->itemZ(stacked.at(i)));
+    }
+
+    root->removeItem(item2);
+    QCOMPARE(root->itemsInStackingOrder(), (Item::List { item3, item1 }));
+    QVERIFY(!root->itemAt(QPoint(450, 450)));
+    QVERIFY(root->checkSanity());
+}
+
+void TestMultiSplitter::tst_freeContainerHitTesting()
+{
+    // Also a benchmark. Hit-tests 500 overlapping MDI windows and compares against a linear scan.
+    const int numItems = 500;
+    auto hostWidget = new MyHostWidget();
+    std::unique_ptr<ItemFreeContainer> root(new ItemFreeContainer(hostWidget));
+    root->setSize({ 4000, 3000 });
+
+    QRandomGenerator rng(1234);
+    Item::List items;
+    items.reserve(numItems);
+    for (int i = 0; i < numItems; ++i) {
+        const QRect geo(rng.bounded(3600), rng.bounded(2700), 200 + rng.bounded(200), 200 + rng.bounded(100));
+        items.push_back(addFreeItem(root.get(), geo));
+    }
+
+    for (int i = 0; i < numItems / 5; ++i)
+        root->raiseItem(items.at(rng.bounded(numItems)));
+
+    QVector<QPoint> points;
+    points.reserve(1000);
+    for (int i = 0; i < 1000; ++i)
+        points.push_back(QPoint(rng.bounded(4000), rng.bounded(3000)));
+
+    const Item::List stacked = root->itemsInStackingOrder();
+    QCOMPARE(stacked.size(), numItems);
+    for (QPoint pos : qAsConst(points)) {
+        Item *expected = nullptr;
+        for (auto it = stacked.crbegin(); it != stacked.crend() && !expected; ++it) {
+            if ((*it)->geometry().contains(pos))
+                expected = *it;
+        }
+
+        QCOMPARE(root->itemAt(pos), expected);
+    }
+
+    int i = 0;
+    QBENCHMARK {
+        // What happens on each mouse press: hit-test and raise
+        for (QPoint pos : qAsConst(points)) {
+            if (Item *item = root->itemAt(pos, 4))
+                root->raiseItem(item);
+        }
+
+        // And some moves
+        Item *item = items.at(i++ % numItems);
+        item->setGeometry(item->geometry().translated(1, 1));
+    }
+
+    QVERIFY(root->checkSanity());
+}
+
+void TestMultiSplitter::tst_batchedGeometryChanges()
+{
+    auto root = createRoot();
+    Item *item1 = createItem();
+    Item *item2 = createItem();
+    Item *item3 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    root->insertItem(item3, Location_OnBottom);
+
+    const Config::Flags originalFlags = Config::self().flags();
+    Config::self().setFlags(originalFlags | Config::Flag::BatchedGeometryChanges);
+
+    QSignalSpy geometrySpy2(item2, &Item::geometryChanged);
+    QSignalSpy xSpy2(item2, &Item::xChanged);
+    QSignalSpy widthSpy2(item2, &Item::widthChanged);
+    QSignalSpy geometrySpy3(item3, &Item::geometryChanged);
+
+    // Many relayouts, nothing is emitted until the event loop runs
+    for (int i = 1; i <= 10; ++i)
+        root->setSize(QSize(1000 + i * 10, 1000 + i * 10));
+
+    QCOMPARE(geometrySpy2.count(), 0);
+    QCOMPARE(geometrySpy3.count(), 0);
+
+    QTRY_COMPARE(geometrySpy2.count(), 1);
+    QCOMPARE(geometrySpy3.count(), 1);
+    QCOMPARE(geometrySpy2.at(0).at(0).toRect(), item2->geometry());
+
+    // Per-axis signals are suppressed
+    QCOMPARE(xSpy2.count(), 0);
+    QCOMPARE(widthSpy2.count(), 0);
+
+    // Can be flushed on demand
+    root->setSize(QSize(1200, 1300));
+    Item::flushGeometryChanges();
+    QCOMPARE(geometrySpy2.count(), 2);
+    QCOMPARE(geometrySpy3.count(), 2);
+
+    // Deleted items are skipped
+    root->setSize(QSize(1100, 1100));
+    root->removeItem(item1);
+    Item::flushGeometryChanges();
+    QVERIFY(root->checkSanity());
+
+    Config::self().setFlags(originalFlags);
+    root->setSize(QSize(1000, 1000));
+    QVERIFY(xSpy2.count() > 0 || widthSpy2.count() > 0);
+    QCOMPARE(geometrySpy2.count(), 4);
+}
+
 int main(int argc, char *argv[])
 {
     bool qpaPassed = false;
@@ -264,6 +264,20 @@ public:
     MainWindowBase *const mainWindow;
 };
 
+/// Call count() from a QML binding to know how often it's re-evaluated
+class BindingCounter : public QObject
+{
+    Q_OBJECT
+public:
+    Q_INVOKABLE QRect count(QRect rect)
+    {
+        numEvaluations++;
+        return rect;
+    }
+
+    int numEvaluations = 0;
+};
+
 #else
 
 class EmbeddedWindow : public QWidget